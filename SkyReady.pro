@@ -1,4 +1,4 @@
-QT       += core gui sql widgets
+QT       += core gui sql widgets concurrent network
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
@@ -6,28 +6,69 @@ CONFIG += c++17
 
 INCLUDEPATH += src
 
+# Пакетный расчет загрузки использует SSE2 по умолчанию.
+# Для AVX2: qmake CONFIG+=simd_avx2
+simd_avx2 {
+    QMAKE_CXXFLAGS += -mavx2
+}
+
+# Сборка без интервалов трассировки (TRACE_SCOPE ничего не стоит): qmake CONFIG+=no_trace
+no_trace {
+    DEFINES += SKYREADY_NO_TRACE
+}
+
 # Исходный код
 SOURCES += \
     main.cpp \
     src/db/DatabaseManager.cpp \
+    src/db/SqlQuery.cpp \
     src/repositories/AircraftRepository.cpp \
     src/repositories/PilotRepository.cpp \
     src/services/ReadinessService.cpp \
     src/ui/MainWindow.cpp \
     src/repositories/DefectRepository.cpp \
     src/services/WeightCalculator.cpp \
+    src/services/CgEnvelope.cpp \
+    src/services/LoadSolver.cpp \
+    src/services/DispatchPlanner.cpp \
+    src/services/ReadinessRuleEngine.cpp \
+    src/services/ParallelFor.cpp \
+    src/services/Trace.cpp \
+    src/services/Metrics.cpp \
+    src/services/MetricsPublisher.cpp \
+    src/services/StallWatchdog.cpp \
+    src/services/AircraftContextCache.cpp \
+    src/services/BatchReadinessRunner.cpp \
+    src/services/FleetDataGenerator.cpp \
+    src/services/ReadinessText.cpp \
     src/ui/FlightPreparationDialog.cpp \
     src/repositories/AircraftModelRepository.cpp \
+    src/repositories/ReadinessRuleRepository.cpp \
     src/services/FleetService.cpp \
+    src/services/FleetStatusService.cpp \
+    src/models/FleetSnapshot.cpp \
+    src/models/FleetStore.cpp \
+    src/services/FlightCommitQueue.cpp \
+    src/services/MaintenanceForecast.cpp \
+    src/repositories/FlightLogRepository.cpp \
     src/ui/dialogs/AddAircraftDialog.cpp \
     src/ui/dialogs/AddPilotDialog.cpp \
     src/ui/dialogs/AddDefectDialog.cpp \
-    src/ui/dialogs/MaintenanceDialog.cpp
+    src/ui/dialogs/MaintenanceDialog.cpp \
+    src/ui/dialogs/DispatchDialog.cpp \
+    src/ui/dialogs/GenerateFleetDialog.cpp \
+    src/ui/widgets/FeasibilityChart.cpp \
+    src/ui/models/FleetTableModel.cpp \
+    src/ui/models/PilotListModel.cpp \
+    src/server/HttpMessage.cpp \
+    src/server/ReadinessApi.cpp \
+    src/server/ReadinessHttpServer.cpp
 
 # Заголовки
 HEADERS += \
     src/models/Entities.h \
     src/db/DatabaseManager.h \
+    src/db/SqlQuery.h \
     src/repositories/IRepository.h \
     src/repositories/AircraftRepository.h \
     src/repositories/PilotRepository.h \
@@ -35,12 +76,66 @@ HEADERS += \
     src/ui/MainWindow.h \
     src/repositories/DefectRepository.h \
     src/services/WeightCalculator.h \
+    src/services/CgEnvelope.h \
+    src/services/LoadSolver.h \
+    src/services/DispatchPlanner.h \
+    src/services/ReadinessRuleEngine.h \
+    src/services/ParallelFor.h \
+    src/services/Trace.h \
+    src/services/Metrics.h \
+    src/services/MetricsPublisher.h \
+    src/services/StallWatchdog.h \
+    src/services/AircraftContextCache.h \
+    src/services/BatchReadinessRunner.h \
+    src/services/FleetDataGenerator.h \
+    src/services/ReadinessText.h \
     src/ui/FlightPreparationDialog.h \
     src/repositories/AircraftModelRepository.h \
+    src/repositories/ReadinessRuleRepository.h \
     src/services/FleetService.h \
+    src/services/FleetStatusService.h \
+    src/models/FleetSnapshot.h \
+    src/models/FleetStore.h \
+    src/services/FlightCommitQueue.h \
+    src/services/MaintenanceForecast.h \
+    src/repositories/FlightLogRepository.h \
     src/ui/dialogs/AddAircraftDialog.h \
     src/ui/dialogs/AddPilotDialog.h \
     src/ui/dialogs/AddDefectDialog.h \
-    src/ui/dialogs/MaintenanceDialog.h
+    src/ui/dialogs/MaintenanceDialog.h \
+    src/ui/dialogs/DispatchDialog.h \
+    src/ui/dialogs/GenerateFleetDialog.h \
+    src/ui/widgets/FeasibilityChart.h \
+    src/ui/models/FleetTableModel.h \
+    src/ui/models/PilotListModel.h \
+    src/server/HttpMessage.h \
+    src/server/ReadinessApi.h \
+    src/server/ReadinessHttpServer.h
 
 TARGET = SkyReady
+
+# Замеры вычислительных ядер (benchmarks/): make benchmarks
+# собирает их рядом с приложением, запускает и пишет результаты QTest
+# в benchmark_results.csv (формат csv: имя, метрика, значение, итерации)
+benchmarks.commands = \
+    mkdir -p $$OUT_PWD/benchmarks && cd $$OUT_PWD/benchmarks && \
+    $$QMAKE_QMAKE $$PWD/benchmarks/benchmarks.pro && $(MAKE) && \
+    ./kernel_benchmarks -o -,txt -o $$OUT_PWD/benchmark_results.csv,csv
+benchmarks.CONFIG = phony
+QMAKE_EXTRA_TARGETS += benchmarks
+
+# Замер операций на живой PostgreSQL (benchmarks/DbBenchmark.cpp): make db_benchmark
+# только собирает программу, запуск - вручную на отдельной базе (она очищается)
+db_benchmark.commands = \
+    mkdir -p $$OUT_PWD/db_benchmark && cd $$OUT_PWD/db_benchmark && \
+    $$QMAKE_QMAKE $$PWD/benchmarks/db_benchmark.pro && $(MAKE)
+db_benchmark.CONFIG = phony
+QMAKE_EXTRA_TARGETS += db_benchmark
+
+# Параллельные диспетчеры на живой PostgreSQL (benchmarks/DispatchSimulator.cpp):
+# make dispatch_simulator только собирает программу, данные - SkyReady --generate
+dispatch_simulator.commands = \
+    mkdir -p $$OUT_PWD/dispatch_simulator && cd $$OUT_PWD/dispatch_simulator && \
+    $$QMAKE_QMAKE $$PWD/benchmarks/dispatch_simulator.pro && $(MAKE)
+dispatch_simulator.CONFIG = phony
+QMAKE_EXTRA_TARGETS += dispatch_simulator
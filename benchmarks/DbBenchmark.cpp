@@ -0,0 +1,296 @@
+// Замер операций приложения на живой PostgreSQL.
+// Заливает N бортов / M пилотов / K дефектов и измеряет загрузку флота (как
+// MainWindow::loadAircrafts), проверку готовности, фиксацию полета, добавление и
+// снятие дефекта и заливку демо-данных. По каждой операции выводятся запросы и
+// обмены с сервером на вызов (SqlQuery::counters) и перцентили задержки.
+//
+// Подключение - те же переменные окружения, что у приложения (DB_HOST, DB_NAME,
+// DB_USER, DB_PASSWORD). База очищается, поэтому нужен явный флаг --wipe:
+//   DB_HOST=localhost DB_NAME=skyready_bench ./db_benchmark --wipe --aircraft 5000 --output db.csv
+#include "src/db/DatabaseManager.h"
+#include "src/db/SqlQuery.h"
+#include "src/models/FleetStore.h"
+#include "src/repositories/AircraftModelRepository.h"
+#include "src/repositories/AircraftRepository.h"
+#include "src/repositories/DefectRepository.h"
+#include "src/repositories/PilotRepository.h"
+#include "src/services/FleetService.h"
+#include "src/services/FleetStatusService.h"
+#include "src/services/ReadinessService.h"
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QProcessEnvironment>
+#include <QRandomGenerator>
+#include <QTextStream>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <deque>
+#include <vector>
+
+namespace {
+const quint32 Seed = 20240917;
+
+// Замеры одной операции
+struct OperationStats {
+    QString name;
+    std::vector<qint64> nanos;
+    SqlCounters counters;  // Сумма по всем вызовам
+
+    // Перцентиль по ближайшему рангу, мс
+    double percentileMs(double p) const {
+        if (nanos.empty()) return 0;
+        std::vector<qint64> sorted = nanos;
+        std::sort(sorted.begin(), sorted.end());
+        size_t rank = (size_t)std::ceil(p * sorted.size());
+        return sorted[std::max<size_t>(rank, 1) - 1] / 1e6;
+    }
+
+    double perCall(qint64 total) const { return nanos.empty() ? 0 : (double)total / nanos.size(); }
+};
+
+struct Options {
+    int aircraft = 2000;
+    int pilots = 500;
+    int defects = 3000;
+    int runs = 200;
+    int seedRuns = 5;
+    QString outputPath;
+};
+
+class DbBenchmark {
+public:
+    explicit DbBenchmark(const Options& options) : m_options(options), m_rng(Seed) {}
+
+    int run() {
+        loadDataset();
+
+        benchFleetLoad();
+        benchCheckReadiness();
+        benchCommitFlight();
+        benchDefects();
+        // Заливка демо-данных стирает набор, поэтому идет последней
+        benchSeedDemo();
+
+        report();
+        return 0;
+    }
+
+private:
+    template<class Body>
+    void measure(OperationStats& stats, Body body) {
+        SqlCounters before = SqlQuery::counters();
+        QElapsedTimer timer;
+        timer.start();
+        body();
+        stats.nanos.push_back(timer.nsecsElapsed());
+
+        stats.counters += SqlQuery::counters() - before;
+    }
+
+    OperationStats& operation(const QString& name) {
+        m_stats.push_back(OperationStats());
+        m_stats.back().name = name;
+        return m_stats.back();
+    }
+
+    QUuid randomAircraft() { return m_aircraftIds[m_rng.bounded((int)m_aircraftIds.size())]; }
+    QUuid randomPilot() { return m_pilotIds[m_rng.bounded((int)m_pilotIds.size())]; }
+
+    // Исходный набор: справочники из seedDemoData, дальше N / M / K записей в одной транзакции
+    void loadDataset() {
+        QElapsedTimer timer;
+        timer.start();
+        m_fleetService.seedDemoData();
+
+        std::vector<AircraftModel> models = m_modelRepo.getAll();
+        for (const DefectType& type : m_defectRepo.getAllDefectTypes()) m_defectTypes.push_back(type.id);
+
+        QSqlDatabase db = DatabaseManager::instance().getDatabase();
+        SqlQuery::transaction(db);
+
+        for (int i = 0; i < m_options.aircraft; ++i) {
+            Aircraft plane;
+            plane.id = QUuid::createUuid();
+            plane.modelId = models[i % models.size()].id;
+            plane.regNumber = QString("BM-%1").arg(i, 5, 10, QChar('0'));
+            plane.engineHoursTotal = 100.0 + m_rng.bounded(3000.0);
+            plane.engineHoursNextService = plane.engineHoursTotal + m_rng.bounded(120.0) - 10.0;
+            if (m_aircraftRepo.create(plane)) m_aircraftIds.push_back(plane.id);
+        }
+
+        QDate today = QDate::currentDate();
+        for (int i = 0; i < m_options.pilots; ++i) {
+            Pilot pilot;
+            pilot.id = QUuid::createUuid();
+            pilot.fullName = QString("Benchmark Pilot %1").arg(i, 5, 10, QChar('0'));
+            pilot.licenseExpiryDate = today.addDays(m_rng.bounded(730) - 60);
+            pilot.medicalExpiryDate = today.addDays(m_rng.bounded(365) - 20);
+            for (const AircraftModel& model : models) {
+                if (m_rng.bounded(3) != 0) pilot.allowedModels.append(model.id);
+            }
+            if (m_pilotRepo.create(pilot)) m_pilotIds.push_back(pilot.id);
+        }
+
+        for (int i = 0; i < m_options.defects && !m_aircraftIds.empty() && !m_defectTypes.empty(); ++i) {
+            m_defectRepo.addActiveDefect(randomAircraft(), m_defectTypes[m_rng.bounded((int)m_defectTypes.size())]);
+        }
+
+        SqlQuery::commit(db);
+        std::printf("dataset: %d aircraft, %d pilots, %d defects loaded in %lld ms\n",
+                    (int)m_aircraftIds.size(), (int)m_pilotIds.size(), m_options.defects,
+                    (long long)timer.elapsed());
+    }
+
+    void benchFleetLoad() {
+        OperationStats& stats = operation("fleet_load");
+        FleetStatusService statusService;
+        for (int i = 0; i < m_options.runs; ++i) {
+            FleetStore store;
+            measure(stats, [&] { statusService.load(store); });
+        }
+    }
+
+    void benchCheckReadiness() {
+        if (m_aircraftIds.empty() || m_pilotIds.empty()) return;
+        OperationStats& stats = operation("check_readiness");
+        ReadinessService readiness;
+        for (int i = 0; i < m_options.runs; ++i) {
+            QUuid aircraftId = randomAircraft();
+            QUuid pilotId = randomPilot();
+            FlightParams params;
+            params.fuelAmount = 60.0 + m_rng.bounded(120.0);
+            params.cargoWeight = 80.0 + m_rng.bounded(250.0);
+            params.flightTimeMinutes = 30 + m_rng.bounded(180);
+            measure(stats, [&] { readiness.checkReadiness(aircraftId, pilotId, params); });
+        }
+    }
+
+    void benchCommitFlight() {
+        if (m_aircraftIds.empty()) return;
+        OperationStats& stats = operation("commit_flight");
+        for (int i = 0; i < m_options.runs; ++i) {
+            QUuid aircraftId = randomAircraft();
+            int minutes = 30 + m_rng.bounded(180);
+            measure(stats, [&] { m_fleetService.commitFlight(aircraftId, minutes); });
+        }
+    }
+
+    void benchDefects() {
+        if (m_aircraftIds.empty() || m_defectTypes.empty()) return;
+        OperationStats& added = operation("defect_add");
+        std::vector<QUuid> touched;
+        for (int i = 0; i < m_options.runs; ++i) {
+            QUuid aircraftId = randomAircraft();
+            QUuid typeId = m_defectTypes[m_rng.bounded((int)m_defectTypes.size())];
+            measure(added, [&] { m_fleetService.reportDefect(aircraftId, typeId); });
+            touched.push_back(aircraftId);
+        }
+
+        // Снимаются дефекты тех же бортов; их id читаются вне замера
+        std::vector<QUuid> defectIds;
+        for (const QUuid& aircraftId : touched) {
+            if ((int)defectIds.size() >= m_options.runs) break;
+            for (const ActiveDefect& defect : m_defectRepo.getByAircraftId(aircraftId)) {
+                if (std::find(defectIds.begin(), defectIds.end(), defect.id) == defectIds.end()) {
+                    defectIds.push_back(defect.id);
+                    break;
+                }
+            }
+        }
+
+        OperationStats& resolved = operation("defect_resolve");
+        for (const QUuid& defectId : defectIds) {
+            measure(resolved, [&] { m_fleetService.resolveDefect(defectId); });
+        }
+    }
+
+    void benchSeedDemo() {
+        OperationStats& stats = operation("seed_demo");
+        for (int i = 0; i < m_options.seedRuns; ++i) {
+            measure(stats, [&] { m_fleetService.seedDemoData(); });
+        }
+    }
+
+    void report() {
+        std::printf("\n%-16s %6s %9s %9s %9s %9s %9s %9s\n",
+                    "operation", "runs", "queries", "trips", "p50 ms", "p90 ms", "p99 ms", "max ms");
+        for (const OperationStats& s : m_stats) {
+            std::printf("%-16s %6d %9.1f %9.1f %9.3f %9.3f %9.3f %9.3f\n",
+                        qPrintable(s.name), (int)s.nanos.size(),
+                        s.perCall(s.counters.queries), s.perCall(s.counters.roundTrips()),
+                        s.percentileMs(0.50), s.percentileMs(0.90), s.percentileMs(0.99), s.percentileMs(1.0));
+        }
+
+        if (m_options.outputPath.isEmpty()) return;
+        QFile file(m_options.outputPath);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            qDebug() << "DbBenchmark: cannot write" << m_options.outputPath << ":" << file.errorString();
+            return;
+        }
+        QTextStream out(&file);
+        out << "operation,runs,queries_per_call,prepares_per_call,round_trips_per_call,p50_ms,p90_ms,p99_ms,max_ms\n";
+        for (const OperationStats& s : m_stats) {
+            out << s.name << ',' << s.nanos.size() << ','
+                << s.perCall(s.counters.queries) << ',' << s.perCall(s.counters.prepares) << ','
+                << s.perCall(s.counters.roundTrips()) << ','
+                << s.percentileMs(0.50) << ',' << s.percentileMs(0.90) << ','
+                << s.percentileMs(0.99) << ',' << s.percentileMs(1.0) << '\n';
+        }
+    }
+
+    Options m_options;
+    QRandomGenerator m_rng;
+
+    FleetService m_fleetService;
+    AircraftModelRepository m_modelRepo;
+    AircraftRepository m_aircraftRepo;
+    PilotRepository m_pilotRepo;
+    DefectRepository m_defectRepo;
+
+    std::vector<QUuid> m_aircraftIds;
+    std::vector<QUuid> m_pilotIds;
+    std::vector<QUuid> m_defectTypes;
+    std::deque<OperationStats> m_stats;  // deque: ссылки на операции не инвалидируются
+};
+}
+
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("SkyReady database benchmark (wipes the target database)");
+    parser.addHelpOption();
+    parser.addOption({ "wipe", "Confirm that the target database may be cleared." });
+    parser.addOption({ "aircraft", "Aircraft to load.", "count", "2000" });
+    parser.addOption({ "pilots", "Pilots to load.", "count", "500" });
+    parser.addOption({ "defects", "Active defects to load.", "count", "3000" });
+    parser.addOption({ "runs", "Calls per operation.", "count", "200" });
+    parser.addOption({ "seed-runs", "Calls of seedDemoData.", "count", "5" });
+    parser.addOption({ "output", "CSV file with per-operation results.", "file" });
+    parser.process(app);
+
+    QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
+    QString target = env.value("DB_HOST", "db") + "/" + env.value("DB_NAME", "skyready_db");
+    if (!parser.isSet("wipe")) {
+        std::fprintf(stderr, "db_benchmark clears all data in %s; pass --wipe to confirm\n", qPrintable(target));
+        return 1;
+    }
+
+    Options options;
+    options.aircraft = qMax(1, parser.value("aircraft").toInt());
+    options.pilots = qMax(1, parser.value("pilots").toInt());
+    options.defects = qMax(0, parser.value("defects").toInt());
+    options.runs = qMax(1, parser.value("runs").toInt());
+    options.seedRuns = qMax(0, parser.value("seed-runs").toInt());
+    options.outputPath = parser.value("output");
+
+    if (!DatabaseManager::instance().connectToDatabase()) return 2;
+    std::printf("target: %s\n", qPrintable(target));
+
+    DbBenchmark benchmark(options);
+    return benchmark.run();
+}
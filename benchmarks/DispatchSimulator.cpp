@@ -0,0 +1,369 @@
+// Нагрузочный симулятор диспетчерской.
+// N виртуальных диспетчеров работают в своих потоках со своими соединениями
+// (DatabaseManager выдает каждому потоку клон подключения) и выполняют смесь
+// операций FleetService / ReadinessService с заданной общей интенсивностью.
+// На выходе - пропускная способность, гистограммы задержек по операциям и
+// число взаимоблокировок (40P01) и ошибок сериализации (40001).
+//
+// Работает с уже заполненной базой (SkyReady --generate ...) и меняет ее данные:
+//   DB_HOST=localhost DB_NAME=skyready_bench ./dispatch_simulator --dispatchers 32 --rate 400 \
+//       --duration 60 --hot-set 50 --mix 60,20,8,8,4
+#include "src/db/DatabaseManager.h"
+#include "src/db/SqlQuery.h"
+#include "src/repositories/AircraftRepository.h"
+#include "src/repositories/DefectRepository.h"
+#include "src/repositories/PilotRepository.h"
+#include "src/services/FleetService.h"
+#include "src/services/ReadinessService.h"
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QFile>
+#include <QRandomGenerator>
+#include <QTextStream>
+#include <QThread>
+#include <QDebug>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+enum Operation { OpCheckReadiness, OpCommitFlight, OpReportDefect, OpResolveDefect, OpEngineMaintenance, OpCount };
+
+const char* s_operationNames[OpCount] = {
+    "check_readiness", "commit_flight", "report_defect", "resolve_defect", "engine_maintenance"
+};
+
+// Гистограмма задержек по степеням двойки в микросекундах (как ServerStats).
+// У каждого диспетчера своя, сводятся после остановки потоков
+struct LatencyHistogram {
+    static const int Buckets = 32;
+
+    quint64 counts[Buckets] = {};
+    quint64 total = 0;
+    qint64 maxMicros = 0;
+
+    void record(qint64 micros) {
+        int bucket = 0;
+        while (bucket < Buckets - 1 && (qint64(1) << (bucket + 1)) <= micros) ++bucket;
+        counts[bucket]++;
+        total++;
+        maxMicros = qMax(maxMicros, micros);
+    }
+
+    void merge(const LatencyHistogram& other) {
+        for (int b = 0; b < Buckets; ++b) counts[b] += other.counts[b];
+        total += other.total;
+        maxMicros = qMax(maxMicros, other.maxMicros);
+    }
+
+    // Верхняя граница корзины, в которую попадает перцентиль p (0..1), мкс
+    qint64 percentile(double p) const {
+        if (total == 0) return 0;
+        quint64 rank = (quint64)(p * total);
+        quint64 seen = 0;
+        for (int b = 0; b < Buckets; ++b) {
+            seen += counts[b];
+            if (seen > rank) return qint64(1) << (b + 1);
+        }
+        return qint64(1) << Buckets;
+    }
+};
+
+struct OperationResult {
+    LatencyHistogram latency;
+    qint64 ok = 0;
+    qint64 failed = 0;
+    qint64 deadlocks = 0;
+    qint64 serializationFailures = 0;
+
+    void merge(const OperationResult& other) {
+        latency.merge(other.latency);
+        ok += other.ok;
+        failed += other.failed;
+        deadlocks += other.deadlocks;
+        serializationFailures += other.serializationFailures;
+    }
+};
+
+struct Options {
+    int dispatchers = 8;
+    double rate = 50;          // Операций в секунду на всех диспетчеров (0 - без пауз)
+    int durationSec = 30;
+    double mix[OpCount] = { 60, 20, 8, 8, 4 };
+    int hotSet = 0;            // Работать только с первыми K бортами (0 - со всеми)
+    bool serializable = false; // Уровень изоляции SERIALIZABLE для соединений диспетчеров
+    quint32 seed = 1;
+    QString outputPath;
+};
+
+// Общие данные прогона (только чтение из потоков)
+struct Fleet {
+    std::vector<QUuid> aircraftIds;
+    std::vector<QUuid> pilotIds;
+    std::vector<QUuid> defectTypeIds;
+};
+
+// Один виртуальный диспетчер: поток, свое соединение, свои сервисы и статистика
+class Dispatcher {
+public:
+    Dispatcher(int index, const Options& options, const Fleet& fleet)
+        : m_options(options), m_fleet(fleet), m_rng(options.seed + (quint32)index * 7919u)
+    {
+        double total = 0;
+        for (int op = 0; op < OpCount; ++op) {
+            total += qMax(0.0, options.mix[op]);
+            m_mixCumulative[op] = total;
+        }
+    }
+
+    OperationResult results[OpCount];
+
+    void run(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point stop) {
+        if (m_options.serializable) {
+            SqlQuery query(DatabaseManager::instance().getDatabase());
+            query.exec("SET SESSION CHARACTERISTICS AS TRANSACTION ISOLATION LEVEL SERIALIZABLE");
+        }
+
+        // Пуассоновский поток: паузы экспоненциальные со средним dispatchers / rate
+        double ratePerDispatcher = m_options.rate / qMax(1, m_options.dispatchers);
+        std::chrono::steady_clock::time_point next = start;
+
+        while (true) {
+            if (ratePerDispatcher > 0) {
+                double pause = -std::log(1.0 - m_rng.bounded(1.0)) / ratePerDispatcher;
+                next += std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                    std::chrono::duration<double>(pause));
+                if (next >= stop) break;
+                std::this_thread::sleep_until(next);
+            } else if (std::chrono::steady_clock::now() >= stop) {
+                break;
+            }
+            perform(pickOperation());
+        }
+    }
+
+private:
+    Operation pickOperation() {
+        double r = m_rng.bounded(m_mixCumulative[OpCount - 1]);
+        for (int op = 0; op < OpCount; ++op) {
+            if (r < m_mixCumulative[op]) return (Operation)op;
+        }
+        return OpCheckReadiness;
+    }
+
+    QUuid randomAircraft() {
+        int count = (int)m_fleet.aircraftIds.size();
+        if (m_options.hotSet > 0) count = qMin(count, m_options.hotSet);
+        return m_fleet.aircraftIds[m_rng.bounded(count)];
+    }
+
+    void perform(Operation op) {
+        // Параметры выбираются до замера
+        QUuid aircraftId = randomAircraft();
+        QUuid pilotId = m_fleet.pilotIds[m_rng.bounded((int)m_fleet.pilotIds.size())];
+        QUuid defectTypeId = m_fleet.defectTypeIds[m_rng.bounded((int)m_fleet.defectTypeIds.size())];
+        int minutes = 30 + m_rng.bounded(180);
+
+        SqlCounters before = SqlQuery::counters();
+        std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+
+        bool ok = true;
+        switch (op) {
+        case OpCheckReadiness: {
+            FlightParams params;
+            params.fuelAmount = 60.0 + minutes * 0.6;
+            params.cargoWeight = 80.0 + m_rng.bounded(250.0);
+            params.flightTimeMinutes = minutes;
+            m_readiness.checkReadiness(aircraftId, pilotId, params);
+            break;
+        }
+        case OpCommitFlight:
+            ok = m_fleetService.commitFlight(aircraftId, minutes);
+            break;
+        case OpReportDefect:
+            ok = m_fleetService.reportDefect(aircraftId, defectTypeId);
+            break;
+        case OpResolveDefect: {
+            // Как в окне ТО: список дефектов борта, затем снятие первого
+            std::vector<ActiveDefect> defects = m_defectRepo.getByAircraftId(aircraftId);
+            if (!defects.empty()) ok = m_fleetService.resolveDefect(defects.front().id);
+            break;
+        }
+        case OpEngineMaintenance:
+            ok = m_fleetService.performEngineMaintenance(aircraftId);
+            break;
+        default:
+            break;
+        }
+
+        qint64 micros = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - started).count();
+        SqlCounters diff = SqlQuery::counters() - before;
+
+        OperationResult& result = results[op];
+        result.latency.record(micros);
+        if (ok && diff.errors == 0) result.ok++;
+        else result.failed++;
+        result.deadlocks += diff.deadlocks;
+        result.serializationFailures += diff.serializationFailures;
+    }
+
+    const Options& m_options;
+    const Fleet& m_fleet;
+    QRandomGenerator m_rng;
+    double m_mixCumulative[OpCount];
+
+    FleetService m_fleetService;
+    ReadinessService m_readiness;
+    DefectRepository m_defectRepo;
+};
+
+void printReport(const Options& options, const OperationResult (&totals)[OpCount], double seconds) {
+    qint64 allOps = 0, allFailed = 0, allDeadlocks = 0, allSerialization = 0;
+    for (const OperationResult& r : totals) {
+        allOps += r.ok + r.failed;
+        allFailed += r.failed;
+        allDeadlocks += r.deadlocks;
+        allSerialization += r.serializationFailures;
+    }
+
+    std::printf("\n%d dispatchers, %.1f s, %lld operations, %.1f ops/s, %lld failed, "
+                "%lld deadlocks, %lld serialization failures\n\n",
+                options.dispatchers, seconds, (long long)allOps, allOps / seconds, (long long)allFailed,
+                (long long)allDeadlocks, (long long)allSerialization);
+
+    std::printf("%-20s %8s %9s %7s %9s %7s %9s %9s %9s %9s\n", "operation", "count", "ops/s", "failed",
+                "deadlock", "serial", "p50 us", "p90 us", "p99 us", "max us");
+    for (int op = 0; op < OpCount; ++op) {
+        const OperationResult& r = totals[op];
+        if (r.latency.total == 0) continue;
+        std::printf("%-20s %8llu %9.1f %7lld %9lld %7lld %9lld %9lld %9lld %9lld\n", s_operationNames[op],
+                    (unsigned long long)r.latency.total, r.latency.total / seconds, (long long)r.failed,
+                    (long long)r.deadlocks, (long long)r.serializationFailures,
+                    (long long)r.latency.percentile(0.50), (long long)r.latency.percentile(0.90),
+                    (long long)r.latency.percentile(0.99), (long long)r.latency.maxMicros);
+    }
+
+    // Гистограммы: корзина [2^b, 2^(b+1)) мкс, полоса - доля вызовов операции
+    for (int op = 0; op < OpCount; ++op) {
+        const LatencyHistogram& h = totals[op].latency;
+        if (h.total == 0) continue;
+        std::printf("\n%s\n", s_operationNames[op]);
+        for (int b = 0; b < LatencyHistogram::Buckets; ++b) {
+            if (h.counts[b] == 0) continue;
+            int bar = (int)std::lround(50.0 * h.counts[b] / h.total);
+            std::printf("  %9lld - %9lld us %8llu %s\n", (long long)(b == 0 ? 0 : qint64(1) << b),
+                        (long long)(qint64(1) << (b + 1)), (unsigned long long)h.counts[b],
+                        QByteArray(bar, '#').constData());
+        }
+    }
+}
+
+bool writeCsv(const QString& path, const OperationResult (&totals)[OpCount]) {
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qDebug() << "DispatchSimulator: cannot write" << path << ":" << file.errorString();
+        return false;
+    }
+    // Одна строка на корзину гистограммы; сводные счетчики повторяются в каждой строке операции
+    QTextStream out(&file);
+    out << "operation,ok,failed,deadlocks,serialization_failures,bucket_from_us,bucket_to_us,count\n";
+    for (int op = 0; op < OpCount; ++op) {
+        const OperationResult& r = totals[op];
+        for (int b = 0; b < LatencyHistogram::Buckets; ++b) {
+            if (r.latency.counts[b] == 0) continue;
+            out << s_operationNames[op] << ',' << r.ok << ',' << r.failed << ',' << r.deadlocks << ','
+                << r.serializationFailures << ',' << (b == 0 ? 0 : qint64(1) << b) << ','
+                << (qint64(1) << (b + 1)) << ',' << r.latency.counts[b] << '\n';
+        }
+    }
+    return true;
+}
+}
+
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("SkyReady concurrent dispatcher simulator (modifies the target database)");
+    parser.addHelpOption();
+    parser.addOption({ "dispatchers", "Virtual dispatchers (threads and connections).", "count", "8" });
+    parser.addOption({ "rate", "Total operations per second, 0 - as fast as possible.", "ops", "50" });
+    parser.addOption({ "duration", "Run time in seconds.", "seconds", "30" });
+    parser.addOption({ "mix", "Weights: check,commit,report,resolve,maintenance.", "weights", "60,20,8,8,4" });
+    parser.addOption({ "hot-set", "Use only the first K aircraft (0 - whole fleet).", "count", "0" });
+    parser.addOption({ "serializable", "Run dispatcher transactions at SERIALIZABLE isolation." });
+    parser.addOption({ "seed", "Random seed.", "number", "1" });
+    parser.addOption({ "output", "CSV file with latency histograms.", "file" });
+    parser.process(app);
+
+    Options options;
+    options.dispatchers = qMax(1, parser.value("dispatchers").toInt());
+    options.rate = qMax(0.0, parser.value("rate").toDouble());
+    options.durationSec = qMax(1, parser.value("duration").toInt());
+    options.hotSet = qMax(0, parser.value("hot-set").toInt());
+    options.serializable = parser.isSet("serializable");
+    options.seed = parser.value("seed").toUInt();
+    options.outputPath = parser.value("output");
+
+    QStringList weights = parser.value("mix").split(',');
+    double mixTotal = 0;
+    for (int op = 0; op < OpCount; ++op) {
+        options.mix[op] = op < weights.size() ? qMax(0.0, weights[op].trimmed().toDouble()) : 0.0;
+        mixTotal += options.mix[op];
+    }
+    if (mixTotal <= 0) {
+        std::fprintf(stderr, "dispatch_simulator: --mix needs at least one positive weight\n");
+        return 1;
+    }
+
+    if (!DatabaseManager::instance().connectToDatabase()) return 2;
+
+    // Справочные данные читаются один раз основным потоком
+    Fleet fleet;
+    for (const Aircraft& plane : AircraftRepository().getAll()) fleet.aircraftIds.push_back(plane.id);
+    for (const Pilot& pilot : PilotRepository().getAll()) fleet.pilotIds.push_back(pilot.id);
+    for (const DefectType& type : DefectRepository().getAllDefectTypes()) fleet.defectTypeIds.push_back(type.id);
+    if (fleet.aircraftIds.empty() || fleet.pilotIds.empty() || fleet.defectTypeIds.empty()) {
+        std::fprintf(stderr, "dispatch_simulator: database has no fleet; fill it with SkyReady --generate\n");
+        return 1;
+    }
+    std::printf("fleet: %d aircraft (%d in use), %d pilots\n", (int)fleet.aircraftIds.size(),
+                options.hotSet > 0 ? qMin(options.hotSet, (int)fleet.aircraftIds.size()) : (int)fleet.aircraftIds.size(),
+                (int)fleet.pilotIds.size());
+
+    // Все диспетчеры стартуют одновременно, через секунду после создания потоков
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    std::chrono::steady_clock::time_point stop = start + std::chrono::seconds(options.durationSec);
+
+    std::vector<std::unique_ptr<Dispatcher>> dispatchers;
+    std::vector<QThread*> threads;
+    for (int i = 0; i < options.dispatchers; ++i) {
+        dispatchers.emplace_back(new Dispatcher(i, options, fleet));
+        Dispatcher* dispatcher = dispatchers.back().get();
+        threads.push_back(QThread::create([dispatcher, start, stop] {
+            std::this_thread::sleep_until(start);
+            dispatcher->run(start, stop);
+        }));
+        threads.back()->start();
+    }
+    for (QThread* thread : threads) {
+        thread->wait();
+        delete thread;
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    OperationResult totals[OpCount];
+    for (const auto& dispatcher : dispatchers) {
+        for (int op = 0; op < OpCount; ++op) totals[op].merge(dispatcher->results[op]);
+    }
+
+    printReport(options, totals, seconds);
+    if (!options.outputPath.isEmpty() && !writeCsv(options.outputPath, totals)) return 1;
+    return 0;
+}
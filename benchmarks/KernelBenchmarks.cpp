@@ -0,0 +1,296 @@
+// Замеры вычислительных ядер без БД: расчет загрузки, конверт центровки,
+// проверка готовности, разбор допусков пилота и статусы флота.
+// Наборы данных генерируются из фиксированного зерна, поэтому прогоны сравнимы
+// между собой. Запуск: qmake && make benchmarks (результаты - в benchmark_results.csv)
+#include "src/models/Entities.h"
+#include "src/services/WeightCalculator.h"
+#include "src/services/CgEnvelope.h"
+#include "src/services/ReadinessRuleEngine.h"
+#include "src/services/ReadinessService.h"
+#include "src/repositories/PilotRepository.h"
+#include <QtTest>
+#include <QRandomGenerator>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <algorithm>
+#include <vector>
+
+namespace {
+const quint32 Seed = 20240917;
+
+const int ScenarioCount = 4096;     // Сценарии загрузки для calculate
+const int PointCount = 65536;       // Точки (CG, масса) для конверта
+const int ContextCount = 2048;      // Борта для проверки готовности
+const int PilotCount = 512;
+const int PilotJsonCount = 8192;    // Строки allowed_models_json
+const int StatusRows = 131072;      // Строки колонок статуса
+
+// Конверт в формате cg_envelope_json: пятиугольник со срезанным углом
+const char* EnvelopeJson =
+    "{\"arms\": {\"empty\": 39.0, \"fuel\": 48.0, \"payload\": 37.0},"
+    " \"points\": [[35.0, 0], [35.0, 885], [38.5, 1111], [47.3, 1111], [47.3, 0]]}";
+
+QUuid seededUuid(QRandomGenerator& rng) {
+    return QUuid(rng.generate(), (ushort)rng.bounded(65536), (ushort)rng.bounded(65536),
+                 (uchar)rng.bounded(256), (uchar)rng.bounded(256), (uchar)rng.bounded(256),
+                 (uchar)rng.bounded(256), (uchar)rng.bounded(256), (uchar)rng.bounded(256),
+                 (uchar)rng.bounded(256), (uchar)rng.bounded(256));
+}
+
+double between(QRandomGenerator& rng, double from, double to) {
+    return from + rng.bounded(to - from);
+}
+}
+
+class KernelBenchmarks : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void weightCalculate();
+    void envelopeContains();
+    void readinessEvaluate();
+    void readinessEvaluateBatch();
+    void pilotAllowedModelsJson();
+    void aircraftStatus();
+    void pilotStatus();
+
+private:
+    void buildModels(QRandomGenerator& rng);
+    void buildContexts(QRandomGenerator& rng);
+    void buildPilots(QRandomGenerator& rng);
+    void buildStatusColumns(QRandomGenerator& rng);
+
+    std::vector<AircraftModel> m_models;
+    std::shared_ptr<const CompiledRules> m_rules;
+
+    std::vector<FlightParams> m_scenarios;
+    std::vector<double> m_pointCg;
+    std::vector<double> m_pointWeight;
+
+    std::vector<ReadinessContext> m_contexts;
+    std::vector<Pilot> m_pilots;
+    std::vector<ReadinessCheck> m_checks;
+
+    std::vector<QByteArray> m_pilotJson;
+
+    AircraftColumns m_aircraftColumns;
+    PilotColumns m_pilotColumns;
+};
+
+void KernelBenchmarks::initTestCase() {
+    QRandomGenerator rng(Seed);
+    buildModels(rng);
+    buildContexts(rng);
+    buildPilots(rng);
+    buildStatusColumns(rng);
+
+    // Сценарии загрузки: от пустого до перегруженного борта
+    const AircraftModel& model = m_models.front();
+    m_scenarios.reserve(ScenarioCount);
+    for (int i = 0; i < ScenarioCount; ++i) {
+        FlightParams params;
+        params.fuelAmount = between(rng, 20.0, model.fuelCapacity * 1.1);
+        params.cargoWeight = between(rng, 0.0, 450.0);
+        params.flightTimeMinutes = 20 + (int)rng.bounded(300);
+        m_scenarios.push_back(params);
+    }
+
+    // Точки вокруг описывающего прямоугольника конверта (+-10%): часть внутри, часть снаружи
+    const CgEnvelope& envelope = *model.envelope;
+    double cgMargin = (envelope.maxCg - envelope.minCg) * 0.1;
+    double weightMargin = (envelope.maxWeight - envelope.minWeight) * 0.1;
+    m_pointCg.reserve(PointCount);
+    m_pointWeight.reserve(PointCount);
+    for (int i = 0; i < PointCount; ++i) {
+        m_pointCg.push_back(between(rng, envelope.minCg - cgMargin, envelope.maxCg + cgMargin));
+        m_pointWeight.push_back(between(rng, envelope.minWeight, envelope.maxWeight + weightMargin));
+    }
+}
+
+void KernelBenchmarks::buildModels(QRandomGenerator& rng) {
+    // Три типа: у первого свой конверт из JSON, у остальных - профиль по умолчанию
+    const char* names[] = { "Cessna 172S", "Piper PA-28", "Cessna 182T" };
+    const double mtow[] = { 1111.0, 1157.0, 1406.0 };
+    const double empty[] = { 767.0, 680.0, 894.0 };
+
+    std::vector<ReadinessThresholds> rules;
+    ReadinessThresholds defaults;
+    rules.push_back(defaults);
+
+    for (int i = 0; i < 3; ++i) {
+        AircraftModel model;
+        model.id = seededUuid(rng);
+        model.name = names[i];
+        model.maxTakeoffWeight = mtow[i];
+        model.emptyWeight = empty[i];
+        model.fuelCapacity = 200.0 + 20.0 * i;
+        model.fuelConsumption = 32.0 + 8.0 * i;
+        model.cgEnvelopeJson = (i == 0) ? QByteArray(EnvelopeJson) : QByteArray();
+        model.envelope = CgEnvelope::compile(model, model.cgEnvelopeJson);
+        m_models.push_back(model);
+
+        ReadinessThresholds thresholds;
+        thresholds.modelId = model.id;
+        thresholds.serviceSoonHours = 5.0 + 5.0 * i;
+        thresholds.maxMinorDefects = 2 + i;
+        thresholds.licenseWarningDays = 30 + 15 * i;
+        rules.push_back(thresholds);
+    }
+    m_rules = ReadinessRuleEngine::compile(rules);
+}
+
+void KernelBenchmarks::buildContexts(QRandomGenerator& rng) {
+    m_contexts.reserve(ContextCount);
+    for (int i = 0; i < ContextCount; ++i) {
+        const AircraftModel& model = m_models[rng.bounded((int)m_models.size())];
+
+        ReadinessContext context;
+        context.aircraft.id = seededUuid(rng);
+        context.aircraft.modelId = model.id;
+        context.aircraft.regNumber = QString("RA-%1").arg(10000 + i);
+        context.aircraft.modelName = model.name;
+        context.aircraft.fuelCapacity = model.fuelCapacity;
+        context.aircraft.engineHoursTotal = between(rng, 0.0, 2000.0);
+        context.aircraft.engineHoursNextService = context.aircraft.engineHoursTotal + between(rng, -5.0, 100.0);
+        context.model = model;
+        context.criticalDefects = rng.bounded(20) == 0 ? 1 : 0;
+        context.minorDefects = rng.bounded(5);
+        context.rules = m_rules;
+        m_contexts.push_back(context);
+    }
+}
+
+void KernelBenchmarks::buildPilots(QRandomGenerator& rng) {
+    // Даты - от текущего дня, чтобы доли просроченных документов не зависели от даты запуска
+    QDate today = QDate::currentDate();
+    m_pilots.reserve(PilotCount);
+    for (int i = 0; i < PilotCount; ++i) {
+        Pilot pilot;
+        pilot.id = seededUuid(rng);
+        pilot.fullName = QString("Pilot %1").arg(i);
+        pilot.licenseExpiryDate = today.addDays(rng.bounded(730) - 60);
+        pilot.medicalExpiryDate = today.addDays(rng.bounded(365) - 20);
+        for (const AircraftModel& model : m_models) {
+            if (rng.bounded(3) != 0) pilot.allowedModels.append(model.id);
+        }
+        m_pilots.push_back(pilot);
+    }
+
+    m_checks.reserve(ContextCount);
+    for (int i = 0; i < ContextCount; ++i) {
+        ReadinessCheck check;
+        check.context = &m_contexts[i];
+        check.pilot = &m_pilots[rng.bounded(PilotCount)];
+        check.params.fuelAmount = between(rng, 40.0, m_contexts[i].model.fuelCapacity);
+        check.params.cargoWeight = between(rng, 70.0, 400.0);
+        check.params.flightTimeMinutes = 30 + (int)rng.bounded(240);
+        m_checks.push_back(check);
+    }
+
+    // allowed_models_json в том виде, в каком его пишет PilotRepository::create (1-8 типов)
+    m_pilotJson.reserve(PilotJsonCount);
+    for (int i = 0; i < PilotJsonCount; ++i) {
+        QJsonArray models;
+        int count = 1 + rng.bounded(8);
+        for (int k = 0; k < count; ++k) models.append(seededUuid(rng).toString());
+        m_pilotJson.push_back(QJsonDocument(models).toJson(QJsonDocument::Compact));
+    }
+}
+
+void KernelBenchmarks::buildStatusColumns(QRandomGenerator& rng) {
+    m_aircraftColumns.reserve(StatusRows);
+    m_pilotColumns.reserve(StatusRows);
+    for (int i = 0; i < StatusRows; ++i) {
+        int model = m_rules->modelIndex(m_models[rng.bounded((int)m_models.size())].id);
+        m_aircraftColumns.append(between(rng, -5.0, 100.0), rng.bounded(20) == 0 ? 1 : 0,
+                                 rng.bounded(5), model);
+        m_pilotColumns.append(rng.bounded(730) - 60, rng.bounded(365) - 20, model);
+    }
+}
+
+void KernelBenchmarks::weightCalculate() {
+    WeightCalculator calculator;
+    const AircraftModel& model = m_models.front();
+    const Aircraft& aircraft = m_contexts.front().aircraft;
+    int cgOk = 0;
+
+    QBENCHMARK {
+        cgOk = 0;
+        for (const FlightParams& params : m_scenarios) {
+            cgOk += calculator.calculate(model, aircraft, params).isCgOk;
+        }
+    }
+    QVERIFY(cgOk > 0 && cgOk < ScenarioCount);
+}
+
+void KernelBenchmarks::envelopeContains() {
+    const CgEnvelope& envelope = *m_models.front().envelope;
+    int inside = 0;
+
+    QBENCHMARK {
+        inside = 0;
+        for (int i = 0; i < PointCount; ++i) {
+            inside += envelope.contains(m_pointCg[i], m_pointWeight[i]);
+        }
+    }
+    QVERIFY(inside > 0 && inside < PointCount);
+}
+
+void KernelBenchmarks::readinessEvaluate() {
+    ReadinessService service;
+    int ready = 0;
+
+    QBENCHMARK {
+        ready = 0;
+        for (const ReadinessCheck& check : m_checks) {
+            ready += service.evaluate(*check.context, *check.pilot, check.params).isReady;
+        }
+    }
+    QVERIFY(ready > 0 && ready < ContextCount);
+}
+
+void KernelBenchmarks::readinessEvaluateBatch() {
+    ReadinessService service;
+    std::vector<ReadinessReport> reports;
+
+    QBENCHMARK {
+        service.evaluateBatch(m_checks, reports);
+    }
+    QCOMPARE(reports.size(), m_checks.size());
+}
+
+void KernelBenchmarks::pilotAllowedModelsJson() {
+    int models = 0;
+
+    QBENCHMARK {
+        models = 0;
+        for (const QByteArray& json : m_pilotJson) {
+            models += PilotRepository::parseAllowedModels(json).size();
+        }
+    }
+    QVERIFY(models >= PilotJsonCount);
+}
+
+void KernelBenchmarks::aircraftStatus() {
+    std::vector<quint16> status(StatusRows);
+
+    QBENCHMARK {
+        m_rules->evaluateAircraft(m_aircraftColumns, status.data(), 0, StatusRows);
+    }
+    QVERIFY(std::any_of(status.begin(), status.end(), [](quint16 s) { return s & AircraftGroundedMask; }));
+}
+
+void KernelBenchmarks::pilotStatus() {
+    std::vector<quint16> status(StatusRows);
+
+    QBENCHMARK {
+        m_rules->evaluatePilots(m_pilotColumns, status.data(), 0, StatusRows);
+    }
+    QVERIFY(std::any_of(status.begin(), status.end(), [](quint16 s) { return s & PilotGroundedMask; }));
+}
+
+QTEST_GUILESS_MAIN(KernelBenchmarks)
+
+#include "KernelBenchmarks.moc"
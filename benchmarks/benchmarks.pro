@@ -0,0 +1,33 @@
+QT       += core sql concurrent testlib
+QT       -= gui
+
+CONFIG += c++17 console testcase
+CONFIG -= app_bundle
+
+TARGET = kernel_benchmarks
+
+# Исходники приложения подключаются как "src/..."
+INCLUDEPATH += ..
+
+simd_avx2 {
+    QMAKE_CXXFLAGS += -mavx2
+}
+
+SOURCES += \
+    KernelBenchmarks.cpp \
+    ../src/db/DatabaseManager.cpp \
+    ../src/db/SqlQuery.cpp \
+    ../src/repositories/AircraftRepository.cpp \
+    ../src/repositories/AircraftModelRepository.cpp \
+    ../src/repositories/DefectRepository.cpp \
+    ../src/repositories/PilotRepository.cpp \
+    ../src/repositories/ReadinessRuleRepository.cpp \
+    ../src/services/ReadinessService.cpp \
+    ../src/services/WeightCalculator.cpp \
+    ../src/services/CgEnvelope.cpp \
+    ../src/services/LoadSolver.cpp \
+    ../src/services/DispatchPlanner.cpp \
+    ../src/services/ReadinessRuleEngine.cpp \
+    ../src/services/ParallelFor.cpp \
+    ../src/services/Trace.cpp \
+    ../src/services/Metrics.cpp
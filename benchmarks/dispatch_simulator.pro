@@ -0,0 +1,38 @@
+QT       += core sql concurrent
+QT       -= gui
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = dispatch_simulator
+
+# Исходники приложения подключаются как "src/..."
+INCLUDEPATH += ..
+
+simd_avx2 {
+    QMAKE_CXXFLAGS += -mavx2
+}
+
+SOURCES += \
+    DispatchSimulator.cpp \
+    ../src/db/DatabaseManager.cpp \
+    ../src/db/SqlQuery.cpp \
+    ../src/models/FleetStore.cpp \
+    ../src/repositories/AircraftRepository.cpp \
+    ../src/repositories/AircraftModelRepository.cpp \
+    ../src/repositories/DefectRepository.cpp \
+    ../src/repositories/FlightLogRepository.cpp \
+    ../src/repositories/PilotRepository.cpp \
+    ../src/repositories/ReadinessRuleRepository.cpp \
+    ../src/services/FleetService.cpp \
+    ../src/services/FleetStatusService.cpp \
+    ../src/services/MaintenanceForecast.cpp \
+    ../src/services/ReadinessService.cpp \
+    ../src/services/WeightCalculator.cpp \
+    ../src/services/CgEnvelope.cpp \
+    ../src/services/LoadSolver.cpp \
+    ../src/services/DispatchPlanner.cpp \
+    ../src/services/ReadinessRuleEngine.cpp \
+    ../src/services/ParallelFor.cpp \
+    ../src/services/Trace.cpp \
+    ../src/services/Metrics.cpp
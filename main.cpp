@@ -1,11 +1,244 @@
 #include <QApplication>
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <cstring>
+#include <memory>
 #include "src/ui/MainWindow.h"
+#include "src/services/BatchReadinessRunner.h"
+#include "src/services/FleetDataGenerator.h"
+#include "src/server/ReadinessHttpServer.h"
+#include "src/db/DatabaseManager.h"
+#include "src/repositories/AircraftModelRepository.h"
+#include "src/repositories/ReadinessRuleRepository.h"
+#include "src/services/Trace.h"
+#include "src/services/Metrics.h"
+#include "src/services/MetricsPublisher.h"
+#include <QHostAddress>
+#include <QTextStream>
+#include <QDebug>
+
+namespace {
+// SKYREADY_METRICS_FILE=/var/lib/node_exporter/textfile/skyready.prom: метрики для textfile collector
+QString metricsPath() {
+    return qEnvironmentVariable("SKYREADY_METRICS_FILE");
+}
+
+bool hasFlag(int argc, char *argv[], const char *flag) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], flag) == 0) return true;
+    }
+    return false;
+}
+
+// Пакетная проверка без GUI: skyready --batch [--input plan.csv] [--output verdicts.jsonl]
+int runBatch(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("SkyReady headless readiness checks");
+    parser.addHelpOption();
+    parser.addOption({ "batch", "Check planned flights without GUI." });
+    parser.addOption({ "input", "Planned flights (CSV or JSON Lines), '-' for stdin.", "file", "-" });
+    parser.addOption({ "output", "Verdicts as JSON Lines, '-' for stdout.", "file", "-" });
+    parser.addOption({ "format", "Input format: csv, jsonl (default: detect).", "format" });
+    parser.addOption({ "chunk", "Flights per evaluation block.", "rows", "8192" });
+    parser.process(app);
+
+    BatchReadinessRunner::Options options;
+    options.inputPath = parser.value("input");
+    options.outputPath = parser.value("output");
+    options.format = BatchReadinessRunner::parseFormat(parser.value("format"));
+    options.chunkSize = parser.value("chunk").toInt();
+
+    BatchReadinessRunner runner(options);
+    return runner.run();
+}
+
+// Синтетический флот для нагрузочных тестов (заменяет все данные в БД):
+// skyready --generate --aircraft 100000 --defect-rate 10 [--seed 42] [--model-mix 5,3,1,1,0]
+int runGenerator(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("SkyReady synthetic fleet generator (replaces all data)");
+    parser.addHelpOption();
+    parser.addOption({ "generate", "Replace database contents with a synthetic fleet." });
+    parser.addOption({ "seed", "Random seed.", "number", "1" });
+    parser.addOption({ "aircraft", "Fleet size.", "count", "1000" });
+    parser.addOption({ "pilots", "Pilot count.", "count", "200" });
+    parser.addOption({ "defect-rate", "Average active defects per aircraft.", "rate", "0.5" });
+    parser.addOption({ "critical-share", "Share of critical defects (0..1).", "share", "0.1" });
+    parser.addOption({ "ratings", "Average type ratings per pilot.", "count", "1.5" });
+    parser.addOption({ "expired-share", "Chance of an expired pilot document (0..1).", "share", "0.05" });
+    parser.addOption({ "model-mix", "Weights of catalogue types: "
+                       + FleetDataGenerator::catalogueNames().join(", ") + ".", "weights" });
+    parser.process(app);
+
+    FleetDataGenerator::Options options;
+    options.seed = parser.value("seed").toUInt();
+    options.aircraft = parser.value("aircraft").toInt();
+    options.pilots = parser.value("pilots").toInt();
+    options.defectRate = parser.value("defect-rate").toDouble();
+    options.criticalShare = parser.value("critical-share").toDouble();
+    options.ratingsPerPilot = parser.value("ratings").toDouble();
+    options.expiredShare = parser.value("expired-share").toDouble();
+    options.modelMix = FleetDataGenerator::parseMix(parser.value("model-mix"));
+
+    if (!DatabaseManager::instance().connectToDatabase()) return 2;
+
+    FleetDataGenerator generator(options);
+    return generator.generate().ok ? 0 : 1;
+}
+
+// Пороги готовности (таблица readiness_rules): без значений - вывод всех правил,
+// иначе создание/обновление правила модели или значений по умолчанию:
+// skyready --rules [--model "Cessna 172"] [--service-soon 10] [--max-minor 3] [--license-days 30] [--remove]
+int runRules(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("SkyReady readiness thresholds per operator and per model");
+    parser.addHelpOption();
+    parser.addOption({ "rules", "Show or change readiness thresholds." });
+    parser.addOption({ "model", "Aircraft model name or id (default: operator defaults).", "model" });
+    parser.addOption({ "service-soon", "Warn when fewer engine hours remain to service.", "hours" });
+    parser.addOption({ "max-minor", "Minor defects that ground the aircraft.", "count" });
+    parser.addOption({ "license-days", "Warn this many days before a license expires.", "days" });
+    parser.addOption({ "remove", "Remove the model override (defaults apply again)." });
+    parser.process(app);
+
+    if (!DatabaseManager::instance().connectToDatabase()) return 2;
+
+    QTextStream out(stdout);
+    std::vector<AircraftModel> models = AircraftModelRepository().getAll();
+    auto modelName = [&models](const QUuid& id) {
+        for (const AircraftModel& m : models) {
+            if (m.id == id) return m.name;
+        }
+        return id.toString(QUuid::WithoutBraces);
+    };
+
+    QUuid modelId;
+    if (parser.isSet("model")) {
+        QString key = parser.value("model");
+        for (const AircraftModel& m : models) {
+            if (m.id == QUuid(key) || m.name.compare(key, Qt::CaseInsensitive) == 0) modelId = m.id;
+        }
+        if (modelId.isNull()) {
+            qDebug() << "Rules: unknown aircraft model" << key;
+            return 1;
+        }
+    }
+
+    ReadinessRuleRepository repo;
+    std::vector<ReadinessThresholds> rules = repo.getAll();
+
+    if (parser.isSet("remove")) {
+        if (modelId.isNull()) {
+            qDebug() << "Rules: --remove needs --model (operator defaults cannot be removed)";
+            return 1;
+        }
+        return repo.removeForModel(modelId) ? 0 : 1;
+    }
+
+    const bool change = parser.isSet("service-soon") || parser.isSet("max-minor") || parser.isSet("license-days");
+    if (!change) {
+        for (const ReadinessThresholds& t : rules) {
+            out << (t.modelId.isNull() ? QString("(default)") : modelName(t.modelId))
+                << ": service-soon " << t.serviceSoonHours
+                << ", max-minor " << t.maxMinorDefects
+                << ", license-days " << t.licenseWarningDays << "\n";
+        }
+        return 0;
+    }
+
+    // Неуказанные значения берутся из текущего правила модели (или встроенные)
+    ReadinessThresholds thresholds;
+    for (const ReadinessThresholds& t : rules) {
+        if (t.modelId == modelId) thresholds = t;
+    }
+    thresholds.modelId = modelId;
+    if (parser.isSet("service-soon")) thresholds.serviceSoonHours = parser.value("service-soon").toDouble();
+    if (parser.isSet("max-minor")) thresholds.maxMinorDefects = parser.value("max-minor").toInt();
+    if (parser.isSet("license-days")) thresholds.licenseWarningDays = parser.value("license-days").toInt();
+
+    return repo.save(thresholds) ? 0 : 1;
+}
+
+// HTTP/JSON сервер готовности: skyready --serve [--bind 0.0.0.0] [--port 8080] [--workers 8]
+int runServer(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("SkyReady readiness HTTP service");
+    parser.addHelpOption();
+    parser.addOption({ "serve", "Run the HTTP/JSON readiness service." });
+    parser.addOption({ "bind", "Address to listen on.", "address", "127.0.0.1" });
+    parser.addOption({ "port", "TCP port.", "port", "8080" });
+    parser.addOption({ "workers", "Worker threads (0 - by CPU count).", "count", "0" });
+    parser.process(app);
+
+    // Основное подключение открывается здесь, рабочие потоки получают его клоны
+    if (!DatabaseManager::instance().connectToDatabase()) {
+        // Рабочие потоки повторяют подключение на каждом запросе (до connect_timeout),
+        // пока сервер БД не ответит
+        qDebug() << "Server: database unavailable, API answers 503 and reconnects on requests";
+    }
+
+    // Метрики сервера отдаются на /metrics всегда, файл - если задан
+    Metrics::setQueryAttribution(true);
+    MetricsPublisher metrics("server", metricsPath());
+
+    ReadinessHttpServer server(parser.value("workers").toInt());
+    QHostAddress address(parser.value("bind"));
+    quint16 port = (quint16)parser.value("port").toUInt();
+
+    if (!server.listen(address, port)) {
+        qDebug() << "Server: cannot listen on" << address.toString() << port << ":" << server.errorString();
+        return 1;
+    }
+    qDebug() << "Server: listening on" << address.toString() << server.serverPort();
+
+    return app.exec();
+}
+
+int run(int argc, char *argv[]) {
+    // Режим без окна выбирается до создания приложения (QCoreApplication не требует дисплея)
+    if (hasFlag(argc, argv, "--batch")) {
+        return runBatch(argc, argv);
+    }
+    if (hasFlag(argc, argv, "--generate")) {
+        return runGenerator(argc, argv);
+    }
+    if (hasFlag(argc, argv, "--rules")) {
+        return runRules(argc, argv);
+    }
+    if (hasFlag(argc, argv, "--serve")) {
+        return runServer(argc, argv);
+    }
 
-int main(int argc, char *argv[]) {
     QApplication app(argc, argv);
 
+    std::unique_ptr<MetricsPublisher> metrics;
+    if (!metricsPath().isEmpty()) metrics.reset(new MetricsPublisher("gui", metricsPath()));
+
     MainWindow window;
     window.show();
 
     return app.exec();
 }
+}
+
+int main(int argc, char *argv[]) {
+    // SKYREADY_TRACE=trace.json: трассировка с запуска, выгрузка при выходе (в любом режиме)
+    QString tracePath = qEnvironmentVariable("SKYREADY_TRACE");
+    if (!tracePath.isEmpty()) Trace::setEnabled(true);
+    if (!metricsPath().isEmpty()) Metrics::setQueryAttribution(true);
+
+    int code = run(argc, argv);
+
+    if (!tracePath.isEmpty()) Trace::exportChromeJson(tracePath);
+    // Итоговые значения (пакетный режим и генератор пишут файл только здесь)
+    if (!metricsPath().isEmpty()) Metrics::writeTextFile(metricsPath());
+    return code;
+}
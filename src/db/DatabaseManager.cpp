@@ -1,5 +1,37 @@
 #include "src/db/DatabaseManager.h"
+#include "src/db/SqlQuery.h"
 #include <QProcessEnvironment>
+#include <QThread>
+#include <QThreadStorage>
+
+namespace {
+// Подключение фонового потока: удаляется вместе с данными потока при его завершении
+struct ThreadConnection {
+    QString name;
+
+    ~ThreadConnection() {
+        {
+            QSqlDatabase db = QSqlDatabase::database(name, false);
+            if (db.isOpen()) db.close();
+        }
+        QSqlDatabase::removeDatabase(name);
+    }
+};
+
+QThreadStorage<ThreadConnection*> s_threadConnections;
+
+// Параметры подключения из окружения
+void applySettings(QSqlDatabase& db) {
+    QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
+
+    db.setHostName(env.value("DB_HOST", "db"));
+    db.setDatabaseName(env.value("DB_NAME", "skyready_db"));
+    db.setUserName(env.value("DB_USER", "postgres"));
+    db.setPassword(env.value("DB_PASSWORD", "postgres"));
+    // Недоступный сервер не держит подключение дольше нескольких секунд
+    db.setConnectOptions("connect_timeout=" + env.value("DB_CONNECT_TIMEOUT", "5"));
+}
+}
 
 DatabaseManager& DatabaseManager::instance() {
     static DatabaseManager instance;
@@ -18,21 +50,12 @@ DatabaseManager::~DatabaseManager() {
 bool DatabaseManager::connectToDatabase() {
     // Используем драйвер PostgreSQL
     m_db = QSqlDatabase::addDatabase("QPSQL");
+    m_ownerThread = QThread::currentThread();
 
     // НАСТРОЙКИ ПОДКЛЮЧЕНИЯ
-    QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
-
-    QString host = env.value("DB_HOST", "db");
-    QString dbName = env.value("DB_NAME", "skyready_db");
-    QString user = env.value("DB_USER", "postgres");
-    QString password = env.value("DB_PASSWORD", "postgres");
-
-    m_db.setHostName(host);
-    m_db.setDatabaseName(dbName);
-    m_db.setUserName(user);
-    m_db.setPassword(password);
+    applySettings(m_db);
 
-    qDebug() << "Connecting to database at:" << host << "User:" << user;
+    qDebug() << "Connecting to database at:" << m_db.hostName() << "User:" << m_db.userName();
 
     if (!m_db.open()) {
         qDebug() << "Error: Connection with database failed:" << m_db.lastError().text();
@@ -46,8 +69,29 @@ bool DatabaseManager::connectToDatabase() {
     }
 }
 
+void DatabaseManager::disconnectFromDatabase() {
+    if (m_db.isOpen()) {
+        m_db.close();
+        qDebug() << "Database: connection closed";
+    }
+}
+
+bool DatabaseManager::probeConnection() {
+    QString name = QString("skyready_probe_%1").arg(quintptr(QThread::currentThreadId()));
+    bool ok = false;
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QPSQL", name);
+        applySettings(db);
+        ok = db.open();
+        if (!ok) qDebug() << "Database: server unreachable:" << db.lastError().text();
+        db.close();
+    }
+    QSqlDatabase::removeDatabase(name);
+    return ok;
+}
+
 void DatabaseManager::initDatabase() {
-    QSqlQuery query(m_db);
+    SqlQuery query(m_db);
     bool success = true;
 
     // 1. Справочник моделей самолетов (хранит характеристики типа)
@@ -60,11 +104,25 @@ void DatabaseManager::initDatabase() {
         "   empty_weight DOUBLE PRECISION NOT NULL,"
         "   fuel_capacity DOUBLE PRECISION NOT NULL,"
         "   fuel_consumption DOUBLE PRECISION NOT NULL,"
-        "   cg_envelope_json JSONB"
+        "   cg_envelope_json JSONB,"
+        "   cg_profile VARCHAR(32)"
         ");"
     );
     if (query.lastError().isValid()) qDebug() << "Table 'aircraft_models' error:" << query.lastError().text();
 
+    // Встроенный профиль центровки для моделей без cg_envelope_json. У старых баз
+    // он выбирался по названию модели - выбор фиксируется в колонке один раз, при
+    // ее добавлении; дальше ни переименование, ни новые модели по названию не судятся
+    query.exec("SELECT 1 FROM information_schema.columns "
+               "WHERE table_name = 'aircraft_models' AND column_name = 'cg_profile'");
+    if (!query.lastError().isValid() && !query.next()) {
+        query.exec("ALTER TABLE aircraft_models ADD COLUMN cg_profile VARCHAR(32)");
+        query.exec("UPDATE aircraft_models "
+                   "SET cg_profile = CASE WHEN name LIKE '%Piper%' THEN 'piper' ELSE 'cessna' END "
+                   "WHERE cg_envelope_json IS NULL");
+        if (query.lastError().isValid()) qDebug() << "Migration 'cg_profile' error:" << query.lastError().text();
+    }
+
     // 2. Самолеты (конкретные борта)
     success &= query.exec(
         "CREATE TABLE IF NOT EXISTS aircrafts ("
@@ -110,11 +168,76 @@ void DatabaseManager::initDatabase() {
     );
     if (query.lastError().isValid()) qDebug() << "Table 'active_defects' error:" << query.lastError().text();
 
+    // 6. Пороги готовности (model_id = NULL - значения оператора по умолчанию)
+    success &= query.exec(
+        "CREATE TABLE IF NOT EXISTS readiness_rules ("
+        "   id UUID PRIMARY KEY,"
+        "   model_id UUID UNIQUE REFERENCES aircraft_models(id) ON DELETE CASCADE,"
+        "   service_soon_hours DOUBLE PRECISION NOT NULL DEFAULT 10,"
+        "   max_minor_defects INTEGER NOT NULL DEFAULT 3,"
+        "   license_warning_days INTEGER NOT NULL DEFAULT 30"
+        ");"
+    );
+    if (query.lastError().isValid()) qDebug() << "Table 'readiness_rules' error:" << query.lastError().text();
+
+    // Одна строка на модель и одна строка по умолчанию: иначе скомпилированные
+    // правила зависят от порядка строк. В старых базах дубликаты сначала убираются
+    query.exec("DELETE FROM readiness_rules a USING readiness_rules b "
+               "WHERE a.model_id IS NOT DISTINCT FROM b.model_id AND a.ctid < b.ctid");
+    if (query.numRowsAffected() > 0) {
+        qDebug() << "readiness_rules: removed" << query.numRowsAffected() << "duplicate rows";
+    }
+    query.exec("DO $$ BEGIN "
+               "  IF NOT EXISTS (SELECT 1 FROM pg_constraint WHERE conname = 'readiness_rules_model_id_key') THEN "
+               "    ALTER TABLE readiness_rules ADD CONSTRAINT readiness_rules_model_id_key UNIQUE (model_id); "
+               "  END IF; "
+               "END $$");
+    // UNIQUE не мешает нескольким NULL - значение по умолчанию ограничивает частичный индекс
+    query.exec("CREATE UNIQUE INDEX IF NOT EXISTS idx_readiness_rules_default "
+               "ON readiness_rules ((model_id IS NULL)) WHERE model_id IS NULL");
+    if (query.lastError().isValid()) qDebug() << "Index 'readiness_rules' error:" << query.lastError().text();
+
+    // 7. Журнал выполненных полетов (источник для прогноза налета)
+    success &= query.exec(
+        "CREATE TABLE IF NOT EXISTS flight_log ("
+        "   id UUID PRIMARY KEY,"
+        "   aircraft_id UUID REFERENCES aircrafts(id) ON DELETE CASCADE,"
+        "   flown_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP,"
+        "   minutes INTEGER NOT NULL"
+        ");"
+    );
+    if (query.lastError().isValid()) qDebug() << "Table 'flight_log' error:" << query.lastError().text();
+    query.exec("CREATE INDEX IF NOT EXISTS idx_flight_log_aircraft ON flight_log (aircraft_id, flown_at)");
+
     if (success) {
         qDebug() << "Database tables initialized successfully.";
     }
 }
 
 QSqlDatabase DatabaseManager::getDatabase() const {
-    return m_db;
+    if (m_ownerThread == nullptr || QThread::currentThread() == m_ownerThread) {
+        return m_db;
+    }
+    return threadDatabase();
+}
+
+QSqlDatabase DatabaseManager::threadDatabase() const {
+    if (s_threadConnections.hasLocalData()) {
+        return QSqlDatabase::database(s_threadConnections.localData()->name);
+    }
+
+    QString name = QString("skyready_thread_%1").arg(quintptr(QThread::currentThreadId()));
+    {
+        // Параметры подключения читаются у основного соединения
+        QMutexLocker locker(&m_cloneMutex);
+        QSqlDatabase clone = QSqlDatabase::cloneDatabase(m_db, name);
+        if (!clone.open()) {
+            qDebug() << "Error: Thread connection failed:" << clone.lastError().text();
+        }
+    }
+
+    ThreadConnection *connection = new ThreadConnection;
+    connection->name = name;
+    s_threadConnections.setLocalData(connection);
+    return QSqlDatabase::database(name);
 }
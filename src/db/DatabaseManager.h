@@ -5,6 +5,9 @@
 #include <QDebug>
 #include <QSqlQuery>
 #include <QSqlError>
+#include <QMutex>
+
+class QThread;
 
 class DatabaseManager {
 public:
@@ -15,16 +18,33 @@ public:
     // Возвращает true, если подключение успешно
     bool connectToDatabase();
 
+    // Закрытие основного подключения (сервер пропал посреди сеанса):
+    // getDatabase().isOpen() в потоке окна снова false до connectToDatabase
+    void disconnectFromDatabase();
+
+    // Пробное подключение с теми же параметрами в текущем потоке (сразу закрывается).
+    // Для фоновой проверки сервера: connectToDatabase открывает основное
+    // подключение и должен вызываться в потоке, который им пользуется
+    static bool probeConnection();
+
     // Создание структуры таблиц, если их нет
     void initDatabase();
 
-    // Получение текущего объекта базы
+    // Получение текущего объекта базы.
+    // Соединение QSqlDatabase можно использовать только в создавшем его потоке,
+    // поэтому фоновые потоки получают собственный клон основного подключения
+    // (открывается при первом обращении, закрывается при завершении потока)
     QSqlDatabase getDatabase() const;
 
 private:
     DatabaseManager();
     ~DatabaseManager();
+
+    QSqlDatabase threadDatabase() const;
+
     QSqlDatabase m_db;
+    QThread *m_ownerThread = nullptr;  // Поток, в котором открыто основное подключение
+    mutable QMutex m_cloneMutex;
 };
 
 #endif // DATABASEMANAGER_H
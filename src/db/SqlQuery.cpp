@@ -0,0 +1,138 @@
+#include "src/db/SqlQuery.h"
+#include "src/services/Trace.h"
+#include "src/services/Metrics.h"
+
+namespace {
+// Свои счетчики у каждого потока: соединения тоже свои (см. DatabaseManager)
+thread_local SqlCounters t_counters;
+thread_local QString t_lastSqlState;
+}
+
+SqlCounters SqlCounters::operator-(const SqlCounters& other) const {
+    SqlCounters diff;
+    diff.queries = queries - other.queries;
+    diff.prepares = prepares - other.prepares;
+    diff.deallocates = deallocates - other.deallocates;
+    diff.transactions = transactions - other.transactions;
+    diff.errors = errors - other.errors;
+    diff.deadlocks = deadlocks - other.deadlocks;
+    diff.serializationFailures = serializationFailures - other.serializationFailures;
+    return diff;
+}
+
+SqlCounters& SqlCounters::operator+=(const SqlCounters& other) {
+    queries += other.queries;
+    prepares += other.prepares;
+    deallocates += other.deallocates;
+    transactions += other.transactions;
+    errors += other.errors;
+    deadlocks += other.deadlocks;
+    serializationFailures += other.serializationFailures;
+    return *this;
+}
+
+SqlQuery::SqlQuery(QSqlDatabase db)
+    : QSqlQuery(db)
+{
+}
+
+SqlQuery::SqlQuery(const QString& sql, QSqlDatabase db)
+    : QSqlQuery(db)
+{
+    exec(sql);
+}
+
+SqlQuery::~SqlQuery() {
+    if (m_prepared) t_counters.deallocates++;
+}
+
+bool SqlQuery::prepare(const QString& sql) {
+    TraceScope span("sql", "SqlQuery::prepare");
+    if (span.active()) span.setDetail(sql.toUtf8());
+    if (m_prepared) t_counters.deallocates++;
+    t_counters.prepares++;
+    m_prepared = QSqlQuery::prepare(sql);
+    if (!m_prepared) countError(lastError());
+    return m_prepared;
+}
+
+bool SqlQuery::exec() {
+    TraceScope span("sql", "SqlQuery::exec");
+    if (span.active()) span.setDetail(lastQuery().toUtf8());
+    t_counters.queries++;
+    Metrics::countQuery();
+    bool ok = QSqlQuery::exec();
+    if (!ok) countError(lastError());
+    return ok;
+}
+
+bool SqlQuery::exec(const QString& sql) {
+    TraceScope span("sql", "SqlQuery::exec");
+    if (span.active()) span.setDetail(sql.toUtf8());
+    // Выполнение текста сбрасывает ранее подготовленный запрос
+    if (m_prepared) t_counters.deallocates++;
+    m_prepared = false;
+    t_counters.queries++;
+    Metrics::countQuery();
+    bool ok = QSqlQuery::exec(sql);
+    if (!ok) countError(lastError());
+    return ok;
+}
+
+bool SqlQuery::transaction(QSqlDatabase db) {
+    TRACE_SCOPE("sql", "SqlQuery::transaction");
+    t_counters.transactions++;
+    bool ok = db.transaction();
+    if (!ok) countError(db.lastError());
+    return ok;
+}
+
+bool SqlQuery::commit(QSqlDatabase db) {
+    TRACE_SCOPE("sql", "SqlQuery::commit");
+    t_counters.transactions++;
+    bool ok = db.commit();
+    if (!ok) countError(db.lastError());
+    return ok;
+}
+
+bool SqlQuery::rollback(QSqlDatabase db) {
+    TRACE_SCOPE("sql", "SqlQuery::rollback");
+    t_counters.transactions++;
+    bool ok = db.rollback();
+    if (!ok) countError(db.lastError());
+    return ok;
+}
+
+SqlCounters SqlQuery::counters() {
+    return t_counters;
+}
+
+QString SqlQuery::lastSqlState() {
+    return t_lastSqlState;
+}
+
+void SqlQuery::countError(const QSqlError& error) {
+    // QPSQL отдает SQLSTATE в nativeErrorCode
+    t_lastSqlState = error.nativeErrorCode();
+    t_counters.errors++;
+    if (t_lastSqlState == "40P01") t_counters.deadlocks++;
+    else if (t_lastSqlState == "40001") t_counters.serializationFailures++;
+}
+
+QString SqlQuery::arrayLiteral(const QStringList& items) {
+    // Каждый элемент в кавычках: внутри могут быть запятые, скобки и пробелы
+    QString literal;
+    literal.reserve(items.size() * 40 + 2);
+    literal += '{';
+    for (int i = 0; i < items.size(); ++i) {
+        if (i > 0) literal += ',';
+        literal += '"';
+        for (const QChar c : items[i]) {
+            if (c == '"' || c == '\\') literal += '\\';
+            literal += c;
+        }
+        literal += '"';
+    }
+    literal += '}';
+    return literal;
+}
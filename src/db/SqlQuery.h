@@ -0,0 +1,65 @@
+#ifndef SQLQUERY_H
+#define SQLQUERY_H
+
+#include <QSqlQuery>
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <QString>
+#include <QStringList>
+
+// Счетчики обращений к серверу, накопленные потоком с момента запуска.
+// Замер операции - разница двух снимков (см. benchmarks/DbBenchmark.cpp)
+struct SqlCounters {
+    qint64 queries = 0;       // Выполненные запросы (exec)
+    qint64 prepares = 0;      // Подготовки (PREPARE)
+    qint64 deallocates = 0;   // Освобождения подготовленных запросов (DEALLOCATE)
+    qint64 transactions = 0;  // BEGIN / COMMIT / ROLLBACK
+
+    // Ошибки сервера; конфликты параллельных транзакций считаются отдельно по SQLSTATE
+    qint64 errors = 0;
+    qint64 deadlocks = 0;              // 40P01 deadlock_detected
+    qint64 serializationFailures = 0;  // 40001 serialization_failure
+
+    // Каждое из действий драйвера QPSQL - отдельный обмен с сервером
+    qint64 roundTrips() const { return queries + prepares + deallocates + transactions; }
+
+    SqlCounters operator-(const SqlCounters& other) const;
+    SqlCounters& operator+=(const SqlCounters& other);
+};
+
+// QSqlQuery с учетом обращений к серверу. Репозитории и сервисы создают
+// запросы через этот класс, поэтому счетчики видят всю работу с БД.
+// Драйвер QPSQL готовит запрос на сервере (PREPARE), выполняет его (EXECUTE)
+// и освобождает при повторной подготовке или удалении запроса (DEALLOCATE)
+class SqlQuery : public QSqlQuery {
+public:
+    explicit SqlQuery(QSqlDatabase db);
+    SqlQuery(const QString& sql, QSqlDatabase db);  // Выполняет sql сразу, как QSqlQuery
+    ~SqlQuery();
+
+    bool prepare(const QString& sql);
+    bool exec();
+    bool exec(const QString& sql);
+
+    // Транзакции соединения с тем же учетом
+    static bool transaction(QSqlDatabase db);
+    static bool commit(QSqlDatabase db);
+    static bool rollback(QSqlDatabase db);
+
+    // Счетчики текущего потока
+    static SqlCounters counters();
+
+    // SQLSTATE последней ошибки сервера в текущем потоке (пусто - ошибок не было)
+    static QString lastSqlState();
+
+    // Литерал массива PostgreSQL ({"a","b"}) для передачи колонки одним параметром:
+    // INSERT ... SELECT * FROM unnest(CAST(:col AS UUID[]), ...)
+    static QString arrayLiteral(const QStringList& items);
+
+private:
+    static void countError(const QSqlError& error);
+
+    bool m_prepared = false;  // На сервере есть подготовленный запрос этого объекта
+};
+
+#endif // SQLQUERY_H
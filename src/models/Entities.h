@@ -5,7 +5,13 @@
 #include <QUuid>
 #include <QDate>
 #include <QJsonObject>
+#include <QByteArray>
 #include <vector>
+#include <memory>
+#include <array>
+
+struct CgEnvelope;
+class CompiledRules;
 
 // Модель самолета
 struct AircraftModel {
@@ -15,6 +21,9 @@ struct AircraftModel {
     double emptyWeight;
     double fuelCapacity;
     double fuelConsumption; // л/час
+    QByteArray cgEnvelopeJson; // Конверт центровки и плечи (как в БД)
+    QString cgProfile;         // Встроенный профиль ("piper", "cessna") - только если нет cgEnvelopeJson
+    std::shared_ptr<const CgEnvelope> envelope; // Скомпилированный конверт (см. CgEnvelope)
 };
 
 // Конкретный борт
@@ -39,6 +48,20 @@ struct Pilot {
     QList<QUuid> allowedModels;
 };
 
+// Допуск пилота к конкретному типу (порядок - приоритет в списке выбора)
+enum class PilotFitness {
+    Eligible = 0,   // Допущен к типу, документы действительны
+    Expired = 1,    // Допущен к типу, но лицензия или медкомиссия просрочены
+    NotRated = 2    // Нет допуска к типу
+};
+
+// Строка списка пилотов для выбора (без разбора JSON допусков на клиенте)
+struct PilotListEntry {
+    QUuid id;
+    QString fullName;
+    PilotFitness fitness = PilotFitness::NotRated;
+};
+
 // Тип неисправности (из справочника)
 struct DefectType {
     QUuid id;
@@ -56,6 +79,47 @@ struct ActiveDefect {
     QString severity;
 };
 
+// Пороги готовности. Запись без modelId - значения оператора по умолчанию,
+// запись с modelId переопределяет их для конкретной модели
+struct ReadinessThresholds {
+    QUuid modelId;
+    double serviceSoonHours = 10.0;  // Предупреждать о ТО, если осталось меньше, ч
+    int maxMinorDefects = 3;         // С таким числом мелких дефектов вылет запрещен
+    int licenseWarningDays = 30;     // Предупреждать об истечении лицензии за, дней
+};
+
+// Количество активных дефектов на борту (сводка по одному самолету)
+struct DefectCounts {
+    int critical = 0;
+    int minor = 0;
+};
+
+// Выполненный полет для пакетной фиксации
+struct FlightCompletion {
+    QUuid aircraftId;
+    int flightTimeMinutes = 0;
+};
+
+// Суммарный налет борта за один день (агрегат журнала полетов flight_log)
+struct DailyFlightHours {
+    QUuid aircraftId;
+    QDate day;
+    double hours = 0;
+};
+
+// Контекст борта для проверки готовности.
+// Загружается из БД один раз, дальше проверки идут только в памяти
+struct ReadinessContext {
+    Aircraft aircraft;
+    AircraftModel model;
+    std::vector<ActiveDefect> defects;
+    int criticalDefects = 0;
+    int minorDefects = 0;
+    std::shared_ptr<const CompiledRules> rules; // Пороги готовности (см. ReadinessRuleEngine)
+
+    bool isLoaded() const { return !aircraft.id.isNull(); }
+};
+
 // Параметры для расчета рейса (от пользователя)
 struct FlightParams {
     double fuelAmount;      // Заливаемое топливо
@@ -63,11 +127,60 @@ struct FlightParams {
     int flightTimeMinutes;  // Планируемое время
 };
 
+// Коды результатов проверки. Текст формируется только при показе (см. ReadinessText),
+// числовые подробности передаются в Issue::values
+enum class IssueCode : quint8 {
+    AircraftNotFound,
+    EngineHoursExhausted,   // [0] переработка, ч
+    EngineServiceSoon,      // [0] осталось до ТО, ч
+    CriticalDefects,        // [0] количество
+    MinorDefectLimit,       // [0] количество, [1] допустимый лимит
+    MinorDefects,           // [0] количество
+    PilotNotFound,
+    LicenseExpired,         // [0] дата истечения (юлианский день)
+    LicenseExpiringSoon,    // [0] дней до истечения
+    MedicalExpired,
+    NoTypeRating,
+    ModelNotFound,
+    LoadLimitsViolated,     // [0] маска нарушенных ограничений (LoadCheck)
+    Overweight,             // [0] масса, кг, [1] MTOW, кг
+    FuelInsufficient,       // [0] нужно, л, [1] в баках, л
+    FuelOverCapacity,       // [0] объем баков, л
+    CgOutOfEnvelope         // [0] CG, [1]-[2] допустимый диапазон
+};
+
+// Одно замечание проверки
+struct Issue {
+    IssueCode code;
+    double values[3];
+};
+
+// Список замечаний фиксированной емкости (без выделения памяти)
+struct IssueList {
+    static const int Capacity = 12;
+
+    std::array<Issue, Capacity> items;
+    int count = 0;
+
+    void add(IssueCode code, double v0 = 0, double v1 = 0, double v2 = 0) {
+        if (count < Capacity) items[count++] = Issue{ code, { v0, v1, v2 } };
+    }
+    bool contains(IssueCode code) const {
+        for (int i = 0; i < count; ++i) {
+            if (items[i].code == code) return true;
+        }
+        return false;
+    }
+    bool isEmpty() const { return count == 0; }
+    const Issue* begin() const { return items.data(); }
+    const Issue* end() const { return items.data() + count; }
+};
+
 // Результат проверки
 struct ReadinessReport {
     bool isReady;           // GO / NO-GO
-    QStringList warnings;   // Список предупреждений (желтый статус)
-    QStringList errors;     // Список причин отказа (красный статус)
+    IssueList warnings;     // Список предупреждений (желтый статус)
+    IssueList errors;       // Список причин отказа (красный статус)
 };
 
 #endif // ENTITIES_H
@@ -0,0 +1,406 @@
+#include "src/models/FleetSnapshot.h"
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QDebug>
+#include <cstddef>
+#include <cstring>
+
+namespace {
+
+const char s_magic[8] = { 'S', 'K', 'Y', 'S', 'N', 'A', 'P', 0 };
+const quint32 s_byteOrderMark = 0x01020304;
+
+enum Section {
+    SecModels,          // ModelRecord[modelCount]
+    SecAircraftIds,     // 16 байт RFC 4122 на борт
+    SecRegNumbers,      // StringRef на борт
+    SecModelIndex,      // qint32
+    SecHoursTotal,      // double
+    SecHoursNext,       // double
+    SecCritical,        // qint32
+    SecMinor,           // qint32
+    SecStatus,          // quint16
+    SecDaysToService,   // qint32
+    SecDailyHours,      // float
+    SecPilots,          // PilotRecord[pilotCount]
+    SecAllowedModels,   // 16 байт на допуск, диапазоны - в PilotRecord
+    SecStrings,         // UTF-8 без завершающих нулей
+    SectionCount
+};
+
+struct SnapshotHeader {
+    char magic[8];
+    quint32 version;
+    quint32 byteOrderMark;
+    quint64 fileSize;
+    qint64 createdMs;        // UTC, мс от эпохи
+    quint32 aircraftCount;
+    quint32 modelCount;
+    quint32 pilotCount;
+    quint32 checksum;        // CRC-32 байтов [sizeof(SnapshotHeader), fileSize)
+    quint64 offsets[SectionCount];
+    quint64 sizes[SectionCount];
+};
+
+struct StringRef {
+    quint32 offset;  // В секции строк
+    quint32 length;  // Байт UTF-8
+};
+
+struct ModelRecord {
+    uchar id[16];
+    StringRef name;
+};
+
+struct PilotRecord {
+    uchar id[16];
+    StringRef fullName;
+    qint64 licenseExpiry;   // Юлианский день (QDate::toJulianDay)
+    qint64 medicalExpiry;
+    quint32 allowedOffset;  // Индекс первого допуска в SecAllowedModels
+    quint32 allowedCount;
+};
+
+const size_t UuidBytes = 16;
+
+// CRC-32 (IEEE 802.3), таблица строится при первом вызове
+quint32 crc32(const uchar* data, size_t size) {
+    static const std::vector<quint32> table = [] {
+        std::vector<quint32> t(256);
+        for (quint32 i = 0; i < 256; ++i) {
+            quint32 c = i;
+            for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            t[i] = c;
+        }
+        return t;
+    }();
+
+    quint32 crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; ++i) crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    return crc ^ 0xFFFFFFFFu;
+}
+
+quint64 align8(quint64 n) {
+    return (n + 7) & ~quint64(7);
+}
+
+// Сборщик файла: секции добавляются по порядку, каждая с выравниванием
+class SnapshotWriter {
+public:
+    explicit SnapshotWriter(SnapshotHeader& header)
+        : m_header(header)
+    {
+        m_buffer.resize(sizeof(SnapshotHeader));
+    }
+
+    template <typename T>
+    void section(Section id, const T* items, size_t count) {
+        section(id, reinterpret_cast<const char*>(items), count * sizeof(T));
+    }
+
+    void section(Section id, const char* bytes, size_t size) {
+        quint64 offset = align8((quint64)m_buffer.size());
+        m_buffer.append(QByteArray(int(offset - m_buffer.size()), '\0'));
+        m_buffer.append(bytes, (int)size);
+        m_header.offsets[id] = offset;
+        m_header.sizes[id] = size;
+    }
+
+    QByteArray& buffer() { return m_buffer; }
+
+private:
+    SnapshotHeader& m_header;
+    QByteArray m_buffer;
+};
+
+// Пул строк для записи
+class StringPool {
+public:
+    StringRef add(const QString& text) {
+        QByteArray utf8 = text.toUtf8();
+        StringRef ref{ (quint32)m_bytes.size(), (quint32)utf8.size() };
+        m_bytes.append(utf8);
+        return ref;
+    }
+    const QByteArray& bytes() const { return m_bytes; }
+
+private:
+    QByteArray m_bytes;
+};
+
+void copyUuid(uchar* out, const QUuid& id) {
+    QByteArray raw = id.toRfc4122();
+    std::memcpy(out, raw.constData(), UuidBytes);
+}
+
+QUuid readUuid(const uchar* in) {
+    return QUuid::fromRfc4122(QByteArray::fromRawData(reinterpret_cast<const char*>(in), (int)UuidBytes));
+}
+
+template <typename T>
+T readAt(const uchar* base, size_t index) {
+    T value;
+    std::memcpy(&value, base + index * sizeof(T), sizeof(T));
+    return value;
+}
+}
+
+QString FleetSnapshot::defaultPath() {
+    QString path = qEnvironmentVariable("SKYREADY_SNAPSHOT");
+    if (!path.isEmpty()) return path;
+    return QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + "/fleet.snapshot";
+}
+
+bool FleetSnapshot::write(const QString& path, const FleetStore& store, const std::vector<Pilot>& pilots) {
+    const size_t n = store.size();
+
+    SnapshotHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, s_magic, sizeof(s_magic));
+    header.version = Version;
+    header.byteOrderMark = s_byteOrderMark;
+    header.createdMs = QDateTime::currentMSecsSinceEpoch();
+    header.aircraftCount = (quint32)n;
+    header.modelCount = (quint32)store.modelCount();
+    header.pilotCount = (quint32)pilots.size();
+
+    StringPool strings;
+
+    std::vector<ModelRecord> models(store.modelCount());
+    for (int m = 0; m < store.modelCount(); ++m) {
+        copyUuid(models[m].id, store.modelIdAt(m));
+        models[m].name = strings.add(store.modelNameAt(m));
+    }
+
+    std::vector<uchar> ids(n * UuidBytes);
+    std::vector<StringRef> regs(n);
+    std::vector<qint32> modelIndex(n), critical(n), minor(n), daysToService(n);
+    std::vector<double> hoursTotal(n), hoursNext(n);
+    std::vector<quint16> status(n);
+    std::vector<float> dailyHours(n);
+    for (size_t i = 0; i < n; ++i) {
+        copyUuid(&ids[i * UuidBytes], store.id(i));
+        regs[i] = strings.add(store.regNumber(i));
+        modelIndex[i] = store.modelIndex(i);
+        hoursTotal[i] = store.hoursTotal(i);
+        hoursNext[i] = store.hoursNextService(i);
+        critical[i] = store.criticalDefects(i);
+        minor[i] = store.minorDefects(i);
+        status[i] = store.status(i);
+        daysToService[i] = store.daysToService(i);
+        dailyHours[i] = store.dailyHours(i);
+    }
+
+    std::vector<PilotRecord> pilotRecords(pilots.size());
+    std::vector<uchar> allowed;
+    for (size_t p = 0; p < pilots.size(); ++p) {
+        const Pilot& pilot = pilots[p];
+        PilotRecord& record = pilotRecords[p];
+        copyUuid(record.id, pilot.id);
+        record.fullName = strings.add(pilot.fullName);
+        record.licenseExpiry = pilot.licenseExpiryDate.toJulianDay();
+        record.medicalExpiry = pilot.medicalExpiryDate.toJulianDay();
+        record.allowedOffset = (quint32)(allowed.size() / UuidBytes);
+        record.allowedCount = (quint32)pilot.allowedModels.size();
+        for (const QUuid& modelId : pilot.allowedModels) {
+            allowed.resize(allowed.size() + UuidBytes);
+            copyUuid(&allowed[allowed.size() - UuidBytes], modelId);
+        }
+    }
+
+    SnapshotWriter writer(header);
+    writer.section(SecModels, models.data(), models.size());
+    writer.section(SecAircraftIds, ids.data(), ids.size());
+    writer.section(SecRegNumbers, regs.data(), regs.size());
+    writer.section(SecModelIndex, modelIndex.data(), n);
+    writer.section(SecHoursTotal, hoursTotal.data(), n);
+    writer.section(SecHoursNext, hoursNext.data(), n);
+    writer.section(SecCritical, critical.data(), n);
+    writer.section(SecMinor, minor.data(), n);
+    writer.section(SecStatus, status.data(), n);
+    writer.section(SecDaysToService, daysToService.data(), n);
+    writer.section(SecDailyHours, dailyHours.data(), n);
+    writer.section(SecPilots, pilotRecords.data(), pilotRecords.size());
+    writer.section(SecAllowedModels, allowed.data(), allowed.size());
+    writer.section(SecStrings, strings.bytes().constData(), (size_t)strings.bytes().size());
+
+    QByteArray& buffer = writer.buffer();
+    header.fileSize = (quint64)buffer.size();
+    header.checksum = crc32(reinterpret_cast<const uchar*>(buffer.constData()) + sizeof(SnapshotHeader),
+                            buffer.size() - sizeof(SnapshotHeader));
+    std::memcpy(buffer.data(), &header, sizeof(header));
+
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qDebug() << "FleetSnapshot: cannot write" << path << ":" << file.errorString();
+        return false;
+    }
+    file.write(buffer);
+    return file.commit();
+}
+
+FleetSnapshot::~FleetSnapshot() {
+    close();
+}
+
+bool FleetSnapshot::open(const QString& path) {
+    close();
+    m_error.clear();
+
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly)) return fail("нет файла снимка");
+
+    m_size = m_file.size();
+    if (m_size < (qint64)sizeof(SnapshotHeader)) return fail("файл короче заголовка");
+
+    m_data = m_file.map(0, m_size);
+    if (!m_data) return fail("не удалось отобразить файл в память");
+
+    SnapshotHeader header;
+    std::memcpy(&header, m_data, sizeof(header));
+    if (std::memcmp(header.magic, s_magic, sizeof(s_magic)) != 0) return fail("не снимок SkyReady");
+    if (header.byteOrderMark != s_byteOrderMark) return fail("другой порядок байтов");
+    if (header.version != Version) return fail(QString("версия %1, ожидается %2").arg(header.version).arg(Version));
+    if (header.fileSize != (quint64)m_size) return fail("размер файла не совпадает с заголовком");
+
+    // Границы секций и размеры колонок до контрольной суммы: дальше чтение без проверок
+    const quint64 n = header.aircraftCount;
+    const quint64 expected[SectionCount] = {
+        header.modelCount * sizeof(ModelRecord), n * UuidBytes, n * sizeof(StringRef),
+        n * sizeof(qint32), n * sizeof(double), n * sizeof(double), n * sizeof(qint32), n * sizeof(qint32),
+        n * sizeof(quint16), n * sizeof(qint32), n * sizeof(float),
+        header.pilotCount * sizeof(PilotRecord), 0, 0
+    };
+    for (int s = 0; s < SectionCount; ++s) {
+        if (header.offsets[s] < sizeof(SnapshotHeader) || header.offsets[s] % 8 != 0 ||
+            header.sizes[s] > header.fileSize || header.offsets[s] > header.fileSize - header.sizes[s]) {
+            return fail("секция за пределами файла");
+        }
+        if (s != SecAllowedModels && s != SecStrings && header.sizes[s] != expected[s]) {
+            return fail("размер секции не совпадает с числом записей");
+        }
+    }
+    if (header.sizes[SecAllowedModels] % UuidBytes != 0) return fail("поврежден список допусков");
+
+    if (crc32(m_data + sizeof(SnapshotHeader), m_size - sizeof(SnapshotHeader)) != header.checksum) {
+        return fail("контрольная сумма не совпадает");
+    }
+
+    // Ссылки из записей: строки, индексы моделей и диапазоны допусков
+    const quint64 stringBytes = header.sizes[SecStrings];
+    auto validRef = [stringBytes](const StringRef& ref) {
+        return (quint64)ref.offset + ref.length <= stringBytes;
+    };
+    for (quint32 m = 0; m < header.modelCount; ++m) {
+        if (!validRef(readAt<ModelRecord>(m_data + header.offsets[SecModels], m).name)) return fail("поврежден пул строк");
+    }
+    for (quint64 i = 0; i < n; ++i) {
+        if (!validRef(readAt<StringRef>(m_data + header.offsets[SecRegNumbers], i))) return fail("поврежден пул строк");
+        qint32 model = readAt<qint32>(m_data + header.offsets[SecModelIndex], i);
+        if (model < 0 || (quint32)model >= header.modelCount) return fail("неверный индекс типа");
+    }
+    const quint64 allowedCount = header.sizes[SecAllowedModels] / UuidBytes;
+    for (quint32 p = 0; p < header.pilotCount; ++p) {
+        PilotRecord record = readAt<PilotRecord>(m_data + header.offsets[SecPilots], p);
+        if (!validRef(record.fullName)) return fail("поврежден пул строк");
+        if ((quint64)record.allowedOffset + record.allowedCount > allowedCount) return fail("поврежден список допусков");
+    }
+
+    return true;
+}
+
+void FleetSnapshot::close() {
+    if (m_data) m_file.unmap(const_cast<uchar*>(m_data));
+    m_data = nullptr;
+    m_size = 0;
+    if (m_file.isOpen()) m_file.close();
+}
+
+bool FleetSnapshot::fail(const QString& reason) {
+    m_error = reason;
+    close();
+    return false;
+}
+
+QDateTime FleetSnapshot::createdAt() const {
+    if (!m_data) return QDateTime();
+    return QDateTime::fromMSecsSinceEpoch(reinterpret_cast<const SnapshotHeader*>(m_data)->createdMs);
+}
+
+int FleetSnapshot::aircraftCount() const {
+    return m_data ? (int)reinterpret_cast<const SnapshotHeader*>(m_data)->aircraftCount : 0;
+}
+
+int FleetSnapshot::pilotCount() const {
+    return m_data ? (int)reinterpret_cast<const SnapshotHeader*>(m_data)->pilotCount : 0;
+}
+
+QString FleetSnapshot::stringAt(const uchar* ref) const {
+    const SnapshotHeader* header = reinterpret_cast<const SnapshotHeader*>(m_data);
+    StringRef r;
+    std::memcpy(&r, ref, sizeof(r));
+    return QString::fromUtf8(reinterpret_cast<const char*>(m_data + header->offsets[SecStrings] + r.offset), (int)r.length);
+}
+
+void FleetSnapshot::readFleet(FleetStore& store) const {
+    store.clear();
+    if (!m_data) return;
+
+    const SnapshotHeader* header = reinterpret_cast<const SnapshotHeader*>(m_data);
+    auto base = [&](Section s) { return m_data + header->offsets[s]; };
+
+    std::vector<QUuid> modelIds(header->modelCount);
+    std::vector<QString> modelNames(header->modelCount);
+    for (quint32 m = 0; m < header->modelCount; ++m) {
+        const uchar* record = base(SecModels) + m * sizeof(ModelRecord);
+        modelIds[m] = readUuid(record);
+        modelNames[m] = stringAt(record + offsetof(ModelRecord, name));
+    }
+
+    store.reserve(header->aircraftCount);
+    for (quint32 i = 0; i < header->aircraftCount; ++i) {
+        FleetRow row;
+        row.id = readUuid(base(SecAircraftIds) + i * UuidBytes);
+        row.regNumber = stringAt(base(SecRegNumbers) + i * sizeof(StringRef));
+        qint32 model = readAt<qint32>(base(SecModelIndex), i);
+        row.modelId = modelIds[model];
+        row.modelName = modelNames[model];
+        row.hoursTotal = readAt<double>(base(SecHoursTotal), i);
+        row.hoursNextService = readAt<double>(base(SecHoursNext), i);
+        row.criticalDefects = readAt<qint32>(base(SecCritical), i);
+        row.minorDefects = readAt<qint32>(base(SecMinor), i);
+        row.status = readAt<quint16>(base(SecStatus), i);
+        row.daysToService = readAt<qint32>(base(SecDaysToService), i);
+        row.dailyHours = readAt<float>(base(SecDailyHours), i);
+        store.append(row);
+    }
+}
+
+std::vector<Pilot> FleetSnapshot::readPilots() const {
+    std::vector<Pilot> pilots;
+    if (!m_data) return pilots;
+
+    const SnapshotHeader* header = reinterpret_cast<const SnapshotHeader*>(m_data);
+    const uchar* records = m_data + header->offsets[SecPilots];
+    const uchar* allowed = m_data + header->offsets[SecAllowedModels];
+
+    pilots.reserve(header->pilotCount);
+    for (quint32 p = 0; p < header->pilotCount; ++p) {
+        const uchar* at = records + p * sizeof(PilotRecord);
+        PilotRecord record = readAt<PilotRecord>(records, p);
+
+        Pilot pilot;
+        pilot.id = readUuid(record.id);
+        pilot.fullName = stringAt(at + offsetof(PilotRecord, fullName));
+        pilot.licenseExpiryDate = QDate::fromJulianDay(record.licenseExpiry);
+        pilot.medicalExpiryDate = QDate::fromJulianDay(record.medicalExpiry);
+        for (quint32 k = 0; k < record.allowedCount; ++k) {
+            pilot.allowedModels.append(readUuid(allowed + (record.allowedOffset + k) * UuidBytes));
+        }
+        pilots.push_back(pilot);
+    }
+    return pilots;
+}
@@ -0,0 +1,63 @@
+#ifndef FLEETSNAPSHOT_H
+#define FLEETSNAPSHOT_H
+
+#include "src/models/Entities.h"
+#include "src/models/FleetStore.h"
+#include <QDateTime>
+#include <QFile>
+#include <QString>
+#include <vector>
+
+// Двоичный снимок флота на диске: строки таблицы (борта, типы, счетчики
+// дефектов, статус и прогноз ТО) и пилоты на момент последней загрузки из БД.
+// Окно показывает его при запуске до подключения к БД и в режиме только
+// чтения, если БД недоступна.
+//
+// Формат - заголовок и секции, выровненные по 8 байт; колонки флота лежат
+// массивами, как в FleetStore, строки (UTF-8) - в общем пуле. Заголовок
+// содержит версию, размер файла, смещения и размеры секций и CRC-32 всего,
+// что после заголовка. Порядок байтов - машины, записавшей снимок (проверяется
+// меткой). Чтение - через отображение файла в память с проверкой всех границ
+class FleetSnapshot {
+public:
+    static const quint32 Version = 1;
+
+    // SKYREADY_SNAPSHOT или fleet.snapshot в каталоге данных приложения
+    static QString defaultPath();
+
+    // Запись через временный файл: прерванная запись не портит прежний снимок
+    static bool write(const QString& path, const FleetStore& store, const std::vector<Pilot>& pilots);
+
+    FleetSnapshot() = default;
+    ~FleetSnapshot();
+
+    FleetSnapshot(const FleetSnapshot&) = delete;
+    FleetSnapshot& operator=(const FleetSnapshot&) = delete;
+
+    // Отображает файл в память и проверяет его; false - снимка нет или он
+    // поврежден/другой версии (причина в errorString)
+    bool open(const QString& path);
+    void close();
+
+    bool isOpen() const { return m_data != nullptr; }
+    QString errorString() const { return m_error; }
+
+    QDateTime createdAt() const;
+    int aircraftCount() const;
+    int pilotCount() const;
+
+    // Строки флота в хранилище (прежнее содержимое заменяется)
+    void readFleet(FleetStore& store) const;
+    std::vector<Pilot> readPilots() const;
+
+private:
+    bool fail(const QString& reason);
+    QString stringAt(const uchar* ref) const;
+
+    QFile m_file;
+    const uchar* m_data = nullptr;
+    qint64 m_size = 0;
+    QString m_error;
+};
+
+#endif // FLEETSNAPSHOT_H
@@ -0,0 +1,162 @@
+#include "src/models/FleetStore.h"
+
+void FleetStore::clear() {
+    m_ids.clear();
+    m_regNumbers.clear();
+    m_modelIndex.clear();
+    m_hoursTotal.clear();
+    m_hoursNextService.clear();
+    m_criticalDefects.clear();
+    m_minorDefects.clear();
+    m_status.clear();
+    m_daysToService.clear();
+    m_dailyHours.clear();
+    m_rowById.clear();
+    // Справочник моделей сохраняем: он мал и почти не меняется
+}
+
+void FleetStore::reserve(size_t n) {
+    m_ids.reserve(n);
+    m_regNumbers.reserve(n);
+    m_modelIndex.reserve(n);
+    m_hoursTotal.reserve(n);
+    m_hoursNextService.reserve(n);
+    m_criticalDefects.reserve(n);
+    m_minorDefects.reserve(n);
+    m_status.reserve(n);
+    m_daysToService.reserve(n);
+    m_dailyHours.reserve(n);
+    m_rowById.reserve((int)n);
+}
+
+int FleetStore::internModel(const QUuid& modelId, const QString& name) {
+    auto it = m_modelLookup.constFind(modelId);
+    if (it != m_modelLookup.constEnd()) {
+        // Модель могли переименовать - держим актуальное название
+        if (m_modelNames[*it] != name) m_modelNames[*it] = name;
+        return *it;
+    }
+
+    int index = (int)m_modelNames.size();
+    m_modelIds.push_back(modelId);
+    m_modelNames.push_back(name);
+    m_modelLookup.insert(modelId, index);
+    return index;
+}
+
+size_t FleetStore::append(const FleetRow& row) {
+    size_t index = m_ids.size();
+
+    m_ids.push_back(row.id);
+    m_regNumbers.push_back(row.regNumber);
+    m_modelIndex.push_back(internModel(row.modelId, row.modelName));
+    m_hoursTotal.push_back(row.hoursTotal);
+    m_hoursNextService.push_back(row.hoursNextService);
+    m_criticalDefects.push_back(row.criticalDefects);
+    m_minorDefects.push_back(row.minorDefects);
+    m_status.push_back(row.status);
+    m_daysToService.push_back(row.daysToService);
+    m_dailyHours.push_back(row.dailyHours);
+    m_rowById.insert(row.id, (int)index);
+
+    return index;
+}
+
+FleetRow FleetStore::row(size_t i) const {
+    FleetRow r;
+    r.id = m_ids[i];
+    r.regNumber = m_regNumbers[i];
+    r.modelId = m_modelIds[m_modelIndex[i]];
+    r.modelName = m_modelNames[m_modelIndex[i]];
+    r.hoursTotal = m_hoursTotal[i];
+    r.hoursNextService = m_hoursNextService[i];
+    r.criticalDefects = m_criticalDefects[i];
+    r.minorDefects = m_minorDefects[i];
+    r.status = m_status[i];
+    r.daysToService = m_daysToService[i];
+    r.dailyHours = m_dailyHours[i];
+    return r;
+}
+
+quint32 FleetStore::update(size_t i, const FleetRow& row) {
+    quint32 changed = 0;
+
+    if (m_regNumbers[i] != row.regNumber) {
+        m_regNumbers[i] = row.regNumber;
+        changed |= FieldRegNumber;
+    }
+
+    int model = internModel(row.modelId, row.modelName);
+    if (m_modelIndex[i] != model) {
+        m_modelIndex[i] = model;
+        changed |= FieldModel;
+    }
+
+    if (m_hoursTotal[i] != row.hoursTotal || m_hoursNextService[i] != row.hoursNextService) {
+        m_hoursTotal[i] = row.hoursTotal;
+        m_hoursNextService[i] = row.hoursNextService;
+        changed |= FieldHours;
+    }
+
+    if (m_criticalDefects[i] != row.criticalDefects || m_minorDefects[i] != row.minorDefects) {
+        m_criticalDefects[i] = row.criticalDefects;
+        m_minorDefects[i] = row.minorDefects;
+        changed |= FieldDefects;
+    }
+
+    if (m_status[i] != row.status) {
+        m_status[i] = row.status;
+        changed |= FieldStatus;
+    }
+
+    if (m_daysToService[i] != row.daysToService || m_dailyHours[i] != row.dailyHours) {
+        m_daysToService[i] = row.daysToService;
+        m_dailyHours[i] = row.dailyHours;
+        changed |= FieldForecast;
+    }
+
+    return changed;
+}
+
+void FleetStore::removeAt(size_t i) {
+    removeRows({ (int)i });
+}
+
+namespace {
+// Сдвигает оставшиеся строки колонки на место удаленных (один проход)
+template <typename T>
+void compactColumn(std::vector<T>& column, const std::vector<int>& removed) {
+    size_t out = (size_t)removed.front();
+    size_t next = 0;
+    for (size_t i = out; i < column.size(); ++i) {
+        if (next < removed.size() && (size_t)removed[next] == i) {
+            ++next;
+            continue;
+        }
+        column[out++] = std::move(column[i]);
+    }
+    column.resize(out);
+}
+}
+
+void FleetStore::removeRows(const std::vector<int>& indices) {
+    if (indices.empty()) return;
+
+    for (int i : indices) m_rowById.remove(m_ids[i]);
+
+    compactColumn(m_ids, indices);
+    compactColumn(m_regNumbers, indices);
+    compactColumn(m_modelIndex, indices);
+    compactColumn(m_hoursTotal, indices);
+    compactColumn(m_hoursNextService, indices);
+    compactColumn(m_criticalDefects, indices);
+    compactColumn(m_minorDefects, indices);
+    compactColumn(m_status, indices);
+    compactColumn(m_daysToService, indices);
+    compactColumn(m_dailyHours, indices);
+
+    // Позиции сменились только у строк после первой удаленной
+    for (size_t k = (size_t)indices.front(); k < m_ids.size(); ++k) {
+        m_rowById[m_ids[k]] = (int)k;
+    }
+}
@@ -0,0 +1,98 @@
+#ifndef FLEETSTORE_H
+#define FLEETSTORE_H
+
+#include <QString>
+#include <QStringList>
+#include <QUuid>
+#include <QHash>
+#include <vector>
+
+// Строка флота в развернутом виде (для загрузки и точечных обновлений)
+struct FleetRow {
+    QUuid id;
+    QString regNumber;
+    QUuid modelId;
+    QString modelName;
+    double hoursTotal = 0;
+    double hoursNextService = 0;
+    int criticalDefects = 0;
+    int minorDefects = 0;
+    quint16 status = 0;       // Флаги AircraftStatusFlag
+    int daysToService = -1;   // Прогноз ТО (-1 - неизвестно)
+    float dailyHours = 0;     // Средний налет в день
+};
+
+// Поля строки флота (для маски изменений при точечном обновлении)
+enum FleetField : quint32 {
+    FieldRegNumber = 1 << 0,
+    FieldModel     = 1 << 1,
+    FieldHours     = 1 << 2,  // Налет и отметка ТО (остаток ресурса)
+    FieldDefects   = 1 << 3,
+    FieldStatus    = 1 << 4,
+    FieldForecast  = 1 << 5
+};
+
+// Колоночное хранилище флота для таблицы: параллельные массивы по полям.
+// Названия моделей хранятся один раз, в строке - только индекс модели
+class FleetStore {
+public:
+    size_t size() const { return m_ids.size(); }
+    bool isEmpty() const { return m_ids.empty(); }
+
+    void clear();
+    void reserve(size_t n);
+
+    // Добавляет строку, возвращает ее индекс
+    size_t append(const FleetRow& row);
+    FleetRow row(size_t index) const;
+
+    // Точечные изменения. update возвращает маску измененных колонок
+    // (флаги FleetField), 0 - строка не изменилась
+    quint32 update(size_t index, const FleetRow& row);
+    void removeAt(size_t index);
+
+    // Удаление нескольких строк за один проход по колонкам.
+    // indices - строго по возрастанию
+    void removeRows(const std::vector<int>& indices);
+
+    // Индекс строки по ID борта (-1 - нет)
+    int indexOf(const QUuid& id) const { return m_rowById.value(id, -1); }
+
+    const QUuid& id(size_t i) const { return m_ids[i]; }
+    const QString& regNumber(size_t i) const { return m_regNumbers[i]; }
+    int modelIndex(size_t i) const { return m_modelIndex[i]; }
+    const QString& modelName(size_t i) const { return m_modelNames[m_modelIndex[i]]; }
+    double hoursTotal(size_t i) const { return m_hoursTotal[i]; }
+    double hoursNextService(size_t i) const { return m_hoursNextService[i]; }
+    double hoursRemaining(size_t i) const { return m_hoursNextService[i] - m_hoursTotal[i]; }
+    int criticalDefects(size_t i) const { return m_criticalDefects[i]; }
+    int minorDefects(size_t i) const { return m_minorDefects[i]; }
+    quint16 status(size_t i) const { return m_status[i]; }
+    int daysToService(size_t i) const { return m_daysToService[i]; }
+    float dailyHours(size_t i) const { return m_dailyHours[i]; }
+
+    int modelCount() const { return (int)m_modelNames.size(); }
+    const QString& modelNameAt(int modelIndex) const { return m_modelNames[modelIndex]; }
+    const QUuid& modelIdAt(int modelIndex) const { return m_modelIds[modelIndex]; }
+
+private:
+    int internModel(const QUuid& modelId, const QString& name);
+
+    std::vector<QUuid> m_ids;
+    std::vector<QString> m_regNumbers;
+    std::vector<qint32> m_modelIndex;
+    std::vector<double> m_hoursTotal;
+    std::vector<double> m_hoursNextService;
+    std::vector<qint32> m_criticalDefects;
+    std::vector<qint32> m_minorDefects;
+    std::vector<quint16> m_status;
+    std::vector<qint32> m_daysToService;
+    std::vector<float> m_dailyHours;
+
+    std::vector<QUuid> m_modelIds;
+    std::vector<QString> m_modelNames;
+    QHash<QUuid, int> m_modelLookup;
+    QHash<QUuid, int> m_rowById;
+};
+
+#endif // FLEETSTORE_H
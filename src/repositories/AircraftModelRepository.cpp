@@ -1,5 +1,8 @@
 #include "src/repositories/AircraftModelRepository.h"
+#include "src/services/Trace.h"
 #include "src/db/DatabaseManager.h"
+#include "src/db/SqlQuery.h"
+#include "src/services/CgEnvelope.h"
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QVariant>
@@ -9,11 +12,12 @@ AircraftModelRepository::AircraftModelRepository() {
 }
 
 std::vector<AircraftModel> AircraftModelRepository::getAll() {
+    TRACE_FUNCTION("repository");
     std::vector<AircraftModel> list;
     QSqlDatabase db = DatabaseManager::instance().getDatabase();
 
     // Сортируем по имени для удобства в выпадающих списках
-    QSqlQuery query(db);
+    SqlQuery query(db);
     query.prepare("SELECT * FROM aircraft_models ORDER BY name");
 
     if (query.exec()) {
@@ -27,8 +31,9 @@ std::vector<AircraftModel> AircraftModelRepository::getAll() {
 }
 
 AircraftModel AircraftModelRepository::getById(QUuid id) {
+    TRACE_FUNCTION("repository");
     QSqlDatabase db = DatabaseManager::instance().getDatabase();
-    QSqlQuery query(db);
+    SqlQuery query(db);
     query.prepare("SELECT * FROM aircraft_models WHERE id = :id");
     query.bindValue(":id", id);
 
@@ -39,11 +44,18 @@ AircraftModel AircraftModelRepository::getById(QUuid id) {
 }
 
 bool AircraftModelRepository::create(const AircraftModel& model) {
+    TRACE_FUNCTION("repository");
+    // Ограничения центровки обязательны: без конверта и профиля расчет загрузки не к чему привязать
+    if (model.cgEnvelopeJson.isEmpty() && model.cgProfile.isEmpty()) {
+        qDebug() << "ModelRepo: model" << model.name << "has neither cg_envelope_json nor cg_profile. Rejected.";
+        return false;
+    }
+
     QSqlDatabase db = DatabaseManager::instance().getDatabase();
-    QSqlQuery query(db);
+    SqlQuery query(db);
 
     // Проверяем, существует ли уже модель с таким названием
-    QSqlQuery checkQuery(db);
+    SqlQuery checkQuery(db);
     checkQuery.prepare("SELECT COUNT(*) FROM aircraft_models WHERE name = :name");
     checkQuery.bindValue(":name", model.name);
 
@@ -56,8 +68,8 @@ bool AircraftModelRepository::create(const AircraftModel& model) {
     }
 
     query.prepare("INSERT INTO aircraft_models "
-                  "(id, name, max_takeoff_weight, empty_weight, fuel_capacity, fuel_consumption) "
-                  "VALUES (:id, :name, :mtow, :ew, :cap, :cons)");
+                  "(id, name, max_takeoff_weight, empty_weight, fuel_capacity, fuel_consumption, cg_envelope_json, cg_profile) "
+                  "VALUES (:id, :name, :mtow, :ew, :cap, :cons, :envelope, :profile)");
 
     // Генерируем ID, если его нет
     QUuid newId = model.id.isNull() ? QUuid::createUuid() : model.id;
@@ -68,6 +80,11 @@ bool AircraftModelRepository::create(const AircraftModel& model) {
     query.bindValue(":ew", model.emptyWeight);
     query.bindValue(":cap", model.fuelCapacity);
     query.bindValue(":cons", model.fuelConsumption);
+    // Пустой конверт пишем как NULL, иначе передаем JSON строкой
+    query.bindValue(":envelope", model.cgEnvelopeJson.isEmpty()
+                                     ? QVariant(QVariant::String)
+                                     : QVariant(QString::fromUtf8(model.cgEnvelopeJson)));
+    query.bindValue(":profile", model.cgProfile.isEmpty() ? QVariant(QVariant::String) : QVariant(model.cgProfile));
 
     if (!query.exec()) {
         qDebug() << "ModelRepo error (create):" << query.lastError().text();
@@ -84,12 +101,18 @@ AircraftModel AircraftModelRepository::mapToEntity(const QSqlQuery& query) {
     m.emptyWeight = query.value("empty_weight").toDouble();
     m.fuelCapacity = query.value("fuel_capacity").toDouble();
     m.fuelConsumption = query.value("fuel_consumption").toDouble();
+    m.cgEnvelopeJson = query.value("cg_envelope_json").toByteArray();
+    m.cgProfile = query.value("cg_profile").toString();
+
+    // Конверт собирается один раз на модель и дальше берется из кэша
+    m.envelope = CgEnvelope::forModel(m);
     return m;
 }
 
 void AircraftModelRepository::deleteAll() {
+    TRACE_FUNCTION("repository");
     QSqlDatabase db = DatabaseManager::instance().getDatabase();
-    QSqlQuery query(db);
+    SqlQuery query(db);
     if (!query.exec("DELETE FROM aircraft_models")) {
         qDebug() << "ModelRepo error (deleteAll):" << query.lastError().text();
     }
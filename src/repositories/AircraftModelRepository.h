@@ -13,7 +13,7 @@ public:
     std::vector<AircraftModel> getAll() override;
     AircraftModel getById(QUuid id) override;
 
-    // Метод создания нового типа ВС
+    // Метод создания нового типа ВС (нужен cgEnvelopeJson или cgProfile, иначе false)
     bool create(const AircraftModel& model);
 
     void deleteAll();
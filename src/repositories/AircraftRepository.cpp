@@ -1,20 +1,24 @@
 #include "src/repositories/AircraftRepository.h"
+#include "src/services/Trace.h"
 #include "src/db/DatabaseManager.h"
+#include "src/db/SqlQuery.h"
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QVariant>
+#include <QStringList>
 #include <QDebug>
 
 AircraftRepository::AircraftRepository() {
 }
 
 std::vector<Aircraft> AircraftRepository::getAll() {
+    TRACE_FUNCTION("repository");
     std::vector<Aircraft> list;
 
     QSqlDatabase db = DatabaseManager::instance().getDatabase();
 
     // Используем LEFT JOIN, чтобы получить данные о модели самолета
-    QSqlQuery query(db);
+    SqlQuery query(db);
     query.prepare(
         "SELECT a.id, a.model_id, a.reg_number, a.engine_hours_total, a.engine_hours_next_service, "
         "       m.name as model_name, m.fuel_capacity "
@@ -35,8 +39,9 @@ std::vector<Aircraft> AircraftRepository::getAll() {
 }
 
 Aircraft AircraftRepository::getById(QUuid id) {
+    TRACE_FUNCTION("repository");
     QSqlDatabase db = DatabaseManager::instance().getDatabase();
-    QSqlQuery query(db);
+    SqlQuery query(db);
 
     query.prepare(
         "SELECT a.id, a.model_id, a.reg_number, a.engine_hours_total, a.engine_hours_next_service, "
@@ -56,8 +61,9 @@ Aircraft AircraftRepository::getById(QUuid id) {
 }
 
 Aircraft AircraftRepository::getByRegNumber(const QString& regNumber) {
+    TRACE_FUNCTION("repository");
     QSqlDatabase db = DatabaseManager::instance().getDatabase();
-    QSqlQuery query(db);
+    SqlQuery query(db);
 
     query.prepare(
         "SELECT a.id, a.model_id, a.reg_number, a.engine_hours_total, a.engine_hours_next_service, "
@@ -78,8 +84,9 @@ Aircraft AircraftRepository::getByRegNumber(const QString& regNumber) {
 }
 
 bool AircraftRepository::updateNextService(QUuid id, double nextServiceHours) {
+    TRACE_FUNCTION("repository");
     QSqlDatabase db = DatabaseManager::instance().getDatabase();
-    QSqlQuery query(db);
+    SqlQuery query(db);
     query.prepare("UPDATE aircrafts SET engine_hours_next_service = :next WHERE id = :id");
     query.bindValue(":next", nextServiceHours);
     query.bindValue(":id", id);
@@ -87,8 +94,9 @@ bool AircraftRepository::updateNextService(QUuid id, double nextServiceHours) {
 }
 
 bool AircraftRepository::updateEngineHours(QUuid id, double hoursFlown) {
+    TRACE_FUNCTION("repository");
     QSqlDatabase db = DatabaseManager::instance().getDatabase();
-    QSqlQuery query(db);
+    SqlQuery query(db);
 
     // Увеличиваем общий налет на hoursFlown
     query.prepare(
@@ -107,9 +115,55 @@ bool AircraftRepository::updateEngineHours(QUuid id, double hoursFlown) {
     return true;
 }
 
+bool AircraftRepository::addEngineHoursBatch(const QHash<QUuid, double>& hoursById, QSet<QUuid>& updatedIds) {
+    TRACE_FUNCTION("repository");
+    if (hoursById.isEmpty()) return true;
+
+    QSqlDatabase db = DatabaseManager::instance().getDatabase();
+    SqlQuery query(db);
+
+    // Ограничиваем число параметров в одном запросе
+    const int rowsPerStatement = 500;
+    QList<QUuid> ids = hoursById.keys();
+    const int total = (int)ids.size();
+
+    for (int start = 0; start < total; start += rowsPerStatement) {
+        int rows = qMin(rowsPerStatement, total - start);
+
+        QStringList values;
+        values.reserve(rows);
+        for (int i = 0; i < rows; ++i) {
+            values << "(CAST(? AS UUID), CAST(? AS DOUBLE PRECISION))";
+        }
+
+        query.prepare(
+            "UPDATE aircrafts a "
+            "SET engine_hours_total = a.engine_hours_total + v.hours "
+            "FROM (VALUES " + values.join(", ") + ") AS v(id, hours) "
+            "WHERE a.id = v.id "
+            "RETURNING a.id"
+        );
+        for (int i = 0; i < rows; ++i) {
+            const QUuid& id = ids[start + i];
+            query.addBindValue(id.toString());
+            query.addBindValue(hoursById.value(id));
+        }
+
+        if (!query.exec()) {
+            qDebug() << "AircraftRepo error (addEngineHoursBatch):" << query.lastError().text();
+            return false;
+        }
+        while (query.next()) {
+            updatedIds.insert(query.value(0).toUuid());
+        }
+    }
+    return true;
+}
+
 bool AircraftRepository::create(const Aircraft& aircraft) {
+    TRACE_FUNCTION("repository");
     QSqlDatabase db = DatabaseManager::instance().getDatabase();
-    QSqlQuery query(db);
+    SqlQuery query(db);
 
     query.prepare(
         "INSERT INTO aircrafts (id, model_id, reg_number, engine_hours_total, engine_hours_next_service) "
@@ -132,10 +186,50 @@ bool AircraftRepository::create(const Aircraft& aircraft) {
     return true;
 }
 
+bool AircraftRepository::createBatch(const std::vector<Aircraft>& list) {
+    TRACE_FUNCTION("repository");
+    if (list.empty()) return true;
+
+    QSqlDatabase db = DatabaseManager::instance().getDatabase();
+    SqlQuery query(db);
+    query.prepare(
+        "INSERT INTO aircrafts (id, model_id, reg_number, engine_hours_total, engine_hours_next_service) "
+        "SELECT * FROM unnest(CAST(:ids AS UUID[]), CAST(:models AS UUID[]), CAST(:regs AS VARCHAR[]), "
+        "                     CAST(:totals AS DOUBLE PRECISION[]), CAST(:next AS DOUBLE PRECISION[]))"
+    );
+
+    const size_t rowsPerStatement = 10000;
+    for (size_t start = 0; start < list.size(); start += rowsPerStatement) {
+        size_t rows = qMin(rowsPerStatement, list.size() - start);
+
+        QStringList ids, models, regs, totals, next;
+        for (size_t i = start; i < start + rows; ++i) {
+            const Aircraft& a = list[i];
+            ids << a.id.toString();
+            models << a.modelId.toString();
+            regs << a.regNumber;
+            totals << QString::number(a.engineHoursTotal, 'g', 17);
+            next << QString::number(a.engineHoursNextService, 'g', 17);
+        }
+        query.bindValue(":ids", SqlQuery::arrayLiteral(ids));
+        query.bindValue(":models", SqlQuery::arrayLiteral(models));
+        query.bindValue(":regs", SqlQuery::arrayLiteral(regs));
+        query.bindValue(":totals", SqlQuery::arrayLiteral(totals));
+        query.bindValue(":next", SqlQuery::arrayLiteral(next));
+
+        if (!query.exec()) {
+            qDebug() << "AircraftRepo error (createBatch):" << query.lastError().text();
+            return false;
+        }
+    }
+    return true;
+}
+
 // Удаление
 bool AircraftRepository::deleteById(QUuid id) {
+    TRACE_FUNCTION("repository");
     QSqlDatabase db = DatabaseManager::instance().getDatabase();
-    QSqlQuery query(db);
+    SqlQuery query(db);
     query.prepare("DELETE FROM aircrafts WHERE id = :id");
     query.bindValue(":id", id);
     return query.exec();
@@ -157,8 +251,9 @@ Aircraft AircraftRepository::mapToEntity(const QSqlQuery& query) {
 }
 
 void AircraftRepository::deleteAll() {
+    TRACE_FUNCTION("repository");
     QSqlDatabase db = DatabaseManager::instance().getDatabase();
-    QSqlQuery query(db);
+    SqlQuery query(db);
     if (!query.exec("DELETE FROM aircrafts")) {
         qDebug() << "AircraftRepo error (deleteAll):" << query.lastError().text();
     }
@@ -4,6 +4,8 @@
 #include "src/repositories/IRepository.h"
 #include "src/models/Entities.h"
 #include <QSqlDatabase>
+#include <QHash>
+#include <QSet>
 
 class AircraftRepository : public IRepository<Aircraft> {
 public:
@@ -19,12 +21,21 @@ public:
     // Обновление налета двигателя
     bool updateEngineHours(QUuid id, double hoursFlown);
 
+    // Пакетное обновление налета одним UPDATE ... FROM (VALUES ...).
+    // hoursById - прибавка по каждому борту. В updatedIds попадают борта,
+    // которые реально нашлись в таблице. false - ошибка запроса
+    bool addEngineHoursBatch(const QHash<QUuid, double>& hoursById, QSet<QUuid>& updatedIds);
+
     // Обновляет отметку следующего ТО
     bool updateNextService(QUuid id, double nextServiceHours);
 
     // Метод для создания самолета
     bool create(const Aircraft& aircraft);
 
+    // Массовая вставка: колонки передаются массивами в INSERT ... SELECT FROM unnest,
+    // один запрос на блок строк. Пустые id не допускаются. Транзакцию открывает вызывающий
+    bool createBatch(const std::vector<Aircraft>& list);
+
     bool deleteById(QUuid id);
 
     void deleteAll();
@@ -1,5 +1,7 @@
 #include "src/repositories/DefectRepository.h"
+#include "src/services/Trace.h"
 #include "src/db/DatabaseManager.h"
+#include "src/db/SqlQuery.h"
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QVariant>
@@ -14,10 +16,11 @@ DefectRepository::DefectRepository() {
 // Справочник
 
 std::vector<DefectType> DefectRepository::getAllDefectTypes() {
+    TRACE_FUNCTION("repository");
     ensureDefaultDefectsExist();
     std::vector<DefectType> list;
     QSqlDatabase db = DatabaseManager::instance().getDatabase();
-    QSqlQuery query("SELECT id, description, severity FROM defect_types ORDER BY description", db);
+    SqlQuery query("SELECT id, description, severity FROM defect_types ORDER BY description", db);
 
     while (query.next()) {
         DefectType dt;
@@ -30,13 +33,14 @@ std::vector<DefectType> DefectRepository::getAllDefectTypes() {
 }
 
 void DefectRepository::ensureDefaultDefectsExist() {
+    TRACE_FUNCTION("repository");
     QSqlDatabase db = DatabaseManager::instance().getDatabase();
 
     if (!db.isOpen()) {
         return; // Если база закрыта, просто выходим, не пытаясь писать
     }
 
-    QSqlQuery checkQuery("SELECT COUNT(*) FROM defect_types", db);
+    SqlQuery checkQuery("SELECT COUNT(*) FROM defect_types", db);
 
     if (checkQuery.next() && checkQuery.value(0).toInt() > 0) {
         return; // База уже заполнена
@@ -75,7 +79,7 @@ void DefectRepository::ensureDefaultDefectsExist() {
         {"ПРОЧЕЕ (Требует проверки)", "CRITICAL"}
     };
 
-    QSqlQuery insertQuery(db);
+    SqlQuery insertQuery(db);
     insertQuery.prepare("INSERT INTO defect_types (id, description, severity) VALUES (:id, :desc, :sev)");
 
     for (const auto& item : defaults) {
@@ -91,8 +95,9 @@ void DefectRepository::ensureDefaultDefectsExist() {
 // Активные дефекты
 
 bool DefectRepository::addActiveDefect(QUuid aircraftId, QUuid defectTypeId) {
+    TRACE_FUNCTION("repository");
     QSqlDatabase db = DatabaseManager::instance().getDatabase();
-    QSqlQuery query(db);
+    SqlQuery query(db);
     query.prepare("INSERT INTO active_defects (id, aircraft_id, defect_type_id, created_at) VALUES (:id, :aid, :dtid, :date)");
 
     query.bindValue(":id", QUuid::createUuid());
@@ -107,9 +112,47 @@ bool DefectRepository::addActiveDefect(QUuid aircraftId, QUuid defectTypeId) {
     return true;
 }
 
+bool DefectRepository::addActiveBatch(const std::vector<ActiveDefect>& list) {
+    TRACE_FUNCTION("repository");
+    if (list.empty()) return true;
+
+    QSqlDatabase db = DatabaseManager::instance().getDatabase();
+    SqlQuery query(db);
+    query.prepare(
+        "INSERT INTO active_defects (id, aircraft_id, defect_type_id, created_at) "
+        "SELECT * FROM unnest(CAST(:ids AS UUID[]), CAST(:aircraft AS UUID[]), "
+        "                     CAST(:types AS UUID[]), CAST(:created AS TIMESTAMP[]))"
+    );
+
+    const size_t rowsPerStatement = 10000;
+    for (size_t start = 0; start < list.size(); start += rowsPerStatement) {
+        size_t rows = qMin(rowsPerStatement, list.size() - start);
+
+        QStringList ids, aircraft, types, created;
+        for (size_t i = start; i < start + rows; ++i) {
+            const ActiveDefect& d = list[i];
+            ids << d.id.toString();
+            aircraft << d.aircraftId.toString();
+            types << d.defectTypeId.toString();
+            created << d.createdAt.toString(Qt::ISODate);
+        }
+        query.bindValue(":ids", SqlQuery::arrayLiteral(ids));
+        query.bindValue(":aircraft", SqlQuery::arrayLiteral(aircraft));
+        query.bindValue(":types", SqlQuery::arrayLiteral(types));
+        query.bindValue(":created", SqlQuery::arrayLiteral(created));
+
+        if (!query.exec()) {
+            qDebug() << "DefectRepo error (addActiveBatch):" << query.lastError().text();
+            return false;
+        }
+    }
+    return true;
+}
+
 bool DefectRepository::removeActiveDefect(QUuid defectId) {
+    TRACE_FUNCTION("repository");
     QSqlDatabase db = DatabaseManager::instance().getDatabase();
-    QSqlQuery query(db);
+    SqlQuery query(db);
     query.prepare("DELETE FROM active_defects WHERE id = :id");
     query.bindValue(":id", defectId);
 
@@ -117,9 +160,10 @@ bool DefectRepository::removeActiveDefect(QUuid defectId) {
 }
 
 std::vector<ActiveDefect> DefectRepository::getByAircraftId(QUuid aircraftId) {
+    TRACE_FUNCTION("repository");
     std::vector<ActiveDefect> list;
     QSqlDatabase db = DatabaseManager::instance().getDatabase();
-    QSqlQuery query(db);
+    SqlQuery query(db);
 
     // JOIN нужен, чтобы получить название и критичность дефекта одной строкой
     query.prepare(
@@ -148,8 +192,9 @@ std::vector<ActiveDefect> DefectRepository::getByAircraftId(QUuid aircraftId) {
 }
 
 int DefectRepository::countMinorDefects(QUuid aircraftId) {
+    TRACE_FUNCTION("repository");
     QSqlDatabase db = DatabaseManager::instance().getDatabase();
-    QSqlQuery query(db);
+    SqlQuery query(db);
 
     // Считаем только те дефекты, у которых severity = 'MINOR'
     query.prepare(
@@ -167,8 +212,9 @@ int DefectRepository::countMinorDefects(QUuid aircraftId) {
 }
 
 bool DefectRepository::hasCriticalDefects(QUuid aircraftId) {
+    TRACE_FUNCTION("repository");
     QSqlDatabase db = DatabaseManager::instance().getDatabase();
-    QSqlQuery query(db);
+    SqlQuery query(db);
 
     // Ищем хотя бы один CRITICAL
     query.prepare(
@@ -185,17 +231,75 @@ bool DefectRepository::hasCriticalDefects(QUuid aircraftId) {
     return false;
 }
 
+DefectCounts DefectRepository::getDefectCounts(QUuid aircraftId) {
+    TRACE_FUNCTION("repository");
+    DefectCounts counts;
+    QSqlDatabase db = DatabaseManager::instance().getDatabase();
+    SqlQuery query(db);
+
+    query.prepare(
+        "SELECT COUNT(*) FILTER (WHERE dt.severity = 'CRITICAL') AS critical_count, "
+        "       COUNT(*) FILTER (WHERE dt.severity = 'MINOR') AS minor_count "
+        "FROM active_defects ad "
+        "JOIN defect_types dt ON ad.defect_type_id = dt.id "
+        "WHERE ad.aircraft_id = :id"
+    );
+    query.bindValue(":id", aircraftId);
+
+    if (!query.exec()) {
+        qDebug() << "DefectRepo error (getDefectCounts):" << query.lastError().text();
+        return counts;
+    }
+
+    if (query.next()) {
+        counts.critical = query.value("critical_count").toInt();
+        counts.minor = query.value("minor_count").toInt();
+    }
+    return counts;
+}
+
+QHash<QUuid, DefectCounts> DefectRepository::getDefectCountsByAircraft() {
+    TRACE_FUNCTION("repository");
+    QHash<QUuid, DefectCounts> result;
+    QSqlDatabase db = DatabaseManager::instance().getDatabase();
+    SqlQuery query(db);
+
+    query.prepare(
+        "SELECT ad.aircraft_id, "
+        "       COUNT(*) FILTER (WHERE dt.severity = 'CRITICAL') AS critical_count, "
+        "       COUNT(*) FILTER (WHERE dt.severity = 'MINOR') AS minor_count "
+        "FROM active_defects ad "
+        "JOIN defect_types dt ON ad.defect_type_id = dt.id "
+        "GROUP BY ad.aircraft_id"
+    );
+
+    if (!query.exec()) {
+        qDebug() << "DefectRepo error (getDefectCountsByAircraft):" << query.lastError().text();
+        return result;
+    }
+
+    while (query.next()) {
+        DefectCounts counts;
+        counts.critical = query.value("critical_count").toInt();
+        counts.minor = query.value("minor_count").toInt();
+        result.insert(query.value("aircraft_id").toUuid(), counts);
+    }
+    return result;
+}
+
 void DefectRepository::deleteAllActive() {
+    TRACE_FUNCTION("repository");
     QSqlDatabase db = DatabaseManager::instance().getDatabase();
-    QSqlQuery query(db);
+    SqlQuery query(db);
     if (!query.exec("DELETE FROM active_defects")) {
         qDebug() << "DefectRepo error (deleteAllActive):" << query.lastError().text();
     }
 }
 
 void DefectRepository::deleteActiveByAircraftId(QUuid aircraftId) {
+    TRACE_FUNCTION("repository");
     QSqlDatabase db = DatabaseManager::instance().getDatabase();
-    QSqlQuery query(db);
+    SqlQuery query(db);
     query.prepare("DELETE FROM active_defects WHERE aircraft_id = :id");
     query.bindValue(":id", aircraftId);
     if (!query.exec()) {
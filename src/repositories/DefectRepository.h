@@ -4,6 +4,7 @@
 #include "src/models/Entities.h"
 #include <vector>
 #include <QUuid>
+#include <QHash>
 
 class DefectRepository {
 public:
@@ -18,6 +19,10 @@ public:
     // Добавить новую поломку на самолет
     bool addActiveDefect(QUuid aircraftId, QUuid defectTypeId);
 
+    // Массовая вставка через unnest (id, aircraftId, defectTypeId, createdAt;
+    // остальные поля не пишутся). Транзакцию открывает вызывающий
+    bool addActiveBatch(const std::vector<ActiveDefect>& list);
+
     // Удалить поломку
     bool removeActiveDefect(QUuid defectId);
 
@@ -30,6 +35,12 @@ public:
     // Проверка наличия хотя бы одного критического дефекта
     bool hasCriticalDefects(QUuid aircraftId);
 
+    // Сводка дефектов одного самолета
+    DefectCounts getDefectCounts(QUuid aircraftId);
+
+    // Сводка дефектов по всем самолетам одним запросом (борта без дефектов не попадают)
+    QHash<QUuid, DefectCounts> getDefectCountsByAircraft();
+
     void deleteAllActive();
     void deleteActiveByAircraftId(QUuid aircraftId);
 };
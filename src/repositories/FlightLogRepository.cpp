@@ -0,0 +1,92 @@
+#include "src/repositories/FlightLogRepository.h"
+#include "src/services/Trace.h"
+#include "src/db/DatabaseManager.h"
+#include "src/db/SqlQuery.h"
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QVariant>
+#include <QStringList>
+#include <QDebug>
+
+FlightLogRepository::FlightLogRepository() {
+}
+
+bool FlightLogRepository::add(QUuid aircraftId, int flightTimeMinutes) {
+    TRACE_FUNCTION("repository");
+    QSqlDatabase db = DatabaseManager::instance().getDatabase();
+    SqlQuery query(db);
+
+    query.prepare("INSERT INTO flight_log (id, aircraft_id, minutes) VALUES (:id, :aircraft, :minutes)");
+    query.bindValue(":id", QUuid::createUuid());
+    query.bindValue(":aircraft", aircraftId);
+    query.bindValue(":minutes", flightTimeMinutes);
+
+    if (!query.exec()) {
+        qDebug() << "FlightLogRepo error (add):" << query.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+bool FlightLogRepository::addBatch(const std::vector<FlightCompletion>& flights) {
+    TRACE_FUNCTION("repository");
+    if (flights.empty()) return true;
+
+    QSqlDatabase db = DatabaseManager::instance().getDatabase();
+    SqlQuery query(db);
+
+    const size_t rowsPerStatement = 300;
+    for (size_t start = 0; start < flights.size(); start += rowsPerStatement) {
+        size_t rows = qMin(rowsPerStatement, flights.size() - start);
+
+        QStringList values;
+        values.reserve((int)rows);
+        for (size_t i = 0; i < rows; ++i) {
+            values << "(CAST(? AS UUID), CAST(? AS UUID), CAST(? AS INTEGER))";
+        }
+
+        query.prepare("INSERT INTO flight_log (id, aircraft_id, minutes) VALUES " + values.join(", "));
+        for (size_t i = 0; i < rows; ++i) {
+            const FlightCompletion& f = flights[start + i];
+            query.addBindValue(QUuid::createUuid().toString());
+            query.addBindValue(f.aircraftId.toString());
+            query.addBindValue(f.flightTimeMinutes);
+        }
+
+        if (!query.exec()) {
+            qDebug() << "FlightLogRepo error (addBatch):" << query.lastError().text();
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<DailyFlightHours> FlightLogRepository::getDailyTotals() {
+    TRACE_FUNCTION("repository");
+    std::vector<DailyFlightHours> list;
+    QSqlDatabase db = DatabaseManager::instance().getDatabase();
+    SqlQuery query(db);
+    query.setForwardOnly(true);
+
+    // Агрегация на стороне БД: одна строка на борт и день
+    query.prepare(
+        "SELECT aircraft_id, CAST(flown_at AS DATE) AS day, SUM(minutes) / 60.0 AS hours "
+        "FROM flight_log "
+        "GROUP BY aircraft_id, CAST(flown_at AS DATE) "
+        "ORDER BY aircraft_id, day"
+    );
+
+    if (!query.exec()) {
+        qDebug() << "FlightLogRepo error (getDailyTotals):" << query.lastError().text();
+        return list;
+    }
+
+    while (query.next()) {
+        DailyFlightHours d;
+        d.aircraftId = query.value("aircraft_id").toUuid();
+        d.day = query.value("day").toDate();
+        d.hours = query.value("hours").toDouble();
+        list.push_back(d);
+    }
+    return list;
+}
@@ -0,0 +1,22 @@
+#ifndef FLIGHTLOGREPOSITORY_H
+#define FLIGHTLOGREPOSITORY_H
+
+#include "src/models/Entities.h"
+#include <vector>
+
+// Журнал выполненных полетов (таблица flight_log)
+class FlightLogRepository {
+public:
+    FlightLogRepository();
+
+    // Запись о выполненном полете (время - текущее)
+    bool add(QUuid aircraftId, int flightTimeMinutes);
+
+    // Записи о нескольких полетах одним INSERT
+    bool addBatch(const std::vector<FlightCompletion>& flights);
+
+    // Налет по дням для всего флота, отсортированный по борту и дате
+    std::vector<DailyFlightHours> getDailyTotals();
+};
+
+#endif // FLIGHTLOGREPOSITORY_H
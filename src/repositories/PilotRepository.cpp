@@ -1,5 +1,7 @@
 #include "src/repositories/PilotRepository.h"
+#include "src/services/Trace.h"
 #include "src/db/DatabaseManager.h"
+#include "src/db/SqlQuery.h"
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QVariant>
@@ -11,10 +13,11 @@ PilotRepository::PilotRepository() {
 }
 
 std::vector<Pilot> PilotRepository::getAll() {
+    TRACE_FUNCTION("repository");
     std::vector<Pilot> list;
     QSqlDatabase db = DatabaseManager::instance().getDatabase();
 
-    QSqlQuery query(db);
+    SqlQuery query(db);
     query.prepare("SELECT id, full_name, license_expiry_date, medical_expiry_date, allowed_models_json FROM pilots");
 
     if (!query.exec()) {
@@ -29,8 +32,9 @@ std::vector<Pilot> PilotRepository::getAll() {
 }
 
 Pilot PilotRepository::getById(QUuid id) {
+    TRACE_FUNCTION("repository");
     QSqlDatabase db = DatabaseManager::instance().getDatabase();
-    QSqlQuery query(db);
+    SqlQuery query(db);
 
     query.prepare("SELECT * FROM pilots WHERE id = :id");
     query.bindValue(":id", id);
@@ -42,16 +46,11 @@ Pilot PilotRepository::getById(QUuid id) {
 }
 
 bool PilotRepository::create(const Pilot& pilot) {
+    TRACE_FUNCTION("repository");
     QSqlDatabase db = DatabaseManager::instance().getDatabase();
-    QSqlQuery query(db);
+    SqlQuery query(db);
 
-    // Преобразуем список UUID в JSON массив для сохранения в PostgreSQL
-    QJsonArray jsonArray;
-    for (const QUuid& modelId : pilot.allowedModels) {
-        jsonArray.append(modelId.toString());
-    }
-    QJsonDocument doc(jsonArray);
-    QString jsonString = doc.toJson(QJsonDocument::Compact);
+    QString jsonString = allowedModelsJson(pilot.allowedModels);
 
     query.prepare(
         "INSERT INTO pilots (id, full_name, license_expiry_date, medical_expiry_date, allowed_models_json) "
@@ -74,20 +73,62 @@ bool PilotRepository::create(const Pilot& pilot) {
     return true;
 }
 
+bool PilotRepository::createBatch(const std::vector<Pilot>& list) {
+    TRACE_FUNCTION("repository");
+    if (list.empty()) return true;
+
+    QSqlDatabase db = DatabaseManager::instance().getDatabase();
+    SqlQuery query(db);
+    query.prepare(
+        "INSERT INTO pilots (id, full_name, license_expiry_date, medical_expiry_date, allowed_models_json) "
+        "SELECT id, name, lic, med, CAST(models AS JSONB) "
+        "FROM unnest(CAST(:ids AS UUID[]), CAST(:names AS VARCHAR[]), CAST(:lic AS DATE[]), "
+        "            CAST(:med AS DATE[]), CAST(:models AS TEXT[])) AS t(id, name, lic, med, models)"
+    );
+
+    const size_t rowsPerStatement = 10000;
+    for (size_t start = 0; start < list.size(); start += rowsPerStatement) {
+        size_t rows = qMin(rowsPerStatement, list.size() - start);
+
+        QStringList ids, names, lic, med, models;
+        for (size_t i = start; i < start + rows; ++i) {
+            const Pilot& p = list[i];
+            ids << p.id.toString();
+            names << p.fullName;
+            lic << p.licenseExpiryDate.toString(Qt::ISODate);
+            med << p.medicalExpiryDate.toString(Qt::ISODate);
+            models << allowedModelsJson(p.allowedModels);
+        }
+        query.bindValue(":ids", SqlQuery::arrayLiteral(ids));
+        query.bindValue(":names", SqlQuery::arrayLiteral(names));
+        query.bindValue(":lic", SqlQuery::arrayLiteral(lic));
+        query.bindValue(":med", SqlQuery::arrayLiteral(med));
+        query.bindValue(":models", SqlQuery::arrayLiteral(models));
+
+        if (!query.exec()) {
+            qDebug() << "PilotRepo error (createBatch):" << query.lastError().text();
+            return false;
+        }
+    }
+    return true;
+}
+
 // Удаление
 bool PilotRepository::deleteById(QUuid id) {
+    TRACE_FUNCTION("repository");
     QSqlDatabase db = DatabaseManager::instance().getDatabase();
-    QSqlQuery query(db);
+    SqlQuery query(db);
     query.prepare("DELETE FROM pilots WHERE id = :id");
     query.bindValue(":id", id);
     return query.exec();
 }
 
 std::vector<Pilot> PilotRepository::findByName(const QString& namePart) {
+    TRACE_FUNCTION("repository");
     std::vector<Pilot> list;
     QSqlDatabase db = DatabaseManager::instance().getDatabase();
 
-    QSqlQuery query(db);
+    SqlQuery query(db);
     // Ищем регистронезависимо (ILIKE - фишка Postgres)
     query.prepare("SELECT * FROM pilots WHERE full_name ILIKE :name");
     query.bindValue(":name", "%" + namePart + "%");
@@ -100,6 +141,61 @@ std::vector<Pilot> PilotRepository::findByName(const QString& namePart) {
     return list;
 }
 
+std::vector<PilotListEntry> PilotRepository::getPickerPage(const QUuid& modelId, const QString& namePart,
+                                                           const QDate& today, const PilotListEntry& after,
+                                                           int limit) {
+    TRACE_FUNCTION("repository");
+    std::vector<PilotListEntry> list;
+    QSqlDatabase db = DatabaseManager::instance().getDatabase();
+
+    // Допуски хранятся строками QUuid::toString() (в фигурных скобках),
+    // поэтому ищем ровно такую строку через @> (оператор ? конфликтует с плейсхолдерами)
+    SqlQuery query(db);
+    query.prepare(
+        "SELECT id, full_name, fitness FROM ("
+        "   SELECT id, full_name, "
+        "          CASE WHEN allowed_models_json @> jsonb_build_array(CAST(:model AS TEXT)) THEN "
+        "               CASE WHEN license_expiry_date >= :lic_today AND medical_expiry_date >= :med_today "
+        "                    THEN 0 ELSE 1 END "
+        "          ELSE 2 END AS fitness "
+        "   FROM pilots "
+        "   WHERE full_name ILIKE :name"
+        ") p "
+        "WHERE (fitness, full_name, id) > (:after_fitness, :after_name, CAST(:after_id AS UUID)) "
+        "ORDER BY fitness, full_name, id "
+        "LIMIT :limit"
+    );
+
+    // Символы шаблона LIKE во введенном тексте ищем буквально
+    QString pattern = namePart;
+    pattern.replace("\\", "\\\\").replace("%", "\\%").replace("_", "\\_");
+
+    const bool first = after.id.isNull();
+    query.bindValue(":model", modelId.toString());
+    query.bindValue(":lic_today", today);
+    query.bindValue(":med_today", today);
+    query.bindValue(":name", "%" + pattern + "%");
+    query.bindValue(":after_fitness", first ? -1 : int(after.fitness));
+    query.bindValue(":after_name", after.fullName);
+    query.bindValue(":after_id", after.id.toString(QUuid::WithoutBraces));
+    query.bindValue(":limit", limit);
+
+    if (!query.exec()) {
+        qDebug() << "PilotRepo error (getPickerPage):" << query.lastError().text();
+        return list;
+    }
+
+    list.reserve(limit);
+    while (query.next()) {
+        PilotListEntry entry;
+        entry.id = query.value(0).toUuid();
+        entry.fullName = query.value(1).toString();
+        entry.fitness = PilotFitness(query.value(2).toInt());
+        list.push_back(entry);
+    }
+    return list;
+}
+
 Pilot PilotRepository::mapToEntity(const QSqlQuery& query) {
     Pilot p;
     p.id = query.value("id").toUuid();
@@ -107,24 +203,40 @@ Pilot PilotRepository::mapToEntity(const QSqlQuery& query) {
     p.licenseExpiryDate = query.value("license_expiry_date").toDate();
     p.medicalExpiryDate = query.value("medical_expiry_date").toDate();
 
+    p.allowedModels = parseAllowedModels(query.value("allowed_models_json").toByteArray());
+
+    return p;
+}
+
+QString PilotRepository::allowedModelsJson(const QList<QUuid>& models) {
+    // Преобразуем список UUID в JSON массив для сохранения в PostgreSQL
+    QJsonArray jsonArray;
+    for (const QUuid& modelId : models) {
+        jsonArray.append(modelId.toString());
+    }
+    return QString::fromUtf8(QJsonDocument(jsonArray).toJson(QJsonDocument::Compact));
+}
+
+QList<QUuid> PilotRepository::parseAllowedModels(const QByteArray& json) {
     // Парсинг JSON из базы обратно в список C++
-    QByteArray jsonData = query.value("allowed_models_json").toByteArray();
-    QJsonDocument doc = QJsonDocument::fromJson(jsonData);
+    QList<QUuid> models;
+    QJsonDocument doc = QJsonDocument::fromJson(json);
 
     if (doc.isArray()) {
         QJsonArray arr = doc.array();
+        models.reserve(arr.size());
         for (const auto& val : arr) {
             // Извлекаем строку GUID и превращаем в QUuid
-            p.allowedModels.append(QUuid(val.toString()));
+            models.append(QUuid(val.toString()));
         }
     }
-
-    return p;
+    return models;
 }
 
 void PilotRepository::deleteAll() {
+    TRACE_FUNCTION("repository");
     QSqlDatabase db = DatabaseManager::instance().getDatabase();
-    QSqlQuery query(db);
+    SqlQuery query(db);
     if (!query.exec("DELETE FROM pilots")) {
         qDebug() << "PilotRepo error (deleteAll):" << query.lastError().text();
     }
@@ -16,6 +16,9 @@ public:
     // Создание пилота
     bool create(const Pilot& pilot);
 
+    // Массовая вставка через unnest (см. AircraftRepository::createBatch)
+    bool createBatch(const std::vector<Pilot>& list);
+
     bool deleteById(QUuid id);
 
     // Поиск пилота по имени
@@ -23,8 +26,23 @@ public:
 
     void deleteAll();
 
+    // Страница списка выбора для типа modelId: сначала допущенные с действующими
+    // документами, затем просроченные, затем без допуска; внутри - по имени.
+    // Ранг и фильтр по имени считает сервер. Страницы идут по ключу: следующая
+    // начинается после строки after (для первой - пустой PilotListEntry с id = NULL)
+    std::vector<PilotListEntry> getPickerPage(const QUuid& modelId, const QString& namePart,
+                                              const QDate& today, const PilotListEntry& after,
+                                              int limit);
+
+    // Допущенные типы из allowed_models_json (массив строк UUID).
+    // Некорректный JSON дает пустой список
+    static QList<QUuid> parseAllowedModels(const QByteArray& json);
+
 private:
     Pilot mapToEntity(const class QSqlQuery& query);
+
+    // Список UUID в JSON массив для allowed_models_json
+    static QString allowedModelsJson(const QList<QUuid>& models);
 };
 
 #endif // PILOTREPOSITORY_H
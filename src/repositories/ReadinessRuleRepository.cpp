@@ -0,0 +1,85 @@
+#include "src/repositories/ReadinessRuleRepository.h"
+#include "src/services/Trace.h"
+#include "src/db/DatabaseManager.h"
+#include "src/db/SqlQuery.h"
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QVariant>
+#include <QDebug>
+
+namespace {
+
+// Пустой UUID передаем в БД как NULL (значения по умолчанию)
+QVariant modelIdValue(const QUuid& modelId) {
+    return modelId.isNull() ? QVariant(QVariant::String) : QVariant(modelId.toString());
+}
+
+} // namespace
+
+ReadinessRuleRepository::ReadinessRuleRepository() {
+}
+
+std::vector<ReadinessThresholds> ReadinessRuleRepository::getAll() {
+    TRACE_FUNCTION("repository");
+    std::vector<ReadinessThresholds> list;
+    QSqlDatabase db = DatabaseManager::instance().getDatabase();
+    SqlQuery query(db);
+
+    query.prepare("SELECT model_id, service_soon_hours, max_minor_defects, license_warning_days FROM readiness_rules");
+
+    if (!query.exec()) {
+        qDebug() << "RuleRepo error (getAll):" << query.lastError().text();
+        return list;
+    }
+
+    while (query.next()) {
+        ReadinessThresholds t;
+        t.modelId = query.value("model_id").toUuid();
+        t.serviceSoonHours = query.value("service_soon_hours").toDouble();
+        t.maxMinorDefects = query.value("max_minor_defects").toInt();
+        t.licenseWarningDays = query.value("license_warning_days").toInt();
+        list.push_back(t);
+    }
+    return list;
+}
+
+bool ReadinessRuleRepository::save(const ReadinessThresholds& thresholds) {
+    TRACE_FUNCTION("repository");
+    QSqlDatabase db = DatabaseManager::instance().getDatabase();
+    SqlQuery query(db);
+
+    // Одна строка на модель (UNIQUE) и одна по умолчанию (частичный индекс по NULL)
+    QString conflict = thresholds.modelId.isNull()
+        ? "((model_id IS NULL)) WHERE model_id IS NULL"
+        : "(model_id)";
+    query.prepare(
+        "INSERT INTO readiness_rules (id, model_id, service_soon_hours, max_minor_defects, license_warning_days) "
+        "VALUES (:id, CAST(:model AS UUID), :soon, :minor, :license) "
+        "ON CONFLICT " + conflict + " DO UPDATE "
+        "SET service_soon_hours = EXCLUDED.service_soon_hours, "
+        "    max_minor_defects = EXCLUDED.max_minor_defects, "
+        "    license_warning_days = EXCLUDED.license_warning_days"
+    );
+    query.bindValue(":id", QUuid::createUuid());
+    query.bindValue(":model", modelIdValue(thresholds.modelId));
+    query.bindValue(":soon", thresholds.serviceSoonHours);
+    query.bindValue(":minor", thresholds.maxMinorDefects);
+    query.bindValue(":license", thresholds.licenseWarningDays);
+
+    if (!query.exec()) {
+        qDebug() << "RuleRepo error (save):" << query.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+bool ReadinessRuleRepository::removeForModel(QUuid modelId) {
+    TRACE_FUNCTION("repository");
+    if (modelId.isNull()) return false;
+
+    QSqlDatabase db = DatabaseManager::instance().getDatabase();
+    SqlQuery query(db);
+    query.prepare("DELETE FROM readiness_rules WHERE model_id = :model");
+    query.bindValue(":model", modelId);
+    return query.exec();
+}
@@ -0,0 +1,21 @@
+#ifndef READINESSRULEREPOSITORY_H
+#define READINESSRULEREPOSITORY_H
+
+#include "src/models/Entities.h"
+#include <vector>
+
+// Пороги готовности оператора и моделей (таблица readiness_rules)
+class ReadinessRuleRepository {
+public:
+    ReadinessRuleRepository();
+
+    std::vector<ReadinessThresholds> getAll();
+
+    // Создает или обновляет пороги (modelId пустой - значения по умолчанию)
+    bool save(const ReadinessThresholds& thresholds);
+
+    // Удаляет переопределение для модели (для значений по умолчанию не действует)
+    bool removeForModel(QUuid modelId);
+};
+
+#endif // READINESSRULEREPOSITORY_H
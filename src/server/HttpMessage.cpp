@@ -0,0 +1,121 @@
+#include "src/server/HttpMessage.h"
+#include <QJsonDocument>
+#include <QUrl>
+
+QString HttpRequest::queryValue(const QByteArray& key) const {
+    for (const QByteArray& pair : query.split('&')) {
+        int eq = pair.indexOf('=');
+        QByteArray name = (eq < 0) ? pair : pair.left(eq);
+        if (name != key) continue;
+
+        QByteArray value = (eq < 0) ? QByteArray() : pair.mid(eq + 1);
+        value.replace('+', ' ');
+        return QUrl::fromPercentEncoding(value);
+    }
+    return QString();
+}
+
+HttpResponse HttpResponse::json(const QJsonObject& obj, int status) {
+    HttpResponse response;
+    response.status = status;
+    response.body = QJsonDocument(obj).toJson(QJsonDocument::Compact);
+    return response;
+}
+
+HttpResponse HttpResponse::json(const QJsonArray& array, int status) {
+    HttpResponse response;
+    response.status = status;
+    response.body = QJsonDocument(array).toJson(QJsonDocument::Compact);
+    return response;
+}
+
+HttpResponse HttpResponse::error(int status, const QString& message) {
+    QJsonObject obj;
+    obj.insert("error", message);
+    return json(obj, status);
+}
+
+QByteArray HttpResponse::serialize(bool keepAlive) const {
+    const char* reason = "OK";
+    switch (status) {
+    case 200: reason = "OK"; break;
+    case 400: reason = "Bad Request"; break;
+    case 404: reason = "Not Found"; break;
+    case 405: reason = "Method Not Allowed"; break;
+    case 413: reason = "Payload Too Large"; break;
+    case 500: reason = "Internal Server Error"; break;
+    case 503: reason = "Service Unavailable"; break;
+    }
+
+    QByteArray out;
+    out.reserve(body.size() + 160);
+    out.append("HTTP/1.1 ").append(QByteArray::number(status)).append(' ').append(reason).append("\r\n");
+    out.append("Content-Type: ").append(contentType).append("; charset=utf-8\r\n");
+    out.append("Content-Length: ").append(QByteArray::number(body.size())).append("\r\n");
+    out.append(keepAlive ? "Connection: keep-alive\r\n" : "Connection: close\r\n");
+    out.append("\r\n");
+    out.append(body);
+    return out;
+}
+
+HttpRequestParser::Result HttpRequestParser::parse(const QByteArray& buffer, int& offset, HttpRequest& request) {
+    // Пустые строки между запросами допускаются (RFC 7230, 3.5)
+    while (offset + 1 < buffer.size() && buffer[offset] == '\r' && buffer[offset + 1] == '\n') offset += 2;
+
+    int headerEnd = buffer.indexOf("\r\n\r\n", offset);
+    if (headerEnd < 0) {
+        return (buffer.size() - offset > MaxHeaderBytes) ? TooLarge : NeedMore;
+    }
+    if (headerEnd - offset > MaxHeaderBytes) return TooLarge;
+
+    // Строка запроса: METHOD SP target SP version
+    int lineEnd = buffer.indexOf("\r\n", offset);
+    QList<QByteArray> parts = buffer.mid(offset, lineEnd - offset).split(' ');
+    if (parts.size() != 3 || !parts[2].startsWith("HTTP/1.")) return BadRequest;
+
+    request = HttpRequest();
+    request.method = parts[0];
+    request.version = parts[2];
+
+    const QByteArray& target = parts[1];
+    int q = target.indexOf('?');
+    request.path = (q < 0) ? target : target.left(q);
+    request.query = (q < 0) ? QByteArray() : target.mid(q + 1);
+
+    // Заголовки
+    int pos = lineEnd + 2;
+    while (pos < headerEnd) {
+        int end = buffer.indexOf("\r\n", pos);
+        if (end < 0 || end > headerEnd) end = headerEnd;
+
+        int colon = buffer.indexOf(':', pos);
+        if (colon < 0 || colon > end) return BadRequest;
+
+        request.headers.insert(buffer.mid(pos, colon - pos).trimmed().toLower(),
+                               buffer.mid(colon + 1, end - colon - 1).trimmed());
+        pos = end + 2;
+    }
+
+    if (request.headers.contains("transfer-encoding")) return BadRequest;
+
+    // Тело
+    bool lengthOk = true;
+    int contentLength = request.headers.value("content-length", "0").toInt(&lengthOk);
+    if (!lengthOk || contentLength < 0) return BadRequest;
+    if (contentLength > MaxBodyBytes) return TooLarge;
+
+    int bodyStart = headerEnd + 4;
+    if (buffer.size() - bodyStart < contentLength) return NeedMore;
+    request.body = buffer.mid(bodyStart, contentLength);
+
+    // HTTP/1.1 держит соединение по умолчанию, HTTP/1.0 - только по явной просьбе
+    QByteArray connection = request.headers.value("connection").toLower();
+    if (request.version == "HTTP/1.0") {
+        request.keepAlive = (connection == "keep-alive");
+    } else {
+        request.keepAlive = (connection != "close");
+    }
+
+    offset = bodyStart + contentLength;
+    return Complete;
+}
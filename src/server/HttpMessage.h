@@ -0,0 +1,55 @@
+#ifndef HTTPMESSAGE_H
+#define HTTPMESSAGE_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QJsonObject>
+#include <QJsonArray>
+
+// Запрос HTTP/1.x (тело - только с Content-Length, chunked не поддерживается)
+struct HttpRequest {
+    QByteArray method;
+    QByteArray path;      // Без строки запроса
+    QByteArray query;     // После '?', без декодирования
+    QByteArray version;   // "HTTP/1.1"
+    QHash<QByteArray, QByteArray> headers;  // Имена в нижнем регистре
+    QByteArray body;
+    bool keepAlive = true;
+    bool fromLoopback = false;  // Клиент на этой же машине (заполняет соединение)
+
+    // Значение параметра строки запроса (percent-декодированное)
+    QString queryValue(const QByteArray& key) const;
+};
+
+struct HttpResponse {
+    int status = 200;
+    QByteArray contentType = "application/json";
+    QByteArray body;
+
+    static HttpResponse json(const QJsonObject& obj, int status = 200);
+    static HttpResponse json(const QJsonArray& array, int status = 200);
+    static HttpResponse error(int status, const QString& message);
+
+    // Строка статуса, заголовки и тело одним буфером
+    QByteArray serialize(bool keepAlive) const;
+};
+
+// Инкрементальный разбор входного потока соединения.
+// Несколько запросов подряд в одном буфере (pipelining) разбираются по очереди
+class HttpRequestParser {
+public:
+    enum Result {
+        NeedMore,    // Запрос пришел не полностью
+        Complete,    // request заполнен, offset сдвинут за конец запроса
+        BadRequest,
+        TooLarge
+    };
+
+    static const int MaxHeaderBytes = 16 * 1024;
+    static const int MaxBodyBytes = 1024 * 1024;
+
+    // Разбор запроса, начинающегося в buffer с позиции offset
+    static Result parse(const QByteArray& buffer, int& offset, HttpRequest& request);
+};
+
+#endif // HTTPMESSAGE_H
@@ -0,0 +1,193 @@
+#include "src/server/ReadinessApi.h"
+#include "src/server/ReadinessHttpServer.h"
+#include "src/services/ReadinessText.h"
+#include "src/services/ReadinessRuleEngine.h"
+#include "src/db/DatabaseManager.h"
+#include "src/services/Trace.h"
+#include "src/services/Metrics.h"
+#include <QJsonDocument>
+#include <QUrl>
+
+namespace {
+const char* statusCategory(quint16 status) {
+    if (status & AircraftGroundedMask) return "grounded";
+    if (status & AircraftWarningMask) return "warning";
+    return "ready";
+}
+
+// Число из JSON: допускается и строка ("120.5")
+bool jsonNumber(const QJsonObject& obj, const char* key, double& value) {
+    QJsonValue v = obj.value(key);
+    if (v.isDouble()) {
+        value = v.toDouble();
+        return true;
+    }
+    if (v.isString()) {
+        bool ok = false;
+        value = v.toString().toDouble(&ok);
+        return ok;
+    }
+    return false;
+}
+}
+
+ReadinessApi::ReadinessApi(const ServerStats& stats)
+    : m_stats(stats)
+{
+}
+
+HttpResponse ReadinessApi::handle(const HttpRequest& request) {
+    const QByteArray& path = request.path;
+
+    if (path == "/api/health") {
+        QJsonObject obj;
+        obj.insert("status", "ok");
+        obj.insert("database", DatabaseManager::instance().getDatabase().isOpen());
+        return HttpResponse::json(obj);
+    }
+    if (path == "/api/stats") {
+        return HttpResponse::json(m_stats.toJson());
+    }
+    if (path == "/metrics") {
+        HttpResponse response;
+        response.contentType = "text/plain; version=0.0.4";
+        response.body = Metrics::toPrometheusText();
+        return response;
+    }
+    if (path == "/api/trace") {
+        // Трасса содержит текст SQL-запросов: только с этой машины, при любом --bind
+        if (!request.fromLoopback) return HttpResponse::error(403, "trace is available only from localhost");
+        if (request.method != "GET") return HttpResponse::error(405, "use GET");
+        return trace(request);
+    }
+
+    if (!DatabaseManager::instance().getDatabase().isOpen()) {
+        return HttpResponse::error(503, "database unavailable");
+    }
+
+    if (path == "/api/readiness") {
+        if (request.method != "POST") return HttpResponse::error(405, "use POST");
+        return checkReadiness(request);
+    }
+    if (path == "/api/fleet") {
+        if (request.method != "GET") return HttpResponse::error(405, "use GET");
+        return fleetStatus();
+    }
+
+    // /api/aircraft/{id|reg}/defects
+    if (path.startsWith("/api/aircraft/") && path.endsWith("/defects")) {
+        if (request.method != "GET") return HttpResponse::error(405, "use GET");
+        const int prefix = 14, suffix = 8;
+        QByteArray key = path.mid(prefix, path.size() - prefix - suffix);
+        return aircraftDefects(QUrl::fromPercentEncoding(key));
+    }
+
+    return HttpResponse::error(404, "unknown endpoint");
+}
+
+HttpResponse ReadinessApi::trace(const HttpRequest& request) {
+    // ?enable=1 - начать запись заново, ?enable=0 - остановить; без параметра - выгрузка
+    QString enable = request.queryValue("enable");
+    if (!enable.isEmpty()) {
+        bool on = (enable == "1" || enable == "true");
+        if (on) Trace::clear();
+        Trace::setEnabled(on);
+
+        QJsonObject obj;
+        obj.insert("tracing", on);
+        return HttpResponse::json(obj);
+    }
+
+    HttpResponse response;
+    response.body = Trace::toChromeJson();
+    return response;
+}
+
+HttpResponse ReadinessApi::checkReadiness(const HttpRequest& request) {
+    QJsonDocument doc = QJsonDocument::fromJson(request.body);
+    if (!doc.isObject()) return HttpResponse::error(400, "body must be a JSON object");
+    QJsonObject body = doc.object();
+
+    FlightParams params;
+    double fuel = 0, cargo = 0, minutes = 0;
+    if (!jsonNumber(body, "fuel", fuel) || !jsonNumber(body, "cargo", cargo) || !jsonNumber(body, "minutes", minutes)) {
+        return HttpResponse::error(400, "fuel, cargo and minutes are required numbers");
+    }
+    params.fuelAmount = fuel;
+    params.cargoWeight = cargo;
+    params.flightTimeMinutes = (int)minutes;
+
+    // Неизвестный борт или пилот - не ошибка запроса: отчет содержит AIRCRAFT_NOT_FOUND / PILOT_NOT_FOUND
+    QUuid aircraftId = resolveAircraft(body.value("aircraft").toString());
+    Pilot pilot = resolvePilot(body.value("pilot").toString());
+
+    ReadinessContext context = m_readinessService.loadContext(aircraftId);
+    ReadinessReport report = m_readinessService.evaluate(context, pilot, params);
+
+    QJsonObject obj = ReadinessText::reportToJson(report, pilot.fullName, context.aircraft.modelName);
+    obj.insert("aircraft_id", context.aircraft.id.toString(QUuid::WithoutBraces));
+    obj.insert("reg", context.aircraft.regNumber);
+    obj.insert("pilot_id", pilot.id.toString(QUuid::WithoutBraces));
+    return HttpResponse::json(obj);
+}
+
+HttpResponse ReadinessApi::fleetStatus() {
+    FleetStore store;
+    // Сбой запроса - не пустой флот: клиент должен отличать одно от другого
+    if (!m_statusService.load(store)) return HttpResponse::error(503, "database unavailable");
+
+    QJsonArray list;
+    for (size_t i = 0; i < store.size(); ++i) {
+        QJsonObject row;
+        row.insert("id", store.id(i).toString(QUuid::WithoutBraces));
+        row.insert("reg", store.regNumber(i));
+        row.insert("model", store.modelName(i));
+        row.insert("hours_total", store.hoursTotal(i));
+        row.insert("hours_remaining", store.hoursRemaining(i));
+        row.insert("critical_defects", store.criticalDefects(i));
+        row.insert("minor_defects", store.minorDefects(i));
+        row.insert("status", statusCategory(store.status(i)));
+        row.insert("status_flags", (int)store.status(i));
+        row.insert("days_to_service", store.daysToService(i));
+        list.append(row);
+    }
+    return HttpResponse::json(list);
+}
+
+HttpResponse ReadinessApi::aircraftDefects(const QString& aircraftKey) {
+    QUuid aircraftId = resolveAircraft(aircraftKey);
+    if (aircraftId.isNull()) return HttpResponse::error(404, "aircraft not found");
+
+    QJsonArray list;
+    for (const ActiveDefect& d : m_defectRepo.getByAircraftId(aircraftId)) {
+        QJsonObject item;
+        item.insert("id", d.id.toString(QUuid::WithoutBraces));
+        item.insert("type_id", d.defectTypeId.toString(QUuid::WithoutBraces));
+        item.insert("description", d.description);
+        item.insert("severity", d.severity);
+        item.insert("created_at", d.createdAt.toString(Qt::ISODate));
+        list.append(item);
+    }
+    return HttpResponse::json(list);
+}
+
+QUuid ReadinessApi::resolveAircraft(const QString& key) {
+    if (key.isEmpty()) return QUuid();
+
+    QUuid id(key);
+    if (!id.isNull()) return id;
+    return m_aircraftRepo.getByRegNumber(key).id;
+}
+
+Pilot ReadinessApi::resolvePilot(const QString& key) {
+    if (key.isEmpty()) return Pilot();
+
+    QUuid id(key);
+    if (!id.isNull()) return m_pilotRepo.getById(id);
+
+    // По имени - только точное совпадение (без учета регистра)
+    for (const Pilot& p : m_pilotRepo.findByName(key)) {
+        if (p.fullName.compare(key, Qt::CaseInsensitive) == 0) return p;
+    }
+    return Pilot();
+}
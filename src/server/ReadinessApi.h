@@ -0,0 +1,49 @@
+#ifndef READINESSAPI_H
+#define READINESSAPI_H
+
+#include "src/server/HttpMessage.h"
+#include "src/services/ReadinessService.h"
+#include "src/services/FleetStatusService.h"
+#include "src/repositories/AircraftRepository.h"
+#include "src/repositories/DefectRepository.h"
+#include "src/repositories/PilotRepository.h"
+
+class ServerStats;
+
+// Маршруты HTTP API готовности. Экземпляр на рабочий поток сервера:
+// репозитории работают через подключение к БД своего потока
+//
+//   GET  /api/health
+//   GET  /api/stats                       - счетчики и задержки сервера
+//   GET  /api/trace[?enable=1|0]          - трассировка в формате Chrome trace (только localhost)
+//   GET  /metrics                         - метрики в текстовом формате Prometheus
+//   GET  /api/fleet                       - статус всего флота
+//   GET  /api/aircraft/{id|reg}/defects   - активные неисправности борта
+//   POST /api/readiness                   - проверка рейса:
+//        {"aircraft": id|reg, "pilot": id|имя, "fuel": л, "cargo": кг, "minutes": мин}
+class ReadinessApi {
+public:
+    explicit ReadinessApi(const ServerStats& stats);
+
+    HttpResponse handle(const HttpRequest& request);
+
+private:
+    HttpResponse checkReadiness(const HttpRequest& request);
+    HttpResponse trace(const HttpRequest& request);
+    HttpResponse fleetStatus();
+    HttpResponse aircraftDefects(const QString& aircraftKey);
+
+    // Борт по UUID или бортовому номеру (пустой id - не найден)
+    QUuid resolveAircraft(const QString& key);
+    Pilot resolvePilot(const QString& key);
+
+    const ServerStats& m_stats;
+
+    ReadinessService m_readinessService;
+    FleetStatusService m_statusService;
+    AircraftRepository m_aircraftRepo;
+    DefectRepository m_defectRepo;
+    PilotRepository m_pilotRepo;
+};
+
+#endif // READINESSAPI_H
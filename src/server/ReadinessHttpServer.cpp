@@ -0,0 +1,212 @@
+#include "src/server/ReadinessHttpServer.h"
+#include "src/server/ReadinessApi.h"
+#include "src/services/Metrics.h"
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QDebug>
+#include <memory>
+
+#ifdef Q_OS_WIN
+#include <winsock2.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+void closeDescriptor(qintptr socketDescriptor) {
+#ifdef Q_OS_WIN
+    ::closesocket((SOCKET)socketDescriptor);
+#else
+    ::close((int)socketDescriptor);
+#endif
+}
+}
+
+// --- ServerStats ---
+
+ServerStats::ServerStats()
+    : m_requests(0), m_errors(0), m_connections(0), m_totalMicros(0)
+{
+    for (auto& bucket : m_latency) bucket.store(0);
+}
+
+void ServerStats::record(qint64 micros, int status) {
+    // Те же данные для /metrics: время обработки и ответы по классу кода
+    static MetricHistogram& duration = Metrics::histogram("skyready_http_request_duration_seconds",
+                                                          "HTTP API request handling time.");
+    static MetricCounter* responses[5] = {
+        &Metrics::counter("skyready_http_responses_total", "HTTP API responses, by status class.", "code=\"1xx\""),
+        &Metrics::counter("skyready_http_responses_total", "HTTP API responses, by status class.", "code=\"2xx\""),
+        &Metrics::counter("skyready_http_responses_total", "HTTP API responses, by status class.", "code=\"3xx\""),
+        &Metrics::counter("skyready_http_responses_total", "HTTP API responses, by status class.", "code=\"4xx\""),
+        &Metrics::counter("skyready_http_responses_total", "HTTP API responses, by status class.", "code=\"5xx\"")
+    };
+    duration.observeNs(micros * 1000);
+    responses[qBound(0, status / 100 - 1, 4)]->inc();
+
+    m_requests.fetch_add(1, std::memory_order_relaxed);
+    if (status >= 400) m_errors.fetch_add(1, std::memory_order_relaxed);
+    m_totalMicros.fetch_add((quint64)qMax<qint64>(micros, 0), std::memory_order_relaxed);
+
+    int bucket = 0;
+    while (bucket < Buckets - 1 && (qint64(1) << (bucket + 1)) <= micros) ++bucket;
+    m_latency[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+qint64 ServerStats::percentile(double p) const {
+    quint64 counts[Buckets];
+    quint64 total = 0;
+    for (int b = 0; b < Buckets; ++b) {
+        counts[b] = m_latency[b].load(std::memory_order_relaxed);
+        total += counts[b];
+    }
+    if (total == 0) return 0;
+
+    quint64 rank = (quint64)(p * total);
+    quint64 seen = 0;
+    for (int b = 0; b < Buckets; ++b) {
+        seen += counts[b];
+        if (seen > rank) return qint64(1) << (b + 1);
+    }
+    return qint64(1) << Buckets;
+}
+
+QJsonObject ServerStats::toJson() const {
+    quint64 requests = m_requests.load(std::memory_order_relaxed);
+
+    QJsonObject obj;
+    obj.insert("requests", (double)requests);
+    obj.insert("errors", (double)m_errors.load(std::memory_order_relaxed));
+    obj.insert("connections", (double)m_connections.load(std::memory_order_relaxed));
+    obj.insert("mean_us", requests ? (double)m_totalMicros.load(std::memory_order_relaxed) / requests : 0.0);
+    obj.insert("p50_us", (double)percentile(0.50));
+    obj.insert("p90_us", (double)percentile(0.90));
+    obj.insert("p99_us", (double)percentile(0.99));
+    return obj;
+}
+
+// --- HttpConnection ---
+
+HttpConnection::HttpConnection(QTcpSocket *socket, ReadinessApi& api, ServerStats& stats, QObject *parent)
+    : QObject(parent), m_socket(socket), m_api(api), m_stats(stats)
+{
+    m_socket->setParent(this);
+    m_socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+
+    m_idleTimer.setSingleShot(true);
+    m_idleTimer.setInterval(IdleTimeoutMs);
+    m_idleTimer.start();
+
+    connect(m_socket, &QTcpSocket::readyRead, this, &HttpConnection::onReadyRead);
+    connect(m_socket, &QTcpSocket::disconnected, this, &QObject::deleteLater);
+    connect(&m_idleTimer, &QTimer::timeout, this, &HttpConnection::onIdleTimeout);
+
+    m_stats.connectionOpened();
+}
+
+void HttpConnection::onReadyRead() {
+    m_buffer.append(m_socket->readAll());
+    if (m_closing) return;  // После Connection: close остаток потока игнорируется
+
+    // Все полные запросы из буфера - по порядку; ответы уходят в том же порядке
+    int offset = 0;
+    while (!m_closing) {
+        QElapsedTimer timer;
+        timer.start();
+
+        HttpRequest request;
+        HttpRequestParser::Result result = HttpRequestParser::parse(m_buffer, offset, request);
+
+        if (result == HttpRequestParser::NeedMore) break;
+        if (result == HttpRequestParser::BadRequest) {
+            reply(HttpResponse::error(400, "malformed request"), false, timer.nsecsElapsed());
+            break;
+        }
+        if (result == HttpRequestParser::TooLarge) {
+            reply(HttpResponse::error(413, "request too large"), false, timer.nsecsElapsed());
+            break;
+        }
+
+        request.fromLoopback = m_socket->peerAddress().isLoopback();
+        HttpResponse response = m_api.handle(request);
+        reply(response, request.keepAlive, timer.nsecsElapsed());
+    }
+
+    m_buffer.remove(0, offset);
+    m_idleTimer.start();
+}
+
+void HttpConnection::reply(const HttpResponse& response, bool keepAlive, qint64 elapsedNs) {
+    m_stats.record(elapsedNs / 1000, response.status);
+
+    m_socket->write(response.serialize(keepAlive));
+    if (!keepAlive) {
+        m_closing = true;
+        m_socket->disconnectFromHost();  // Закроется после отправки записанного
+    }
+}
+
+void HttpConnection::onIdleTimeout() {
+    m_socket->disconnectFromHost();
+}
+
+// --- HttpWorker ---
+
+HttpWorker::HttpWorker(ServerStats& stats)
+    : m_stats(stats)
+{
+}
+
+HttpWorker::~HttpWorker() {
+}
+
+void HttpWorker::accept(qintptr socketDescriptor) {
+    // Сокет, не принявший дескриптор, им не владеет: дескриптор закрывается здесь,
+    // иначе он утекает вместе с соединением без живого сокета
+    std::unique_ptr<QTcpSocket> socket(new QTcpSocket);
+    if (!socket->setSocketDescriptor(socketDescriptor)) {
+        qDebug() << "Server: cannot adopt connection:" << socket->errorString();
+        closeDescriptor(socketDescriptor);
+        return;
+    }
+
+    if (!m_api) m_api.reset(new ReadinessApi(m_stats));
+    new HttpConnection(socket.release(), *m_api, m_stats, this);
+}
+
+// --- ReadinessHttpServer ---
+
+ReadinessHttpServer::ReadinessHttpServer(int workerCount, QObject *parent)
+    : QTcpServer(parent)
+{
+    if (workerCount <= 0) workerCount = qMax(2, QThread::idealThreadCount());
+
+    for (int i = 0; i < workerCount; ++i) {
+        QThread *thread = new QThread(this);
+        HttpWorker *worker = new HttpWorker(m_stats);
+        worker->moveToThread(thread);
+        connect(thread, &QThread::finished, worker, &QObject::deleteLater);
+        thread->start();
+
+        m_threads.push_back(thread);
+        m_workers.push_back(worker);
+    }
+}
+
+ReadinessHttpServer::~ReadinessHttpServer() {
+    close();
+    for (QThread *thread : m_threads) {
+        thread->quit();
+        thread->wait();
+    }
+}
+
+void ReadinessHttpServer::incomingConnection(qintptr socketDescriptor) {
+    // Соединение целиком обслуживает один работник: ответы конвейера не перемешиваются
+    HttpWorker *worker = m_workers[m_nextWorker];
+    m_nextWorker = (m_nextWorker + 1) % m_workers.size();
+
+    QMetaObject::invokeMethod(worker, [worker, socketDescriptor]() {
+        worker->accept(socketDescriptor);
+    }, Qt::QueuedConnection);
+}
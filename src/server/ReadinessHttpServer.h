@@ -0,0 +1,106 @@
+#ifndef READINESSHTTPSERVER_H
+#define READINESSHTTPSERVER_H
+
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QThread>
+#include <QTimer>
+#include <QJsonObject>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "src/server/HttpMessage.h"
+
+class ReadinessApi;
+
+// Счетчики сервера (общие для всех рабочих потоков, без блокировок).
+// Задержки - гистограмма по степеням двойки в микросекундах
+class ServerStats {
+public:
+    static const int Buckets = 32;
+
+    ServerStats();
+
+    void connectionOpened() { m_connections++; }
+    void record(qint64 micros, int status);
+
+    QJsonObject toJson() const;
+
+private:
+    // Верхняя граница корзины, в которую попадает перцентиль p (0..1), мкс
+    qint64 percentile(double p) const;
+
+    std::atomic<quint64> m_requests;
+    std::atomic<quint64> m_errors;
+    std::atomic<quint64> m_connections;
+    std::atomic<quint64> m_totalMicros;
+    std::atomic<quint64> m_latency[Buckets];
+};
+
+// Соединение: разбирает запросы из входного потока по мере поступления
+// и отвечает строго по порядку (pipelining), держит соединение (keep-alive)
+// до Connection: close или простоя
+class HttpConnection : public QObject {
+    Q_OBJECT
+
+public:
+    static const int IdleTimeoutMs = 30000;
+
+    // socket - уже принявший дескриптор соединения (переходит во владение)
+    HttpConnection(QTcpSocket *socket, ReadinessApi& api, ServerStats& stats, QObject *parent = nullptr);
+
+private slots:
+    void onReadyRead();
+    void onIdleTimeout();
+
+private:
+    void reply(const HttpResponse& response, bool keepAlive, qint64 elapsedNs);
+
+    QTcpSocket *m_socket;
+    QTimer m_idleTimer;
+    QByteArray m_buffer;
+    bool m_closing = false;
+
+    ReadinessApi& m_api;
+    ServerStats& m_stats;
+};
+
+// Рабочий поток сервера: свои соединения, свои сервисы и подключение к БД
+class HttpWorker : public QObject {
+    Q_OBJECT
+
+public:
+    explicit HttpWorker(ServerStats& stats);
+    ~HttpWorker();
+
+public slots:
+    // Вызывается в потоке работника: сокет создается в нем же
+    void accept(qintptr socketDescriptor);
+
+private:
+    ServerStats& m_stats;
+    std::unique_ptr<ReadinessApi> m_api;  // Создается в потоке работника (репозитории ходят в БД)
+};
+
+// HTTP/JSON сервер готовности (режим --serve).
+// Принимает соединения в главном потоке и раздает их по кругу рабочим потокам
+class ReadinessHttpServer : public QTcpServer {
+    Q_OBJECT
+
+public:
+    explicit ReadinessHttpServer(int workerCount, QObject *parent = nullptr);
+    ~ReadinessHttpServer();
+
+    const ServerStats& stats() const { return m_stats; }
+
+protected:
+    void incomingConnection(qintptr socketDescriptor) override;
+
+private:
+    ServerStats m_stats;
+    std::vector<QThread*> m_threads;
+    std::vector<HttpWorker*> m_workers;
+    size_t m_nextWorker = 0;
+};
+
+#endif // READINESSHTTPSERVER_H
@@ -0,0 +1,145 @@
+#include "src/services/AircraftContextCache.h"
+#include "src/services/Trace.h"
+#include "src/services/Metrics.h"
+#include "src/services/ReadinessService.h"
+#include <QtConcurrent/QtConcurrentRun>
+
+namespace {
+// Сервис на поток: конструкторы репозиториев обращаются к БД, не повторяем это на каждую загрузку
+ReadinessContext loadFromDatabase(QUuid aircraftId) {
+    thread_local ReadinessService service;
+    return service.loadContext(aircraftId);
+}
+
+// Исход get(): готовая запись, ожидание идущей загрузки, синхронное чтение
+MetricCounter& lookupCounter(const char* result) {
+    return Metrics::counter("skyready_context_cache_lookups_total", "Aircraft context cache lookups, by result.",
+                            QString("result=\"%1\"").arg(result));
+}
+}
+
+AircraftContextCache& AircraftContextCache::instance() {
+    static AircraftContextCache instance;
+    return instance;
+}
+
+AircraftContextCache::AircraftContextCache() {
+    // Пара потоков: соседние строки грузятся параллельно, но БД не забивается
+    m_pool.setMaxThreadCount(2);
+}
+
+AircraftContextCache::~AircraftContextCache() {
+    m_pool.waitForDone();
+}
+
+bool AircraftContextCache::isFresh(const Entry& entry) const {
+    return !entry.ready || entry.age.elapsed() < TtlMs;
+}
+
+void AircraftContextCache::insertEntry(QUuid aircraftId, const std::shared_ptr<Entry>& entry) {
+    m_entries.remove(aircraftId);
+
+    auto oldest = m_entries.end();
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (!isFresh(*it.value())) {
+            it = m_entries.erase(it);
+            continue;
+        }
+        if (oldest == m_entries.end() || it.value()->lastUsed < oldest.value()->lastUsed) oldest = it;
+        ++it;
+    }
+    // Вытесненная идущая загрузка не сохранится: store() не найдет ее запись
+    if (m_entries.size() >= MaxEntries && oldest != m_entries.end()) m_entries.erase(oldest);
+
+    entry->lastUsed = ++m_useClock;
+    m_entries.insert(aircraftId, entry);
+}
+
+void AircraftContextCache::prefetch(const std::vector<QUuid>& aircraftIds) {
+    TRACE_FUNCTION("service");
+    QMutexLocker locker(&m_mutex);
+
+    for (const QUuid& id : aircraftIds) {
+        if (id.isNull()) continue;
+
+        auto it = m_entries.find(id);
+        if (it != m_entries.end() && isFresh(*it.value())) {
+            it.value()->lastUsed = ++m_useClock;
+            continue;
+        }
+
+        auto entry = std::make_shared<Entry>();
+        entry->token = m_nextToken++;
+        insertEntry(id, entry);
+
+        const quint64 token = entry->token;
+        entry->pending = QtConcurrent::run(&m_pool, [this, id, token]() {
+            store(id, token, loadFromDatabase(id));
+        });
+    }
+}
+
+ReadinessContext AircraftContextCache::get(QUuid aircraftId) {
+    TRACE_FUNCTION("service");
+    static MetricCounter& hits = lookupCounter("hit");
+    static MetricCounter& joined = lookupCounter("pending");
+    static MetricCounter& misses = lookupCounter("miss");
+
+    std::shared_ptr<Entry> entry;
+    bool wasReady = false;
+    {
+        QMutexLocker locker(&m_mutex);
+        auto it = m_entries.find(aircraftId);
+        if (it != m_entries.end() && isFresh(*it.value())) {
+            entry = it.value();
+            entry->lastUsed = ++m_useClock;
+            wasReady = entry->ready;
+        }
+    }
+
+    if (entry) {
+        // Загрузка уже идет - ждем ее (без блокировки кэша)
+        entry->pending.waitForFinished();
+
+        QMutexLocker locker(&m_mutex);
+        if (entry->ready) {
+            (wasReady ? hits : joined).inc();
+            return entry->context;
+        }
+    }
+    misses.inc();
+
+    // Промах (или запись сброшена во время ожидания) - читаем сами
+    ReadinessContext context = loadFromDatabase(aircraftId);
+
+    QMutexLocker locker(&m_mutex);
+    auto fresh = std::make_shared<Entry>();
+    fresh->token = m_nextToken++;
+    fresh->ready = true;
+    fresh->context = context;
+    fresh->age.start();
+    insertEntry(aircraftId, fresh);
+    return context;
+}
+
+void AircraftContextCache::store(QUuid aircraftId, quint64 token, const ReadinessContext& context) {
+    QMutexLocker locker(&m_mutex);
+
+    auto it = m_entries.find(aircraftId);
+    if (it == m_entries.end() || it.value()->token != token) return;  // Запись сброшена, данные могли устареть
+
+    Entry& entry = *it.value();
+    entry.context = context;
+    entry.ready = true;
+    entry.age.start();
+}
+
+void AircraftContextCache::invalidate(QUuid aircraftId) {
+    QMutexLocker locker(&m_mutex);
+    m_entries.remove(aircraftId);
+}
+
+void AircraftContextCache::clear() {
+    QMutexLocker locker(&m_mutex);
+    m_entries.clear();
+}
@@ -0,0 +1,64 @@
+#ifndef AIRCRAFTCONTEXTCACHE_H
+#define AIRCRAFTCONTEXTCACHE_H
+
+#include "src/models/Entities.h"
+#include <QHash>
+#include <QMutex>
+#include <QFuture>
+#include <QThreadPool>
+#include <QElapsedTimer>
+#include <memory>
+#include <vector>
+
+// Краткоживущий кэш контекста готовности бортов (самолет, модель, дефекты, правила).
+// Главное окно заранее загружает в фоне контекст выбранной строки и соседних,
+// диалоги берут его отсюда и открываются без запросов к БД. Если загрузка еще
+// идет, get() дожидается ее, а не запускает те же запросы повторно.
+// Фоновые загрузки идут в собственном пуле (своим подключением к БД на поток).
+class AircraftContextCache {
+public:
+    // Singleton pattern (общий кэш для главного окна и диалогов)
+    static AircraftContextCache& instance();
+
+    // Срок жизни записи
+    static const int TtlMs = 30000;
+    // Предел числа записей: сверх него вытесняется давно не использованная
+    static const int MaxEntries = 64;
+
+    // Фоновая загрузка бортов, которых нет в кэше (или запись устарела)
+    void prefetch(const std::vector<QUuid>& aircraftIds);
+
+    // Контекст борта: из кэша, из идущей загрузки или синхронно из БД
+    ReadinessContext get(QUuid aircraftId);
+
+    // Сброс после изменения борта (полет, ТО, дефекты) или всего флота
+    void invalidate(QUuid aircraftId);
+    void clear();
+
+private:
+    AircraftContextCache();
+    ~AircraftContextCache();
+
+    struct Entry {
+        quint64 token = 0;  // Номер загрузки: результат устаревшей загрузки не сохраняется
+        bool ready = false;
+        ReadinessContext context;
+        QElapsedTimer age;
+        quint64 lastUsed = 0;  // Отметка последнего обращения (для вытеснения)
+        QFuture<void> pending;
+    };
+
+    bool isFresh(const Entry& entry) const;
+    // Вставка под m_mutex: сначала выбрасываются устаревшие записи, затем
+    // при переполнении - давно не использованная
+    void insertEntry(QUuid aircraftId, const std::shared_ptr<Entry>& entry);
+    void store(QUuid aircraftId, quint64 token, const ReadinessContext& context);
+
+    QMutex m_mutex;
+    QHash<QUuid, std::shared_ptr<Entry>> m_entries;
+    quint64 m_nextToken = 1;
+    quint64 m_useClock = 0;
+    QThreadPool m_pool;
+};
+
+#endif // AIRCRAFTCONTEXTCACHE_H
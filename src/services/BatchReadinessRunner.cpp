@@ -0,0 +1,290 @@
+#include "src/services/BatchReadinessRunner.h"
+#include "src/services/Trace.h"
+#include "src/services/ReadinessText.h"
+#include "src/services/ParallelFor.h"
+#include "src/db/DatabaseManager.h"
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QElapsedTimer>
+#include <QDebug>
+#include <cstdio>
+
+namespace {
+// Поля строки CSV с учетом кавычек ("a,b" и "" внутри кавычек)
+QStringList splitCsv(const QByteArray& line) {
+    QStringList fields;
+    QByteArray field;
+    bool quoted = false;
+
+    for (int i = 0; i < line.size(); ++i) {
+        char c = line[i];
+        if (quoted) {
+            if (c == '"' && i + 1 < line.size() && line[i + 1] == '"') {
+                field.append('"');
+                ++i;
+            } else if (c == '"') {
+                quoted = false;
+            } else {
+                field.append(c);
+            }
+        } else if (c == '"') {
+            quoted = true;
+        } else if (c == ',') {
+            fields.append(QString::fromUtf8(field).trimmed());
+            field.clear();
+        } else {
+            field.append(c);
+        }
+    }
+    fields.append(QString::fromUtf8(field).trimmed());
+    return fields;
+}
+
+// Число из JSON: допускается и строка ("120.5")
+bool jsonNumber(const QJsonObject& obj, const char* key, double& value) {
+    QJsonValue v = obj.value(key);
+    if (v.isDouble()) {
+        value = v.toDouble();
+        return true;
+    }
+    if (v.isString()) {
+        bool ok = false;
+        value = v.toString().toDouble(&ok);
+        return ok;
+    }
+    return false;
+}
+}
+
+BatchReadinessRunner::BatchReadinessRunner(const Options& options)
+    : m_options(options)
+{
+    if (m_options.chunkSize <= 0) m_options.chunkSize = 8192;
+}
+
+BatchReadinessRunner::Format BatchReadinessRunner::parseFormat(const QString& name) {
+    QString lower = name.toLower();
+    if (lower == "csv") return Format::Csv;
+    if (lower == "jsonl" || lower == "json") return Format::JsonLines;
+    return Format::Auto;
+}
+
+int BatchReadinessRunner::run() {
+    TRACE_FUNCTION("service");
+    // 1. Ввод и вывод (по умолчанию - стандартные потоки, для cron и конвейеров)
+    QFile in;
+    bool inputOk;
+    if (m_options.inputPath.isEmpty() || m_options.inputPath == "-") {
+        inputOk = in.open(stdin, QIODevice::ReadOnly);
+    } else {
+        in.setFileName(m_options.inputPath);
+        inputOk = in.open(QIODevice::ReadOnly);
+    }
+    if (!inputOk) {
+        qDebug() << "Batch: cannot open input:" << in.errorString();
+        return 1;
+    }
+
+    QFile out;
+    bool outputOk;
+    if (m_options.outputPath.isEmpty() || m_options.outputPath == "-") {
+        outputOk = out.open(stdout, QIODevice::WriteOnly);
+    } else {
+        out.setFileName(m_options.outputPath);
+        outputOk = out.open(QIODevice::WriteOnly | QIODevice::Truncate);
+    }
+    if (!outputOk) {
+        qDebug() << "Batch: cannot open output:" << out.errorString();
+        return 1;
+    }
+
+    // 2. Справочные данные - один раз на весь прогон
+    if (!DatabaseManager::instance().connectToDatabase()) return 2;
+
+    QElapsedTimer timer;
+    timer.start();
+    loadFleet();
+    qDebug() << "Batch: loaded" << m_contexts.size() << "aircraft and" << m_pilots.size()
+             << "pilots in" << timer.elapsed() << "ms";
+
+    // 3. Поток строк блоками: разбор -> пакетный расчет -> вывод
+    timer.restart();
+    Format format = m_options.format;
+    if (format == Format::Auto && m_options.inputPath.endsWith(".csv", Qt::CaseInsensitive)) format = Format::Csv;
+    if (format == Format::Auto && m_options.inputPath.endsWith(".jsonl", Qt::CaseInsensitive)) format = Format::JsonLines;
+
+    std::vector<PlannedFlight> chunk;
+    chunk.reserve(m_options.chunkSize);
+    qint64 lineNumber = 0;
+    bool firstRecord = true;  // Заголовок CSV - первая непустая строка, не обязательно первая в файле
+
+    while (!in.atEnd()) {
+        QByteArray line = in.readLine().trimmed();
+        ++lineNumber;
+        if (line.isEmpty() || line.startsWith("#")) continue;  // Пустые строки и комментарии
+
+        if (format == Format::Auto) format = detectFormat(line);
+
+        PlannedFlight flight;
+        flight.lineNumber = lineNumber;
+        const bool mayBeHeader = firstRecord;
+        firstRecord = false;
+        if (!parseLine(line, format, flight) && mayBeHeader && format == Format::Csv) {
+            continue;  // Строка заголовка CSV
+        }
+        chunk.push_back(flight);
+
+        if ((int)chunk.size() >= m_options.chunkSize) {
+            processChunk(chunk, out);
+            chunk.clear();
+        }
+    }
+    if (!chunk.empty()) processChunk(chunk, out);
+    out.flush();
+
+    qint64 elapsed = qMax<qint64>(timer.elapsed(), 1);
+    qDebug() << "Batch:" << m_processed << "flights checked," << m_notReady << "not ready,"
+             << m_rejected << "rejected lines," << elapsed << "ms"
+             << "(" << (m_processed * 1000 / elapsed) << "checks/s )";
+    return 0;
+}
+
+void BatchReadinessRunner::loadFleet() {
+    TRACE_FUNCTION("service");
+    m_contexts = m_service.loadFleetContexts();
+    m_pilots = m_pilotRepo.getAll();
+
+    for (size_t i = 0; i < m_contexts.size(); ++i) {
+        m_contextByReg.insert(m_contexts[i].aircraft.regNumber.toUpper(), (int)i);
+    }
+    for (size_t i = 0; i < m_pilots.size(); ++i) {
+        m_pilotById.insert(m_pilots[i].id, (int)i);
+        m_pilotByName.insert(m_pilots[i].fullName.toLower(), (int)i);
+    }
+}
+
+BatchReadinessRunner::Format BatchReadinessRunner::detectFormat(const QByteArray& firstLine) const {
+    return firstLine.startsWith("{") ? Format::JsonLines : Format::Csv;
+}
+
+bool BatchReadinessRunner::parseLine(const QByteArray& line, Format format, PlannedFlight& flight) const {
+    bool ok = (format == Format::JsonLines) ? parseJson(line, flight) : parseCsv(line, flight);
+    if (ok) resolve(flight);
+    return ok;
+}
+
+bool BatchReadinessRunner::parseCsv(const QByteArray& line, PlannedFlight& flight) const {
+    QStringList fields = splitCsv(line);
+    if (fields.size() < 5) {
+        flight.parseError = "expected 5 fields: reg,pilot,fuel,cargo,minutes";
+        return false;
+    }
+
+    flight.regNumber = fields[0];
+    flight.pilot = fields[1];
+
+    bool fuelOk = false, cargoOk = false, minutesOk = false;
+    flight.check.params.fuelAmount = fields[2].toDouble(&fuelOk);
+    flight.check.params.cargoWeight = fields[3].toDouble(&cargoOk);
+    flight.check.params.flightTimeMinutes = fields[4].toInt(&minutesOk);
+
+    if (!fuelOk || !cargoOk || !minutesOk) {
+        flight.parseError = "fuel, cargo and minutes must be numbers";
+        return false;
+    }
+    return true;
+}
+
+bool BatchReadinessRunner::parseJson(const QByteArray& line, PlannedFlight& flight) const {
+    QJsonDocument doc = QJsonDocument::fromJson(line);
+    if (!doc.isObject()) {
+        flight.parseError = "invalid JSON object";
+        return false;
+    }
+    QJsonObject obj = doc.object();
+
+    flight.regNumber = obj.contains("reg") ? obj.value("reg").toString() : obj.value("registration").toString();
+    flight.pilot = obj.contains("pilot") ? obj.value("pilot").toString() : obj.value("pilot_id").toString();
+
+    double fuel = 0, cargo = 0, minutes = 0;
+    if (!jsonNumber(obj, "fuel", fuel) || !jsonNumber(obj, "cargo", cargo) || !jsonNumber(obj, "minutes", minutes)) {
+        flight.parseError = "fuel, cargo and minutes are required numbers";
+        return false;
+    }
+
+    flight.check.params.fuelAmount = fuel;
+    flight.check.params.cargoWeight = cargo;
+    flight.check.params.flightTimeMinutes = (int)minutes;
+    return true;
+}
+
+void BatchReadinessRunner::resolve(PlannedFlight& flight) const {
+    // Неизвестный борт или пилот - не ошибка разбора: evaluate сам выдаст
+    // AIRCRAFT_NOT_FOUND / PILOT_NOT_FOUND
+    int contextIndex = m_contextByReg.value(flight.regNumber.toUpper(), -1);
+    flight.check.context = (contextIndex >= 0) ? &m_contexts[contextIndex] : nullptr;
+
+    // Пилот задается UUID или полным именем
+    int pilotIndex = -1;
+    QUuid pilotId(flight.pilot);
+    if (!pilotId.isNull()) pilotIndex = m_pilotById.value(pilotId, -1);
+    if (pilotIndex < 0) pilotIndex = m_pilotByName.value(flight.pilot.toLower(), -1);
+    flight.check.pilot = (pilotIndex >= 0) ? &m_pilots[pilotIndex] : nullptr;
+}
+
+void BatchReadinessRunner::processChunk(std::vector<PlannedFlight>& chunk, QIODevice& out) {
+    TRACE_FUNCTION("service");
+    // Расчет только для разобранных строк
+    std::vector<ReadinessCheck> checks;
+    std::vector<int> checkOf(chunk.size(), -1);
+    checks.reserve(chunk.size());
+    for (size_t i = 0; i < chunk.size(); ++i) {
+        if (!chunk[i].parseError.isEmpty()) continue;
+        checkOf[i] = (int)checks.size();
+        checks.push_back(chunk[i].check);
+    }
+
+    std::vector<ReadinessReport> reports;
+    m_service.evaluateBatch(checks, reports);
+
+    // Тексты замечаний и JSON собираются тоже параллельно, вывод - в исходном порядке
+    std::vector<QByteArray> lines(chunk.size());
+    ParallelFor::run(chunk.size(), 256, [&](size_t from, size_t to) {
+        static const ReadinessReport noReport{};
+        for (size_t i = from; i < to; ++i) {
+            lines[i] = formatVerdict(chunk[i], checkOf[i] >= 0 ? reports[checkOf[i]] : noReport);
+        }
+    });
+
+    QByteArray buffer;
+    for (size_t i = 0; i < chunk.size(); ++i) {
+        buffer.append(lines[i]);
+        buffer.append('\n');
+
+        if (checkOf[i] < 0) {
+            m_rejected++;
+        } else {
+            m_processed++;
+            if (!reports[checkOf[i]].isReady) m_notReady++;
+        }
+    }
+    out.write(buffer);
+    out.flush();
+}
+
+QByteArray BatchReadinessRunner::formatVerdict(const PlannedFlight& flight, const ReadinessReport& report) const {
+    QJsonObject obj;
+    if (flight.parseError.isEmpty()) {
+        const QString pilotName = flight.check.pilot ? flight.check.pilot->fullName : QString();
+        const QString modelName = flight.check.context ? flight.check.context->aircraft.modelName : QString();
+        obj = ReadinessText::reportToJson(report, pilotName, modelName);
+    } else {
+        obj.insert("error", flight.parseError);
+    }
+
+    obj.insert("line", (double)flight.lineNumber);
+    obj.insert("reg", flight.regNumber);
+    obj.insert("pilot", flight.pilot);
+    return QJsonDocument(obj).toJson(QJsonDocument::Compact);
+}
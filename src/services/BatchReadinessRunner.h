@@ -0,0 +1,79 @@
+#ifndef BATCHREADINESSRUNNER_H
+#define BATCHREADINESSRUNNER_H
+
+#include "src/services/ReadinessService.h"
+#include "src/repositories/PilotRepository.h"
+#include <QByteArray>
+#include <QHash>
+#include <QString>
+#include <vector>
+
+class QIODevice;
+
+// Пакетная проверка готовности без GUI (режим --batch).
+// Читает план рейсов (бортовой номер, пилот, топливо, загрузка, минуты) из CSV
+// или JSON Lines и построчно пишет вердикты в JSON Lines (пустые строки и
+// строки с "#" в начале пропускаются).
+// Флот, пилоты и правила загружаются из БД один раз, дальше расчет идет
+// блоками строк через ReadinessService::evaluateBatch без обращений к БД;
+// каждый блок выводится сразу после расчета
+class BatchReadinessRunner {
+public:
+    enum class Format {
+        Auto,       // По расширению файла или по первой строке
+        Csv,        // reg,pilot,fuel,cargo,minutes (строка заголовка допускается)
+        JsonLines   // {"reg": ..., "pilot": ..., "fuel": ..., "cargo": ..., "minutes": ...}
+    };
+
+    struct Options {
+        QString inputPath;          // Пусто или "-" - stdin
+        QString outputPath;         // Пусто или "-" - stdout
+        Format format = Format::Auto;
+        int chunkSize = 8192;       // Строк в блоке расчета
+    };
+
+    explicit BatchReadinessRunner(const Options& options);
+
+    // Код завершения процесса: 0 - успех, 1 - ошибка ввода/вывода, 2 - нет БД
+    int run();
+
+    // Разбор формата из аргумента командной строки ("csv", "jsonl")
+    static Format parseFormat(const QString& name);
+
+private:
+    // Исходная строка плана и результат ее разбора
+    struct PlannedFlight {
+        qint64 lineNumber = 0;
+        QString regNumber;
+        QString pilot;
+        QString parseError;   // Непустая - строка не разобрана, проверка не выполняется
+        ReadinessCheck check;
+    };
+
+    void loadFleet();
+    Format detectFormat(const QByteArray& firstLine) const;
+
+    bool parseLine(const QByteArray& line, Format format, PlannedFlight& flight) const;
+    bool parseCsv(const QByteArray& line, PlannedFlight& flight) const;
+    bool parseJson(const QByteArray& line, PlannedFlight& flight) const;
+    void resolve(PlannedFlight& flight) const;
+
+    void processChunk(std::vector<PlannedFlight>& chunk, QIODevice& out);
+    QByteArray formatVerdict(const PlannedFlight& flight, const ReadinessReport& report) const;
+
+    Options m_options;
+    ReadinessService m_service;
+    PilotRepository m_pilotRepo;
+
+    std::vector<ReadinessContext> m_contexts;
+    std::vector<Pilot> m_pilots;
+    QHash<QString, int> m_contextByReg;     // Номер в верхнем регистре -> контекст
+    QHash<QUuid, int> m_pilotById;
+    QHash<QString, int> m_pilotByName;      // Имя в нижнем регистре -> пилот
+
+    qint64 m_processed = 0;
+    qint64 m_notReady = 0;
+    qint64 m_rejected = 0;
+};
+
+#endif // BATCHREADINESSRUNNER_H
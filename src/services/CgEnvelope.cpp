@@ -0,0 +1,164 @@
+#include "src/services/CgEnvelope.h"
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QDebug>
+#include <algorithm>
+
+namespace {
+
+// Запись кэша: исходные данные, из которых собран конверт
+struct CacheEntry {
+    QByteArray json;
+    QString profile;
+    double maxTakeoffWeight;
+    std::shared_ptr<const CgEnvelope> envelope;
+};
+
+QMutex s_cacheMutex;
+QHash<QUuid, CacheEntry> s_cache;
+
+// Встроенный профиль для моделей, у которых в БД нет cg_envelope_json.
+// Повторяет старые захардкоженные значения; выбирается по cg_profile модели
+void fillDefaultProfile(const AircraftModel& model, CgEnvelope& env) {
+    double cgMin, cgMax;
+    if (model.cgProfile == "piper") {
+        env.armEmpty = 85.0;
+        env.armFuel = 95.0;
+        env.armPayload = 85.5;
+        cgMin = 82.0;
+        cgMax = 93.0;
+    } else {
+        if (model.cgProfile != "cessna") {
+            qDebug() << "CgEnvelope: у модели" << model.name << "неизвестный профиль" << model.cgProfile
+                     << "- используется профиль cessna";
+        }
+        env.armEmpty = 39.0;
+        env.armFuel = 48.0;
+        env.armPayload = 37.0;
+        cgMin = 35.0;
+        cgMax = 47.5;
+    }
+
+    env.points = { QPointF(cgMin, 0.0),
+                   QPointF(cgMin, model.maxTakeoffWeight),
+                   QPointF(cgMax, model.maxTakeoffWeight),
+                   QPointF(cgMax, 0.0) };
+}
+
+bool parseJson(const QByteArray& json, CgEnvelope& env) {
+    QJsonDocument doc = QJsonDocument::fromJson(json);
+    if (!doc.isObject()) return false;
+
+    QJsonObject root = doc.object();
+    QJsonObject arms = root.value("arms").toObject();
+    QJsonArray points = root.value("points").toArray();
+
+    if (!arms.contains("empty") || !arms.contains("fuel") || !arms.contains("payload")) return false;
+    if (points.size() < 3) return false;
+
+    env.armEmpty = arms.value("empty").toDouble();
+    env.armFuel = arms.value("fuel").toDouble();
+    env.armPayload = arms.value("payload").toDouble();
+
+    env.points.clear();
+    for (const auto& val : points) {
+        QJsonArray pt = val.toArray();
+        if (pt.size() != 2) return false;
+        env.points.push_back(QPointF(pt[0].toDouble(), pt[1].toDouble()));
+    }
+    return true;
+}
+
+} // namespace
+
+bool CgEnvelope::cgRangeAt(double weight, double& cgFrom, double& cgTo) const {
+    bool found = false;
+    for (const Edge& e : edges) {
+        if (weight >= e.yLow && weight <= e.yHigh) {
+            double x = e.x0 + (weight - e.yLow) * e.slope;
+            if (!found) {
+                cgFrom = cgTo = x;
+                found = true;
+            } else {
+                cgFrom = std::min(cgFrom, x);
+                cgTo = std::max(cgTo, x);
+            }
+        }
+    }
+    if (!found) {
+        cgFrom = minCg;
+        cgTo = maxCg;
+    }
+    return found;
+}
+
+std::shared_ptr<const CgEnvelope> CgEnvelope::compile(const AircraftModel& model, const QByteArray& json) {
+    auto env = std::make_shared<CgEnvelope>();
+
+    if (json.isEmpty()) {
+        qDebug() << "CgEnvelope: у модели" << model.name << "нет cg_envelope_json - встроенный профиль"
+                 << (model.cgProfile.isEmpty() ? QString("cessna") : model.cgProfile);
+        fillDefaultProfile(model, *env);
+    } else if (!parseJson(json, *env)) {
+        // Испорченный конверт не подменяется чужим: пустой конверт не пропускает
+        // ни одну загрузку, пока данные модели не исправят
+        qDebug() << "CgEnvelope: некорректный cg_envelope_json у модели" << model.name
+                 << "- загрузка этой модели будет отклоняться";
+        env->points.clear();
+        return env;
+    }
+
+    // Описывающий прямоугольник
+    env->minCg = env->maxCg = env->points[0].x();
+    env->minWeight = env->maxWeight = env->points[0].y();
+    for (const QPointF& p : env->points) {
+        env->minCg = std::min(env->minCg, p.x());
+        env->maxCg = std::max(env->maxCg, p.x());
+        env->minWeight = std::min(env->minWeight, p.y());
+        env->maxWeight = std::max(env->maxWeight, p.y());
+    }
+
+    // Ребра: ориентируем снизу вверх, горизонтальные отбрасываем
+    size_t n = env->points.size();
+    env->edges.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        QPointF a = env->points[i];
+        QPointF b = env->points[(i + 1) % n];
+        if (a.y() == b.y()) continue;
+        if (a.y() > b.y()) std::swap(a, b);
+
+        Edge e;
+        e.yLow = a.y();
+        e.yHigh = b.y();
+        e.x0 = a.x();
+        e.slope = (b.x() - a.x()) / (b.y() - a.y());
+        env->edges.push_back(e);
+    }
+
+    return env;
+}
+
+std::shared_ptr<const CgEnvelope> CgEnvelope::forModel(const AircraftModel& model) {
+    if (model.envelope) return model.envelope;
+
+    QMutexLocker locker(&s_cacheMutex);
+    auto it = s_cache.find(model.id);
+    if (it != s_cache.end()
+        && it->json == model.cgEnvelopeJson
+        && it->profile == model.cgProfile
+        && it->maxTakeoffWeight == model.maxTakeoffWeight) {
+        return it->envelope;
+    }
+
+    CacheEntry entry;
+    entry.json = model.cgEnvelopeJson;
+    entry.profile = model.cgProfile;
+    entry.maxTakeoffWeight = model.maxTakeoffWeight;
+    entry.envelope = compile(model, model.cgEnvelopeJson);
+    s_cache.insert(model.id, entry);
+    return entry.envelope;
+}
@@ -0,0 +1,69 @@
+#ifndef CGENVELOPE_H
+#define CGENVELOPE_H
+
+#include "src/models/Entities.h"
+#include <QByteArray>
+#include <QPointF>
+#include <memory>
+#include <vector>
+
+// Скомпилированный конверт центровки модели.
+// Собирается один раз из cg_envelope_json и дальше не меняется,
+// поэтому проверка точки не выделяет память и не сравнивает строки.
+//
+// Формат JSON в aircraft_models.cg_envelope_json:
+// {
+//   "arms":   { "empty": 39.0, "fuel": 48.0, "payload": 37.0 },
+//   "points": [ [35.0, 0], [35.0, 1043], [47.5, 1043], [47.5, 0] ]   // [CG, масса]
+// }
+struct CgEnvelope {
+    // Ребро многоугольника, подготовленное для теста пересечений:
+    // на высоте w (масса) ребро проходит через CG = x0 + (w - yLow) * slope
+    struct Edge {
+        double yLow;   // Нижняя масса ребра
+        double yHigh;  // Верхняя масса ребра
+        double x0;     // CG в точке yLow
+        double slope;  // dCG / dМасса
+    };
+
+    // Плечи станций загрузки
+    double armEmpty = 0;
+    double armFuel = 0;
+    double armPayload = 0;
+
+    // Описывающий прямоугольник для быстрого отсева
+    double minCg = 0;
+    double maxCg = 0;
+    double minWeight = 0;
+    double maxWeight = 0;
+
+    std::vector<Edge> edges;      // Без горизонтальных ребер
+    std::vector<QPointF> points;  // Исходные вершины (CG, масса)
+
+    // Лежит ли точка (CG, масса) внутри конверта
+    bool contains(double cg, double weight) const {
+        if (cg < minCg || cg > maxCg || weight < minWeight || weight > maxWeight) return false;
+
+        bool inside = false;
+        for (const Edge& e : edges) {
+            if (weight >= e.yLow && weight < e.yHigh) {
+                double x = e.x0 + (weight - e.yLow) * e.slope;
+                if (cg < x) inside = !inside;
+            }
+        }
+        return inside;
+    }
+
+    // Допустимый диапазон CG на заданной массе (для текста ошибки)
+    bool cgRangeAt(double weight, double& cgFrom, double& cgTo) const;
+
+    // Сборка конверта из JSON. Без JSON - встроенный прямоугольный профиль
+    // по cgProfile модели; некорректный JSON дает пустой конверт (ни одна
+    // точка не внутри)
+    static std::shared_ptr<const CgEnvelope> compile(const AircraftModel& model, const QByteArray& json);
+
+    // Конверт модели: уже собранный при загрузке из БД или из общего кэша
+    static std::shared_ptr<const CgEnvelope> forModel(const AircraftModel& model);
+};
+
+#endif // CGENVELOPE_H
@@ -0,0 +1,233 @@
+#include "src/services/DispatchPlanner.h"
+#include "src/services/Trace.h"
+#include "src/services/ReadinessRuleEngine.h"
+#include "src/services/ParallelFor.h"
+#include <QMap>
+#include <algorithm>
+
+namespace {
+
+// Сеть с единичными пропускными способностями (списки смежности на массивах).
+// Ребро e и обратное к нему e ^ 1 хранятся парой
+class UnitFlowNetwork {
+public:
+    explicit UnitFlowNetwork(int nodes) : m_head(nodes, -1), m_level(nodes), m_iter(nodes) {}
+
+    int addEdge(int from, int to) {
+        int e = (int)m_to.size();
+        push(from, to, 1);
+        push(to, from, 0);
+        return e;
+    }
+
+    bool hasFlow(int edge) const { return m_cap[edge] == 0; }
+
+    int maxFlow(int source, int sink) {
+        int flow = 0;
+        while (buildLevels(source, sink)) {
+            m_iter = m_head;
+            while (augment(source, sink)) ++flow;
+        }
+        return flow;
+    }
+
+private:
+    std::vector<int> m_head, m_next, m_to, m_cap;
+    std::vector<int> m_level, m_iter, m_queue;
+
+    void push(int from, int to, int cap) {
+        m_to.push_back(to);
+        m_cap.push_back(cap);
+        m_next.push_back(m_head[from]);
+        m_head[from] = (int)m_to.size() - 1;
+    }
+
+    // BFS по остаточной сети: слои кратчайших путей от истока
+    bool buildLevels(int source, int sink) {
+        std::fill(m_level.begin(), m_level.end(), -1);
+        m_queue.clear();
+        m_queue.push_back(source);
+        m_level[source] = 0;
+
+        for (size_t q = 0; q < m_queue.size(); ++q) {
+            int v = m_queue[q];
+            for (int e = m_head[v]; e != -1; e = m_next[e]) {
+                int u = m_to[e];
+                if (m_cap[e] > 0 && m_level[u] < 0) {
+                    m_level[u] = m_level[v] + 1;
+                    m_queue.push_back(u);
+                }
+            }
+        }
+        return m_level[sink] >= 0;
+    }
+
+    // Поиск увеличивающего пути по слоям; m_iter не дает повторно проходить тупики
+    bool augment(int v, int sink) {
+        if (v == sink) return true;
+        for (int& e = m_iter[v]; e != -1; e = m_next[e]) {
+            int u = m_to[e];
+            if (m_cap[e] > 0 && m_level[u] == m_level[v] + 1 && augment(u, sink)) {
+                m_cap[e] -= 1;
+                m_cap[e ^ 1] += 1;
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+} // namespace
+
+DispatchPlanner::DispatchPlanner() {
+}
+
+DispatchPlan DispatchPlanner::plan(const std::vector<MissionRequest>& missions,
+                                   const std::vector<Aircraft>& fleet,
+                                   const QHash<QUuid, AircraftModel>& models,
+                                   const QHash<QUuid, DefectCounts>& defects,
+                                   const std::vector<Pilot>& pilots,
+                                   const CompiledRules& rules,
+                                   const QDate& day) const
+{
+    TRACE_FUNCTION("service");
+    DispatchPlan plan;
+    plan.assignments.resize(missions.size());
+    if (missions.empty()) return plan;
+
+    // 1. Готовность бортов одной программой правил
+    AircraftColumns aircraftColumns;
+    aircraftColumns.reserve(fleet.size());
+    for (const Aircraft& plane : fleet) {
+        DefectCounts counts = defects.value(plane.id);
+        aircraftColumns.append(plane.engineHoursNextService - plane.engineHoursTotal,
+                               counts.critical, counts.minor, rules.modelIndex(plane.modelId));
+    }
+    std::vector<quint16> aircraftStatus(fleet.size());
+    ParallelFor::run(fleet.size(), 4096, [&](size_t from, size_t to) {
+        rules.evaluateAircraft(aircraftColumns, aircraftStatus.data(), from, to);
+    });
+
+    // Индексы готовых бортов и их типов (тип - отдельный узел сети)
+    std::vector<int> readyAircraft;
+    std::vector<int> aircraftType;  // Для каждого готового борта - номер типа
+    QHash<QUuid, int> typeIndex;
+    for (size_t i = 0; i < fleet.size(); ++i) {
+        if (aircraftStatus[i] & AircraftGroundedMask) continue;
+        if (!models.contains(fleet[i].modelId)) continue;
+
+        auto it = typeIndex.constFind(fleet[i].modelId);
+        if (it == typeIndex.constEnd()) it = typeIndex.insert(fleet[i].modelId, typeIndex.size());
+        readyAircraft.push_back((int)i);
+        aircraftType.push_back(*it);
+    }
+    plan.readyAircraft = (int)readyAircraft.size();
+
+    // 2. Документы пилотов на дату плана
+    PilotColumns pilotColumns;
+    pilotColumns.reserve(pilots.size());
+    for (const Pilot& p : pilots) {
+        int license = p.licenseExpiryDate.isValid() ? day.daysTo(p.licenseExpiryDate) : -1;
+        int medical = p.medicalExpiryDate.isValid() ? day.daysTo(p.medicalExpiryDate) : -1;
+        pilotColumns.append(license, medical, 0);
+    }
+    std::vector<quint16> pilotStatus(pilots.size());
+    ParallelFor::run(pilots.size(), 4096, [&](size_t from, size_t to) {
+        rules.evaluatePilots(pilotColumns, pilotStatus.data(), from, to);
+    });
+
+    // 3. Загрузка: решение для каждого готового борта и каждого разного времени задания
+    QMap<int, int> durationIndex;
+    for (const MissionRequest& m : missions) {
+        if (!durationIndex.contains(m.flightTimeMinutes)) durationIndex.insert(m.flightTimeMinutes, durationIndex.size());
+    }
+    const size_t durations = durationIndex.size();
+    std::vector<LoadSolution> solutions(readyAircraft.size() * durations);
+    ParallelFor::run(readyAircraft.size(), 64, [&](size_t from, size_t to) {
+        for (size_t a = from; a < to; ++a) {
+            const Aircraft& plane = fleet[readyAircraft[a]];
+            const AircraftModel& model = *models.constFind(plane.modelId);
+            for (auto it = durationIndex.constBegin(); it != durationIndex.constEnd(); ++it) {
+                solutions[a * durations + it.value()] = m_solver.solve(model, plane, it.key());
+            }
+        }
+    });
+
+    // 4. Сеть: исток -> задания -> борта -> типы -> пилоты -> сток
+    const int missionCount = (int)missions.size();
+    const int aircraftCount = (int)readyAircraft.size();
+    const int typeCount = typeIndex.size();
+    const int pilotCount = (int)pilots.size();
+
+    const int source = 0;
+    const int missionBase = 1;
+    const int aircraftBase = missionBase + missionCount;
+    const int typeBase = aircraftBase + aircraftCount;
+    const int pilotBase = typeBase + typeCount;
+    const int sink = pilotBase + pilotCount;
+
+    UnitFlowNetwork network(sink + 1);
+
+    std::vector<std::vector<std::pair<int, int>>> missionEdges(missionCount);  // (ребро, борт)
+    for (int m = 0; m < missionCount; ++m) {
+        network.addEdge(source, missionBase + m);
+        int d = durationIndex.value(missions[m].flightTimeMinutes);
+        for (int a = 0; a < aircraftCount; ++a) {
+            const LoadSolution& s = solutions[(size_t)a * durations + d];
+            if (!s.feasible || s.maxPayload < missions[m].payload) continue;
+            missionEdges[m].push_back({ network.addEdge(missionBase + m, aircraftBase + a), a });
+        }
+    }
+
+    for (int a = 0; a < aircraftCount; ++a) {
+        network.addEdge(aircraftBase + a, typeBase + aircraftType[a]);
+    }
+
+    std::vector<std::vector<std::pair<int, int>>> typeEdges(typeCount);  // (ребро, пилот)
+    for (int p = 0; p < pilotCount; ++p) {
+        if (pilotStatus[p] & PilotGroundedMask) continue;
+        plan.validPilots++;
+
+        bool rated = false;
+        for (const QUuid& modelId : pilots[p].allowedModels) {
+            auto it = typeIndex.constFind(modelId);
+            if (it == typeIndex.constEnd()) continue;
+            typeEdges[*it].push_back({ network.addEdge(typeBase + *it, pilotBase + p), p });
+            rated = true;
+        }
+        if (rated) network.addEdge(pilotBase + p, sink);
+    }
+
+    network.maxFlow(source, sink);
+
+    // 5. Разбор потока: борт задания, затем любой пилот из потока того же типа
+    std::vector<std::vector<int>> typePilots(typeCount);
+    for (int t = 0; t < typeCount; ++t) {
+        for (const auto& edge : typeEdges[t]) {
+            if (network.hasFlow(edge.first)) typePilots[t].push_back(edge.second);
+        }
+        // Порядок выдачи детерминированный: по возрастанию индекса пилота
+        std::sort(typePilots[t].begin(), typePilots[t].end(), std::greater<int>());
+    }
+
+    for (int m = 0; m < missionCount; ++m) {
+        for (const auto& edge : missionEdges[m]) {
+            if (!network.hasFlow(edge.first)) continue;
+
+            int a = edge.second;
+            std::vector<int>& freePilots = typePilots[aircraftType[a]];
+            if (freePilots.empty()) break;  // Не должно случаться: поток через тип сбалансирован
+
+            DispatchAssignment& assignment = plan.assignments[m];
+            assignment.aircraftIndex = readyAircraft[a];
+            assignment.pilotIndex = freePilots.back();
+            freePilots.pop_back();
+            assignment.solution = solutions[(size_t)a * durations + durationIndex.value(missions[m].flightTimeMinutes)];
+            assignment.payloadMargin = assignment.solution.maxPayload - missions[m].payload;
+            plan.assignedCount++;
+            break;
+        }
+    }
+
+    return plan;
+}
@@ -0,0 +1,49 @@
+#ifndef DISPATCHPLANNER_H
+#define DISPATCHPLANNER_H
+
+#include "src/models/Entities.h"
+#include "src/services/LoadSolver.h"
+#include <QHash>
+#include <vector>
+
+// Назначение на одно задание (индексы во входных списках, -1 - не назначено)
+struct DispatchAssignment {
+    int aircraftIndex = -1;
+    int pilotIndex = -1;
+    LoadSolution solution;     // Загрузка назначенного борта для времени задания
+    double payloadMargin = 0;  // maxPayload - payload
+
+    bool isAssigned() const { return aircraftIndex >= 0 && pilotIndex >= 0; }
+};
+
+// План на день: assignments[i] соответствует missions[i]
+struct DispatchPlan {
+    std::vector<DispatchAssignment> assignments;
+    int assignedCount = 0;
+    int readyAircraft = 0;  // Сколько бортов прошло проверку готовности
+    int validPilots = 0;    // Сколько пилотов с действующими документами
+};
+
+// Распределение пилотов и бортов по заданиям дня.
+// Задача сводится к максимальному потоку в единичной сети
+//   задание -> борт -> тип ВС -> пилот,
+// так как допуск пилота зависит только от типа борта. Поток ищется
+// алгоритмом Диница (на единичных сетях это оценка Хопкрофта-Карпа O(E*sqrt(V))),
+// результат - максимальное число заданий, обеспеченных и бортом, и пилотом.
+class DispatchPlanner {
+public:
+    DispatchPlanner();
+
+    DispatchPlan plan(const std::vector<MissionRequest>& missions,
+                      const std::vector<Aircraft>& fleet,
+                      const QHash<QUuid, AircraftModel>& models,
+                      const QHash<QUuid, DefectCounts>& defects,
+                      const std::vector<Pilot>& pilots,
+                      const CompiledRules& rules,
+                      const QDate& day) const;
+
+private:
+    LoadSolver m_solver;
+};
+
+#endif // DISPATCHPLANNER_H
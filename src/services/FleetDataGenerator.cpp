@@ -0,0 +1,311 @@
+#include "src/services/FleetDataGenerator.h"
+#include "src/services/Trace.h"
+#include "src/services/MaintenanceForecast.h"
+#include "src/db/DatabaseManager.h"
+#include "src/db/SqlQuery.h"
+#include <QElapsedTimer>
+#include <QDateTime>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Тип ВС каталога: характеристики и конверт в формате cg_envelope_json
+struct ModelProfile {
+    const char* name;
+    double maxTakeoffWeight;
+    double emptyWeight;
+    double fuelCapacity;
+    double fuelConsumption;
+    const char* envelopeJson;
+};
+
+const ModelProfile s_catalogue[] = {
+    { "Cessna 172N", 1043, 767, 212, 35,
+      R"({"arms": {"empty": 39.0, "fuel": 48.0, "payload": 37.0},)"
+      R"( "points": [[35.0, 0], [35.0, 1043], [47.5, 1043], [47.5, 0]]})" },
+    { "Piper PA-28", 1155, 710, 180, 32,
+      R"({"arms": {"empty": 85.0, "fuel": 95.0, "payload": 85.5},)"
+      R"( "points": [[82.0, 0], [82.0, 1155], [93.0, 1155], [93.0, 0]]})" },
+    { "Cessna 182T", 1406, 894, 333, 50,
+      R"({"arms": {"empty": 39.5, "fuel": 48.0, "payload": 40.0},)"
+      R"( "points": [[33.0, 0], [33.0, 1000], [35.5, 1406], [47.3, 1406], [47.3, 0]]})" },
+    { "Diamond DA40", 1200, 795, 148, 34,
+      R"({"arms": {"empty": 97.0, "fuel": 103.5, "payload": 90.6},)"
+      R"( "points": [[94.5, 0], [94.5, 1080], [96.5, 1200], [100.4, 1200], [100.4, 0]]})" },
+    { "Tecnam P2008", 650, 380, 120, 18,
+      R"({"arms": {"empty": 18.0, "fuel": 22.0, "payload": 19.0},)"
+      R"( "points": [[16.0, 0], [16.0, 650], [22.5, 650], [22.5, 0]]})" }
+};
+const int s_catalogueSize = sizeof(s_catalogue) / sizeof(s_catalogue[0]);
+
+const char* s_lastNames[] = {
+    "Иванов", "Петров", "Сидоров", "Смирнов", "Кузнецов", "Попов", "Волков", "Соколов",
+    "Лебедев", "Козлов", "Новиков", "Морозов", "Павлов", "Орлов", "Федоров", "Егоров"
+};
+const char* s_firstNames[] = {
+    "Иван", "Петр", "Алексей", "Сергей", "Андрей", "Дмитрий", "Михаил", "Николай",
+    "Владимир", "Олег", "Павел", "Юрий"
+};
+const char* s_patronymics[] = {
+    "Иванович", "Петрович", "Алексеевич", "Сергеевич", "Андреевич", "Дмитриевич",
+    "Михайлович", "Николаевич", "Владимирович", "Олегович"
+};
+
+template<class T, int N>
+const T& pick(QRandomGenerator& rng, const T (&items)[N]) {
+    return items[rng.bounded(N)];
+}
+
+// Строк в одном блоке массовой вставки (держит память генератора ограниченной)
+const size_t ChunkRows = 10000;
+}
+
+FleetDataGenerator::FleetDataGenerator(const Options& options)
+    : m_options(options)
+    , m_rng(options.seed)
+{
+    m_options.aircraft = qMax(0, m_options.aircraft);
+    m_options.pilots = qMax(0, m_options.pilots);
+    m_options.defectRate = qMax(0.0, m_options.defectRate);
+    m_options.criticalShare = qBound(0.0, m_options.criticalShare, 1.0);
+    m_options.ratingsPerPilot = qMax(1.0, m_options.ratingsPerPilot);
+    m_options.expiredShare = qBound(0.0, m_options.expiredShare, 1.0);
+
+    // Недостающие веса - нули, лишние отбрасываются; без весов - поровну
+    std::vector<double> mix = m_options.modelMix;
+    mix.resize(s_catalogueSize, mix.empty() ? 1.0 : 0.0);
+    double total = 0;
+    for (double& weight : mix) {
+        weight = qMax(0.0, weight);
+        total += weight;
+        m_mixCumulative.push_back(total);
+    }
+    if (total <= 0) {
+        for (int i = 0; i < s_catalogueSize; ++i) m_mixCumulative[i] = i + 1;
+    }
+}
+
+QStringList FleetDataGenerator::catalogueNames() {
+    QStringList names;
+    for (const ModelProfile& profile : s_catalogue) names << profile.name;
+    return names;
+}
+
+std::vector<double> FleetDataGenerator::parseMix(const QString& text) {
+    std::vector<double> mix;
+    for (const QString& part : text.split(',', Qt::SkipEmptyParts)) {
+        mix.push_back(part.trimmed().toDouble());
+    }
+    return mix;
+}
+
+FleetDataGenerator::Result FleetDataGenerator::generate() {
+    TRACE_FUNCTION("service");
+    Result result;
+    QElapsedTimer timer;
+    timer.start();
+
+    QSqlDatabase db = DatabaseManager::instance().getDatabase();
+    if (!db.isOpen()) return result;
+
+    // Ожидаемый объем для хода записи (дефекты - по среднему на борт)
+    m_rowsWritten = 0;
+    m_rowsExpected = m_options.aircraft + m_options.pilots + std::llround(m_options.defectRate * m_options.aircraft);
+
+    // Справочник дефектов заполняется до транзакции (ensureDefaultDefectsExist)
+    std::vector<DefectType> defectTypes = m_defectRepo.getAllDefectTypes();
+
+    if (!SqlQuery::transaction(db)) return result;
+
+    // 1. Очистка, как в seedDemoData (журнал полетов и пороги уходят каскадом)
+    m_defectRepo.deleteAllActive();
+    m_aircraftRepo.deleteAll();
+    m_pilotRepo.deleteAll();
+    m_modelRepo.deleteAll();
+
+    // 2. Каталог, борта, пилоты, дефекты - блоками через unnest
+    std::vector<AircraftModel> models;
+    std::vector<QUuid> aircraftIds;
+    qint64 defects = 0;
+    bool ok = writeModels(models)
+              && writeAircraft(models, aircraftIds)
+              && writePilots(models)
+              && writeDefects(aircraftIds, defectTypes, defects);
+
+    if (!ok || !SqlQuery::commit(db)) {
+        SqlQuery::rollback(db);
+        qDebug() << "FleetDataGenerator: generation failed, changes rolled back";
+        return result;
+    }
+
+    MaintenanceForecast::instance().reset();
+
+    result.ok = true;
+    result.models = (int)models.size();
+    result.aircraft = (qint64)aircraftIds.size();
+    result.pilots = m_options.pilots;
+    result.defects = defects;
+    result.elapsedMs = timer.elapsed();
+    qDebug() << "FleetDataGenerator:" << result.aircraft << "aircraft," << result.pilots << "pilots,"
+             << result.defects << "defects in" << result.elapsedMs << "ms";
+    return result;
+}
+
+bool FleetDataGenerator::writeModels(std::vector<AircraftModel>& models) {
+    TRACE_FUNCTION("service");
+    for (const ModelProfile& profile : s_catalogue) {
+        AircraftModel model;
+        model.id = nextUuid();
+        model.name = profile.name;
+        model.maxTakeoffWeight = profile.maxTakeoffWeight;
+        model.emptyWeight = profile.emptyWeight;
+        model.fuelCapacity = profile.fuelCapacity;
+        model.fuelConsumption = profile.fuelConsumption;
+        model.cgEnvelopeJson = profile.envelopeJson;
+        if (!m_modelRepo.create(model)) return false;
+        models.push_back(model);
+    }
+    return true;
+}
+
+bool FleetDataGenerator::writeAircraft(const std::vector<AircraftModel>& models, std::vector<QUuid>& aircraftIds) {
+    TRACE_FUNCTION("service");
+    // Номера RA-00000...; для флота больше 100 тыс. - больше цифр
+    int digits = qMax(5, (int)QString::number(qMax(0, m_options.aircraft - 1)).size());
+    aircraftIds.reserve(m_options.aircraft);
+
+    std::vector<Aircraft> chunk;
+    chunk.reserve(ChunkRows);
+    for (int i = 0; i < m_options.aircraft; ++i) {
+        Aircraft plane;
+        plane.id = nextUuid();
+        plane.modelId = models[pickModel()].id;
+        plane.regNumber = QString("RA-%1").arg(i, digits, 10, QChar('0'));
+        plane.engineHoursTotal = std::round(m_rng.bounded(6000.0) * 10.0) / 10.0;
+        // Интервал ТО 100 ч: остаток от -5 (ресурс исчерпан) до 100
+        plane.engineHoursNextService = plane.engineHoursTotal + std::round(m_rng.bounded(105.0) - 5.0);
+        chunk.push_back(plane);
+        aircraftIds.push_back(plane.id);
+
+        if (chunk.size() == ChunkRows) {
+            if (!m_aircraftRepo.createBatch(chunk)) return false;
+            reportRows(chunk.size());
+            chunk.clear();
+        }
+    }
+    if (!m_aircraftRepo.createBatch(chunk)) return false;
+    reportRows(chunk.size());
+    return true;
+}
+
+bool FleetDataGenerator::writePilots(const std::vector<AircraftModel>& models) {
+    TRACE_FUNCTION("service");
+    // Число допусков: 1 + геометрическое распределение со средним ratingsPerPilot.
+    // Типы выбираются с теми же весами, что и борта (популярные типы - чаще)
+    double extraRating = 1.0 - 1.0 / m_options.ratingsPerPilot;
+    int ratedTypes = 0;
+    for (int i = 0; i < s_catalogueSize; ++i) {
+        double weight = m_mixCumulative[i] - (i > 0 ? m_mixCumulative[i - 1] : 0.0);
+        if (weight > 0) ratedTypes++;
+    }
+
+    QDate today = QDate::currentDate();
+    auto expiry = [&](int validFrom, int validTo) {
+        if (m_rng.bounded(1.0) < m_options.expiredShare) return today.addDays(-1 - m_rng.bounded(180));
+        return today.addDays(validFrom + m_rng.bounded(validTo - validFrom));
+    };
+
+    std::vector<Pilot> chunk;
+    chunk.reserve(ChunkRows);
+    for (int i = 0; i < m_options.pilots; ++i) {
+        Pilot pilot;
+        pilot.id = nextUuid();
+        pilot.fullName = QString("%1 %2 %3").arg(pick(m_rng, s_lastNames), pick(m_rng, s_firstNames),
+                                                 pick(m_rng, s_patronymics));
+        pilot.licenseExpiryDate = expiry(10, 730);
+        pilot.medicalExpiryDate = expiry(10, 365);
+
+        int ratings = 1;
+        while (ratings < ratedTypes && m_rng.bounded(1.0) < extraRating) ratings++;
+        while (pilot.allowedModels.size() < ratings) {
+            QUuid modelId = models[pickModel()].id;
+            if (!pilot.allowedModels.contains(modelId)) pilot.allowedModels.append(modelId);
+        }
+        chunk.push_back(pilot);
+
+        if (chunk.size() == ChunkRows) {
+            if (!m_pilotRepo.createBatch(chunk)) return false;
+            reportRows(chunk.size());
+            chunk.clear();
+        }
+    }
+    if (!m_pilotRepo.createBatch(chunk)) return false;
+    reportRows(chunk.size());
+    return true;
+}
+
+bool FleetDataGenerator::writeDefects(const std::vector<QUuid>& aircraftIds, const std::vector<DefectType>& types,
+                                      qint64& written) {
+    TRACE_FUNCTION("service");
+    std::vector<QUuid> critical, minor;
+    for (const DefectType& type : types) {
+        (type.severity == "CRITICAL" ? critical : minor).push_back(type.id);
+    }
+    if (aircraftIds.empty() || (critical.empty() && minor.empty())) return true;
+
+    // Дефекты распределяются по бортам равномерно, открыты в течение последних 90 дней
+    const qint64 total = std::llround(m_options.defectRate * aircraftIds.size());
+    const QDateTime now = QDateTime::currentDateTime();
+
+    std::vector<ActiveDefect> chunk;
+    chunk.reserve(ChunkRows);
+    for (qint64 i = 0; i < total; ++i) {
+        bool isCritical = critical.empty() ? false
+                        : minor.empty() ? true
+                        : m_rng.bounded(1.0) < m_options.criticalShare;
+        const std::vector<QUuid>& pool = isCritical ? critical : minor;
+
+        ActiveDefect defect;
+        defect.id = nextUuid();
+        defect.aircraftId = aircraftIds[m_rng.bounded((int)aircraftIds.size())];
+        defect.defectTypeId = pool[m_rng.bounded((int)pool.size())];
+        defect.createdAt = now.addSecs(-(qint64)m_rng.bounded(90 * 24 * 3600));
+        chunk.push_back(defect);
+
+        if (chunk.size() == ChunkRows) {
+            if (!m_defectRepo.addActiveBatch(chunk)) return false;
+            written += (qint64)chunk.size();
+            reportRows(chunk.size());
+            chunk.clear();
+        }
+    }
+    if (!m_defectRepo.addActiveBatch(chunk)) return false;
+    written += (qint64)chunk.size();
+    reportRows(chunk.size());
+    return true;
+}
+
+void FleetDataGenerator::setProgressCallback(ProgressCallback callback) {
+    m_progress = std::move(callback);
+}
+
+void FleetDataGenerator::reportRows(size_t rows) {
+    m_rowsWritten += (qint64)rows;
+    if (m_progress) m_progress(m_rowsWritten, m_rowsExpected);
+}
+
+int FleetDataGenerator::pickModel() {
+    double r = m_rng.bounded(m_mixCumulative.back());
+    auto it = std::upper_bound(m_mixCumulative.begin(), m_mixCumulative.end(), r);
+    return (int)qMin<ptrdiff_t>(it - m_mixCumulative.begin(), s_catalogueSize - 1);
+}
+
+QUuid FleetDataGenerator::nextUuid() {
+    // UUID версии 4 из генератора с зерном: повторный запуск дает те же ключи
+    quint32 a = m_rng.generate(), b = m_rng.generate(), c = m_rng.generate(), d = m_rng.generate();
+    return QUuid(a, (ushort)(b >> 16), (ushort)((b & 0x0FFF) | 0x4000),
+                 (uchar)(((c >> 24) & 0x3F) | 0x80), (uchar)(c >> 16), (uchar)(c >> 8), (uchar)c,
+                 (uchar)(d >> 24), (uchar)(d >> 16), (uchar)(d >> 8), (uchar)d);
+}
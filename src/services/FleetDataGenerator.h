@@ -0,0 +1,81 @@
+#ifndef FLEETDATAGENERATOR_H
+#define FLEETDATAGENERATOR_H
+
+#include "src/models/Entities.h"
+#include "src/repositories/AircraftModelRepository.h"
+#include "src/repositories/AircraftRepository.h"
+#include "src/repositories/PilotRepository.h"
+#include "src/repositories/DefectRepository.h"
+#include <QRandomGenerator>
+#include <functional>
+#include <vector>
+
+// Генератор синтетического флота для нагрузочных тестов.
+// Заменяет все данные (как seedDemoData) набором заданного размера: типы из
+// встроенного каталога в заданной пропорции, борта с разным остатком ресурса,
+// пилоты с допусками и сроками документов, активные дефекты.
+// Пишет массовыми вставками (createBatch / addActiveBatch) в одной транзакции;
+// при одинаковых параметрах и зерне данные совпадают, включая UUID
+class FleetDataGenerator {
+public:
+    struct Options {
+        quint32 seed = 1;
+        int aircraft = 1000;
+        std::vector<double> modelMix;  // Веса типов каталога по порядку (пусто - поровну)
+        double defectRate = 0.5;       // Среднее число активных дефектов на борт
+        double criticalShare = 0.1;    // Доля критических среди дефектов
+        int pilots = 200;
+        double ratingsPerPilot = 1.5;  // Среднее число допусков пилота (не меньше 1)
+        double expiredShare = 0.05;    // Вероятность просрочки каждого документа пилота
+    };
+
+    struct Result {
+        bool ok = false;
+        int models = 0;
+        qint64 aircraft = 0;
+        qint64 pilots = 0;
+        qint64 defects = 0;
+        qint64 elapsedMs = 0;
+    };
+
+    // Ход записи: записано строк из ожидаемых. Вызывается после каждого блока
+    // в потоке, выполняющем generate
+    using ProgressCallback = std::function<void(qint64 written, qint64 expected)>;
+
+    explicit FleetDataGenerator(const Options& options);
+
+    void setProgressCallback(ProgressCallback callback);
+
+    Result generate();
+
+    // Названия типов каталога (порядок соответствует весам modelMix)
+    static QStringList catalogueNames();
+
+    // Веса из строки вида "5,3,1" (для командной строки и диалога)
+    static std::vector<double> parseMix(const QString& text);
+
+private:
+    bool writeModels(std::vector<AircraftModel>& models);
+    bool writeAircraft(const std::vector<AircraftModel>& models, std::vector<QUuid>& aircraftIds);
+    bool writePilots(const std::vector<AircraftModel>& models);
+    bool writeDefects(const std::vector<QUuid>& aircraftIds, const std::vector<DefectType>& types, qint64& written);
+
+    void reportRows(size_t rows);
+    int pickModel();
+    QUuid nextUuid();
+
+    Options m_options;
+    QRandomGenerator m_rng;
+    std::vector<double> m_mixCumulative;  // Накопленные веса для выбора типа
+
+    ProgressCallback m_progress;
+    qint64 m_rowsWritten = 0;
+    qint64 m_rowsExpected = 0;
+
+    AircraftModelRepository m_modelRepo;
+    AircraftRepository m_aircraftRepo;
+    PilotRepository m_pilotRepo;
+    DefectRepository m_defectRepo;
+};
+
+#endif // FLEETDATAGENERATOR_H
@@ -1,5 +1,8 @@
 #include "src/services/FleetService.h"
+#include "src/services/Trace.h"
 #include "src/db/DatabaseManager.h"
+#include "src/db/SqlQuery.h"
+#include "src/services/MaintenanceForecast.h"
 #include <QUuid>
 #include <QDate>
 #include <QDebug>
@@ -11,12 +14,13 @@ FleetService::FleetService() {
 }
 
 bool FleetService::deleteAircraft(QUuid aircraftId) {
+    TRACE_FUNCTION("service");
     QSqlDatabase db = DatabaseManager::instance().getDatabase();
 
     // Обязательно используем транзакцию, так как удаляем из нескольких таблиц
-    if (!db.transaction()) return false;
+    if (!SqlQuery::transaction(db)) return false;
 
-    QSqlQuery query(db);
+    SqlQuery query(db);
     bool success = true;
 
     // 1. Удаляем активные дефекты этого самолета через репозиторий
@@ -24,18 +28,20 @@ bool FleetService::deleteAircraft(QUuid aircraftId) {
 
     // 2. Удаляем сам самолет
     if (m_aircraftRepo.deleteById(aircraftId)) {
-        db.commit();
+        SqlQuery::commit(db);
+        MaintenanceForecast::instance().forget(aircraftId);
         return true;
     } else {
-        db.rollback();
+        SqlQuery::rollback(db);
         qDebug() << "Error deleting aircraft record";
         return false;
     }
 }
 
 bool FleetService::seedDemoData() {
+    TRACE_FUNCTION("service");
     QSqlDatabase db = DatabaseManager::instance().getDatabase();
-    QSqlQuery query(db);
+    SqlQuery query(db);
 
     // 1. Очистка старых данных через репозитории
     m_defectRepo.deleteAllActive();
@@ -43,6 +49,7 @@ bool FleetService::seedDemoData() {
     m_pilotRepo.deleteAll();
     m_modelRepo.deleteAll();
 
+    MaintenanceForecast::instance().reset();
     qDebug() << "FleetService: Database cleared. Seeding demo data...";
 
     // 2. Создаем Модели (Типы ВС)
@@ -56,6 +63,8 @@ bool FleetService::seedDemoData() {
     m1.emptyWeight = 767;
     m1.fuelCapacity = 212;
     m1.fuelConsumption = 35;
+    m1.cgEnvelopeJson = R"({"arms": {"empty": 39.0, "fuel": 48.0, "payload": 37.0},)"
+                        R"( "points": [[35.0, 0], [35.0, 1043], [47.5, 1043], [47.5, 0]]})";
     m_modelRepo.create(m1);
 
     AircraftModel m2;
@@ -65,6 +74,8 @@ bool FleetService::seedDemoData() {
     m2.emptyWeight = 710;
     m2.fuelCapacity = 180;
     m2.fuelConsumption = 32;
+    m2.cgEnvelopeJson = R"({"arms": {"empty": 85.0, "fuel": 95.0, "payload": 85.5},)"
+                        R"( "points": [[82.0, 0], [82.0, 1155], [93.0, 1155], [93.0, 0]]})";
     m_modelRepo.create(m2);
 
     // 3. Создаем Самолеты с разными статусами
@@ -142,6 +153,7 @@ bool FleetService::seedDemoData() {
 }
 
 bool FleetService::registerAircraft(const Aircraft& aircraft) {
+    TRACE_FUNCTION("service");
     // Валидация перед записью
     if (aircraft.regNumber.trimmed().isEmpty()) {
         qDebug() << "FleetService: Ошибка - пустой бортовой номер";
@@ -156,6 +168,7 @@ bool FleetService::registerAircraft(const Aircraft& aircraft) {
 }
 
 bool FleetService::registerPilot(const Pilot& pilot) {
+    TRACE_FUNCTION("service");
     // Валидация
     if (pilot.fullName.trimmed().isEmpty()) {
         qDebug() << "FleetService: Ошибка - пустое имя пилота";
@@ -171,10 +184,12 @@ bool FleetService::registerPilot(const Pilot& pilot) {
 
 // Удаление пилота
 bool FleetService::deletePilot(QUuid pilotId) {
+    TRACE_FUNCTION("service");
     return m_pilotRepo.deleteById(pilotId);
 }
 
 bool FleetService::reportDefect(QUuid aircraftId, QUuid defectTypeId) {
+    TRACE_FUNCTION("service");
     // Валидация
     if (aircraftId.isNull()) {
         qDebug() << "FleetService: Ошибка - самолет не выбран";
@@ -190,25 +205,70 @@ bool FleetService::reportDefect(QUuid aircraftId, QUuid defectTypeId) {
 
 // Реализация удаления неисправности
 bool FleetService::resolveDefect(QUuid activeDefectId) {
+    TRACE_FUNCTION("service");
     if (activeDefectId.isNull()) return false;
     return m_defectRepo.removeActiveDefect(activeDefectId);
 }
 
 bool FleetService::commitFlight(QUuid aircraftId, int flightTimeMinutes) {
-    // Рассчитываем часы
-    double hoursFlown = (double)flightTimeMinutes / 60.0;
+    TRACE_FUNCTION("service");
+    // Одиночный полет - частный случай пакета
+    FlightCompletion flight;
+    flight.aircraftId = aircraftId;
+    flight.flightTimeMinutes = flightTimeMinutes;
+    return commitBatch({ flight }).front();
+}
 
-    // Обновляем налет самолета
-    if (m_aircraftRepo.updateEngineHours(aircraftId, hoursFlown)) {
-        qDebug() << "Flight committed. Hours added:" << hoursFlown;
-        return true;
-    } else {
-        qDebug() << "Error updating engine hours";
-        return false;
+std::vector<bool> FleetService::commitBatch(const std::vector<FlightCompletion>& flights) {
+    TRACE_FUNCTION("service");
+    std::vector<bool> result(flights.size(), false);
+
+    // 1. Суммируем налет по бортам (повторы одного борта в пакете складываются)
+    QHash<QUuid, double> hoursById;
+    for (const FlightCompletion& f : flights) {
+        if (f.aircraftId.isNull() || f.flightTimeMinutes <= 0) continue;
+        hoursById[f.aircraftId] += (double)f.flightTimeMinutes / 60.0;
+    }
+    if (hoursById.isEmpty()) return result;
+
+    QSqlDatabase db = DatabaseManager::instance().getDatabase();
+    if (!SqlQuery::transaction(db)) return result;
+
+    // 2. Одно обновление налета на весь пакет; RETURNING говорит, какие борта найдены
+    QSet<QUuid> updated;
+    if (!m_aircraftRepo.addEngineHoursBatch(hoursById, updated)) {
+        SqlQuery::rollback(db);
+        return result;
+    }
+
+    // 3. Журнал - только для полетов найденных бортов
+    std::vector<FlightCompletion> logged;
+    logged.reserve(flights.size());
+    for (size_t i = 0; i < flights.size(); ++i) {
+        const FlightCompletion& f = flights[i];
+        if (f.flightTimeMinutes <= 0 || !updated.contains(f.aircraftId)) continue;
+        logged.push_back(f);
+        result[i] = true;
+    }
+
+    if (!m_flightLogRepo.addBatch(logged) || !SqlQuery::commit(db)) {
+        SqlQuery::rollback(db);
+        qDebug() << "Error committing flight batch";
+        return std::vector<bool>(flights.size(), false);
+    }
+
+    // 4. Прогноз ТО обновляется инкрементально, без перечитывания журнала
+    QDate today = QDate::currentDate();
+    for (const FlightCompletion& f : logged) {
+        MaintenanceForecast::instance().recordFlight(f.aircraftId, today, (double)f.flightTimeMinutes / 60.0);
     }
+
+    qDebug() << "Flight batch committed:" << logged.size() << "of" << flights.size();
+    return result;
 }
 
 bool FleetService::performEngineMaintenance(QUuid aircraftId) {
+    TRACE_FUNCTION("service");
     // 1. Получаем текущее состояние самолета
     Aircraft plane = m_aircraftRepo.getById(aircraftId);
     if (plane.id.isNull()) return false;
@@ -222,16 +282,18 @@ bool FleetService::performEngineMaintenance(QUuid aircraftId) {
 
 // Очистка
 bool FleetService::clearFleetData() {
+    TRACE_FUNCTION("service");
     QSqlDatabase db = DatabaseManager::instance().getDatabase();
 
-    if (!db.transaction()) return false;
+    if (!SqlQuery::transaction(db)) return false;
 
     // Чистим данные через репозитории
     m_defectRepo.deleteAllActive();
     m_aircraftRepo.deleteAll();
     m_pilotRepo.deleteAll();
 
-    db.commit();
+    SqlQuery::commit(db);
+    MaintenanceForecast::instance().reset();
     qDebug() << "FleetService: Operational data cleared.";
     return true;
 }
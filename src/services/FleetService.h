@@ -6,6 +6,7 @@
 #include "src/repositories/AircraftModelRepository.h"
 #include "src/repositories/PilotRepository.h"
 #include "src/repositories/DefectRepository.h"
+#include "src/repositories/FlightLogRepository.h"
 
 // Сервис управления флотом: отвечает за добавление и изменение данных
 class FleetService {
@@ -25,8 +26,13 @@ public:
     bool clearFleetData();
 
     // Фиксация совершенного рейса (Транзакция)
-    // Обновляет налет самолета и создает запись в истории
+    // Обновляет налет самолета, создает запись в журнале полетов и обновляет прогноз ТО
     bool commitFlight(QUuid aircraftId, int flightTimeMinutes);
+
+    // Пакетная фиксация полетов в одной транзакции (одно UPDATE на весь пакет).
+    // Результат по каждому полету в порядке flights: false - борт не найден,
+    // некорректное время или ошибка БД (тогда откатывается весь пакет)
+    std::vector<bool> commitBatch(const std::vector<FlightCompletion>& flights);
     bool resolveDefect(QUuid activeDefectId);
 
     // Провести регламентное обслуживание двигателя
@@ -43,6 +49,7 @@ private:
     AircraftModelRepository m_modelRepo;
     PilotRepository m_pilotRepo;
     DefectRepository m_defectRepo;
+    FlightLogRepository m_flightLogRepo;
 };
 
 #endif // FLEETSERVICE_H
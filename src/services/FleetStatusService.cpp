@@ -0,0 +1,107 @@
+#include "src/services/FleetStatusService.h"
+#include "src/services/Trace.h"
+#include "src/services/Metrics.h"
+#include <QElapsedTimer>
+#include "src/services/ReadinessRuleEngine.h"
+#include "src/services/ParallelFor.h"
+#include "src/db/SqlQuery.h"
+
+FleetStatusService::FleetStatusService() {
+}
+
+bool FleetStatusService::load(FleetStore& store) {
+    TRACE_FUNCTION("service");
+    static MetricHistogram& loadTime = Metrics::histogram("skyready_fleet_load_seconds",
+                                                          "Full fleet status load: queries, rules and forecast.");
+    static MetricGauge& fleetSize = Metrics::gauge("skyready_fleet_aircraft", "Aircraft in the last full fleet load.");
+    QElapsedTimer timer;
+    timer.start();
+    store.clear();
+
+    // Репозитории при ошибке возвращают пустой результат; отличить его от пустого
+    // флота можно только по счетчику ошибок потока
+    const qint64 errorsBefore = SqlQuery::counters().errors;
+    auto succeeded = [errorsBefore] { return SqlQuery::counters().errors == errorsBefore; };
+
+    std::vector<Aircraft> fleet = m_aircraftRepo.getAll();
+    if (!succeeded()) return false;
+    fleetSize.set((qint64)fleet.size());
+    if (fleet.empty()) return true;
+
+    // Сводка дефектов одним запросом и оценка всего флота одной программой правил
+    QHash<QUuid, DefectCounts> defects = m_defectRepo.getDefectCountsByAircraft();
+    m_rules = ReadinessRuleEngine::compile(m_ruleRepo.getAll());
+    std::shared_ptr<const CompiledRules> rules = m_rules;
+
+    AircraftColumns columns;
+    columns.reserve(fleet.size());
+    for (const Aircraft& plane : fleet) {
+        DefectCounts counts = defects.value(plane.id);
+        columns.append(plane.engineHoursNextService - plane.engineHoursTotal,
+                       counts.critical, counts.minor, rules->modelIndex(plane.modelId));
+    }
+    std::vector<quint16> status(fleet.size());
+    ParallelFor::run(fleet.size(), 4096, [&](size_t from, size_t to) {
+        rules->evaluateAircraft(columns, status.data(), from, to);
+    });
+
+    // Прогноз выхода на ТО по сглаженному налету (кэш, без чтения всего журнала)
+    std::vector<ServiceForecast> forecast = MaintenanceForecast::instance().project(fleet, QDate::currentDate());
+
+    store.reserve(fleet.size());
+    for (size_t i = 0; i < fleet.size(); ++i) {
+        DefectCounts counts;
+        counts.critical = columns.criticalDefects[i];
+        counts.minor = columns.minorDefects[i];
+        store.append(makeRow(fleet[i], counts, status[i], forecast[i]));
+    }
+    loadTime.observeNs(timer.nsecsElapsed());
+    return succeeded();
+}
+
+FleetStatusService::RowResult FleetStatusService::loadAircraft(QUuid aircraftId, FleetRow& row) {
+    TRACE_FUNCTION("service");
+    // Пустой борт из репозитория - и "не найден", и ошибка запроса: различаются по счетчику ошибок
+    const qint64 errorsBefore = SqlQuery::counters().errors;
+    auto succeeded = [errorsBefore] { return SqlQuery::counters().errors == errorsBefore; };
+
+    Aircraft plane = m_aircraftRepo.getById(aircraftId);
+    if (!succeeded()) return RowError;
+    if (plane.id.isNull()) return RowNotFound;
+
+    DefectCounts counts = m_defectRepo.getDefectCounts(aircraftId);
+    if (!succeeded()) return RowError;
+
+    std::shared_ptr<const CompiledRules> compiled = rules();
+    quint16 status = compiled->evaluateAircraft(plane.engineHoursNextService - plane.engineHoursTotal,
+                                                counts.critical, counts.minor,
+                                                compiled->modelIndex(plane.modelId));
+
+    std::vector<ServiceForecast> forecast = MaintenanceForecast::instance().project({ plane }, QDate::currentDate());
+
+    row = makeRow(plane, counts, status, forecast.front());
+    return RowLoaded;
+}
+
+FleetRow FleetStatusService::makeRow(const Aircraft& plane, const DefectCounts& counts, quint16 status,
+                                     const ServiceForecast& forecast) const
+{
+    FleetRow row;
+    row.id = plane.id;
+    row.regNumber = plane.regNumber;
+    row.modelId = plane.modelId;
+    row.modelName = plane.modelName;
+    row.hoursTotal = plane.engineHoursTotal;
+    row.hoursNextService = plane.engineHoursNextService;
+    row.criticalDefects = counts.critical;
+    row.minorDefects = counts.minor;
+    row.status = status;
+    row.daysToService = forecast.daysToService;
+    row.dailyHours = (float)forecast.dailyHours;
+    return row;
+}
+
+std::shared_ptr<const CompiledRules> FleetStatusService::rules() {
+    if (!m_rules) m_rules = ReadinessRuleEngine::compile(m_ruleRepo.getAll());
+    return m_rules;
+}
@@ -0,0 +1,44 @@
+#ifndef FLEETSTATUSSERVICE_H
+#define FLEETSTATUSSERVICE_H
+
+#include "src/models/Entities.h"
+#include "src/models/FleetStore.h"
+#include "src/repositories/AircraftRepository.h"
+#include "src/repositories/DefectRepository.h"
+#include "src/repositories/ReadinessRuleRepository.h"
+#include "src/services/MaintenanceForecast.h"
+#include <memory>
+
+// Сборка состояния флота для главной таблицы: борта, сводка дефектов,
+// статус по правилам готовности и прогноз ТО
+class FleetStatusService {
+public:
+    FleetStatusService();
+
+    // Полная загрузка в колоночное хранилище (три запроса на весь флот).
+    // false - хотя бы один запрос завершился ошибкой (хранилище неполное)
+    bool load(FleetStore& store);
+
+    // Итог загрузки строки одного борта
+    enum RowResult {
+        RowLoaded,
+        RowNotFound,  // Борт удален
+        RowError      // Запрос завершился ошибкой (row не заполнена)
+    };
+
+    // Строка одного борта (после диалогов): два запроса и правила из последней загрузки
+    RowResult loadAircraft(QUuid aircraftId, FleetRow& row);
+
+private:
+    FleetRow makeRow(const Aircraft& plane, const DefectCounts& counts, quint16 status,
+                     const ServiceForecast& forecast) const;
+    std::shared_ptr<const CompiledRules> rules();
+
+    std::shared_ptr<const CompiledRules> m_rules;  // Правила последней полной загрузки
+
+    AircraftRepository m_aircraftRepo;
+    DefectRepository m_defectRepo;
+    ReadinessRuleRepository m_ruleRepo;
+};
+
+#endif // FLEETSTATUSSERVICE_H
@@ -0,0 +1,72 @@
+#include "src/services/FlightCommitQueue.h"
+#include <QCoreApplication>
+#include <QDebug>
+
+FlightCommitQueue& FlightCommitQueue::instance() {
+    static FlightCommitQueue queue;
+    return queue;
+}
+
+FlightCommitQueue::FlightCommitQueue(QObject *parent)
+    : QObject(parent)
+{
+    m_timer.setSingleShot(true);
+    m_timer.setInterval(200);
+    connect(&m_timer, &QTimer::timeout, this, &FlightCommitQueue::flush);
+
+    // Остаток пакета записывается, пока приложение и соединение с БД еще живы
+    if (QCoreApplication *app = QCoreApplication::instance()) {
+        connect(app, &QCoreApplication::aboutToQuit, this, &FlightCommitQueue::flush);
+    }
+}
+
+FlightCommitQueue::~FlightCommitQueue() {
+    // Деструктор очереди-синглтона выполняется при статическом разрушении, когда
+    // приложения и драйвера БД уже нет: сюда не должно доходить незаписанное
+    if (!m_pending.empty()) {
+        qDebug() << "FlightCommitQueue: dropped" << m_pending.size() << "unflushed flights at exit";
+    }
+}
+
+void FlightCommitQueue::setWindow(int milliseconds) {
+    m_timer.setInterval(qMax(0, milliseconds));
+}
+
+void FlightCommitQueue::setMaxBatchSize(int size) {
+    m_maxBatchSize = qMax(1, size);
+}
+
+quint64 FlightCommitQueue::submit(QUuid aircraftId, int flightTimeMinutes) {
+    FlightCompletion flight;
+    flight.aircraftId = aircraftId;
+    flight.flightTimeMinutes = flightTimeMinutes;
+
+    quint64 ticket = m_nextTicket++;
+    m_pending.push_back(flight);
+    m_tickets.push_back(ticket);
+
+    // Окно отсчитывается от первой заявки пакета
+    if ((int)m_pending.size() >= m_maxBatchSize) {
+        QTimer::singleShot(0, this, &FlightCommitQueue::flush);
+    } else if (!m_timer.isActive()) {
+        m_timer.start();
+    }
+    return ticket;
+}
+
+void FlightCommitQueue::flush() {
+    m_timer.stop();
+    if (m_pending.empty()) return;
+
+    // Забираем пакет целиком: заявки, пришедшие из обработчиков сигналов, уйдут следующим
+    std::vector<FlightCompletion> flights;
+    std::vector<quint64> tickets;
+    flights.swap(m_pending);
+    tickets.swap(m_tickets);
+
+    std::vector<bool> result = m_fleetService.commitBatch(flights);
+
+    for (size_t i = 0; i < flights.size(); ++i) {
+        emit flightCommitted(tickets[i], flights[i].aircraftId, result[i]);
+    }
+}
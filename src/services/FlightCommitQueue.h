@@ -0,0 +1,46 @@
+#ifndef FLIGHTCOMMITQUEUE_H
+#define FLIGHTCOMMITQUEUE_H
+
+#include <QObject>
+#include <QTimer>
+#include "src/services/FleetService.h"
+
+// Очередь фиксации полетов (group commit).
+// Полеты, поступившие в течение короткого окна, записываются одной
+// транзакцией через FleetService::commitBatch. Каждый отправитель получает
+// свой результат сигналом flightCommitted с номером заявки.
+class FlightCommitQueue : public QObject {
+    Q_OBJECT
+
+public:
+    // Общая очередь GUI-потока
+    static FlightCommitQueue& instance();
+
+    // Окно накопления и предельный размер пакета (по достижении - запись сразу)
+    void setWindow(int milliseconds);
+    void setMaxBatchSize(int size);
+
+    // Ставит полет в очередь, возвращает номер заявки
+    quint64 submit(QUuid aircraftId, int flightTimeMinutes);
+
+public slots:
+    // Записать накопленное немедленно
+    void flush();
+
+signals:
+    void flightCommitted(quint64 ticket, QUuid aircraftId, bool success);
+
+private:
+    explicit FlightCommitQueue(QObject *parent = nullptr);
+    ~FlightCommitQueue();
+
+    FleetService m_fleetService;
+    QTimer m_timer;
+    int m_maxBatchSize = 64;
+    quint64 m_nextTicket = 1;
+
+    std::vector<FlightCompletion> m_pending;
+    std::vector<quint64> m_tickets;
+};
+
+#endif // FLIGHTCOMMITQUEUE_H
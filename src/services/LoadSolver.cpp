@@ -0,0 +1,185 @@
+#include "src/services/LoadSolver.h"
+#include "src/services/ReadinessRuleEngine.h"
+#include "src/services/CgEnvelope.h"
+#include "src/services/WeightCalculator.h"
+#include "src/services/ParallelFor.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Шаг округления результата (совпадает с точностью полей ввода)
+const double ROUNDING_STEP = 0.1;
+
+// Добавляет корни уравнения a*w^2 + b*w + c = 0 из отрезка [lo, hi]
+void addRoots(double a, double b, double c, double lo, double hi, std::vector<double>& out) {
+    if (a == 0) {
+        if (b != 0) {
+            double w = -c / b;
+            if (w >= lo && w <= hi) out.push_back(w);
+        }
+        return;
+    }
+
+    double disc = b * b - 4 * a * c;
+    if (disc < 0) return;
+
+    double sq = std::sqrt(disc);
+    // Устойчивая форма, чтобы не терять точность при b ~ sq
+    double q = -0.5 * (b + (b >= 0 ? sq : -sq));
+    double roots[2] = { q / a, q != 0 ? c / q : q / a };
+    for (double w : roots) {
+        if (w >= lo && w <= hi) out.push_back(w);
+    }
+}
+
+} // namespace
+
+LoadSolver::LoadSolver() {
+}
+
+LoadSolution LoadSolver::solve(const AircraftModel& model, const Aircraft& aircraft, int flightTimeMinutes) const {
+    Q_UNUSED(aircraft); // Масса пустого и плечи пока задаются на уровне модели
+
+    LoadSolution solution;
+
+    // 1. Минимальное топливо (те же формулы, что в WeightCalculator::calculate)
+    double hours = (double)flightTimeMinutes / 60.0;
+    double fuelNeeded = (hours * model.fuelConsumption) * 1.1;
+    solution.minFuel = std::ceil(fuelNeeded / ROUNDING_STEP) * ROUNDING_STEP;
+
+    if (solution.minFuel > model.fuelCapacity) {
+        solution.limit = LoadLimit::FuelCapacity;
+        return solution;
+    }
+
+    std::shared_ptr<const CgEnvelope> envelopePtr = CgEnvelope::forModel(model);
+    const CgEnvelope& env = *envelopePtr;
+
+    // 2. Масса и момент без загрузки. Загрузка p двигает точку по прямой
+    // в координатах (момент, масса): W = W0 + p, M = M0 + p * armPayload
+    double fuelWeight = solution.minFuel * WeightCalculator::FUEL_DENSITY;
+    double w0 = model.emptyWeight + fuelWeight;
+    double m0 = model.emptyWeight * env.armEmpty + fuelWeight * env.armFuel;
+    double arm = env.armPayload;
+
+    double weightLimit = model.maxTakeoffWeight - w0;
+    if (weightLimit < 0) {
+        solution.limit = LoadLimit::Weight;
+        return solution;
+    }
+
+    // 3. Точки, где путь может войти в конверт или выйти из него:
+    // пересечения с ребрами и уровни масс вершин (горизонтальные ребра).
+    // Для ребра CG = c + w * s условие M / w = CG дает s*w^2 + (c - arm)*w - (m0 - w0*arm) = 0
+    std::vector<double> weights;
+    weights.push_back(w0);
+    weights.push_back(w0 + weightLimit);
+
+    double k = m0 - w0 * arm;
+    for (const CgEnvelope::Edge& e : env.edges) {
+        double c = e.x0 - e.yLow * e.slope;
+        double lo = std::max(e.yLow, w0);
+        double hi = std::min(e.yHigh, w0 + weightLimit);
+        if (lo > hi) continue;
+        addRoots(e.slope, c - arm, -k, lo, hi, weights);
+    }
+    for (const QPointF& p : env.points) {
+        if (p.y() > w0 && p.y() < w0 + weightLimit) weights.push_back(p.y());
+    }
+
+    std::sort(weights.begin(), weights.end());
+    weights.erase(std::unique(weights.begin(), weights.end()), weights.end());
+
+    auto insideAt = [&](double payload) {
+        double w = w0 + payload;
+        return env.contains((m0 + payload * arm) / w, w);
+    };
+
+    // 4. Между соседними точками принадлежность конверту не меняется,
+    // поэтому достаточно проверить середину каждого участка (сверху вниз)
+    double best = -1;
+    for (size_t i = weights.size() - 1; i > 0; --i) {
+        double from = weights[i - 1] - w0;
+        double to = weights[i] - w0;
+        if (insideAt((from + to) / 2)) {
+            best = to;
+            break;
+        }
+    }
+    if (best < 0 && insideAt(0)) best = 0;
+
+    if (best < 0) {
+        solution.limit = LoadLimit::Envelope;
+        return solution;
+    }
+
+    // Граница конверта не включается, поэтому округляем вниз до шага ввода
+    double payload = std::floor(best / ROUNDING_STEP) * ROUNDING_STEP;
+    if (payload > 0 && !insideAt(payload)) payload = std::max(payload - ROUNDING_STEP, 0.0);
+    if (!insideAt(payload)) {
+        solution.limit = LoadLimit::Envelope;
+        return solution;
+    }
+
+    solution.feasible = true;
+    solution.maxPayload = payload;
+    solution.cgAtMaxPayload = (m0 + payload * arm) / (w0 + payload);
+    solution.limit = (best >= weightLimit) ? LoadLimit::Weight : LoadLimit::Envelope;
+    return solution;
+}
+
+std::vector<FleetCandidate> LoadSolver::rankFleet(const std::vector<Aircraft>& fleet,
+                                                  const QHash<QUuid, AircraftModel>& models,
+                                                  const QHash<QUuid, DefectCounts>& defects,
+                                                  const CompiledRules& rules,
+                                                  const MissionRequest& mission) const
+{
+    // Готовность бортов: ресурс и дефекты одной программой правил (пилот подбирается отдельно)
+    AircraftColumns columns;
+    columns.reserve(fleet.size());
+    for (const Aircraft& plane : fleet) {
+        DefectCounts counts = defects.value(plane.id);
+        columns.append(plane.engineHoursNextService - plane.engineHoursTotal,
+                       counts.critical, counts.minor, rules.modelIndex(plane.modelId));
+    }
+    std::vector<quint16> status(fleet.size());
+    ParallelFor::run(fleet.size(), 4096, [&](size_t from, size_t to) {
+        rules.evaluateAircraft(columns, status.data(), from, to);
+    });
+
+    // Решения для бортов считаются параллельно в заранее выделенный массив,
+    // затем кандидаты собираются в исходном порядке флота
+    std::vector<FleetCandidate> solved(fleet.size());
+    std::vector<char> eligible(fleet.size(), 0);
+    ParallelFor::run(fleet.size(), 256, [&](size_t from, size_t to) {
+        for (size_t i = from; i < to; ++i) {
+            const Aircraft& plane = fleet[i];
+            if (status[i] & AircraftGroundedMask) continue;
+
+            auto modelIt = models.constFind(plane.modelId);
+            if (modelIt == models.constEnd()) continue;
+
+            FleetCandidate& candidate = solved[i];
+            candidate.aircraft = plane;
+            candidate.solution = solve(*modelIt, plane, mission.flightTimeMinutes);
+            candidate.payloadMargin = candidate.solution.maxPayload - mission.payload;
+            eligible[i] = 1;
+        }
+    });
+
+    std::vector<FleetCandidate> result;
+    result.reserve(fleet.size());
+    for (size_t i = 0; i < fleet.size(); ++i) {
+        if (eligible[i]) result.push_back(std::move(solved[i]));
+    }
+
+    // Сначала борта с решением, затем по убыванию запаса; при равенстве по номеру
+    std::sort(result.begin(), result.end(), [](const FleetCandidate& a, const FleetCandidate& b) {
+        if (a.solution.feasible != b.solution.feasible) return a.solution.feasible;
+        if (a.payloadMargin != b.payloadMargin) return a.payloadMargin > b.payloadMargin;
+        return a.aircraft.regNumber < b.aircraft.regNumber;
+    });
+
+    return result;
+}
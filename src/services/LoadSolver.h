@@ -0,0 +1,55 @@
+#ifndef LOADSOLVER_H
+#define LOADSOLVER_H
+
+#include "src/models/Entities.h"
+#include <QHash>
+#include <vector>
+
+// Что ограничивает загрузку борта
+enum class LoadLimit {
+    None,          // Ограничений нет (решение найдено)
+    FuelCapacity,  // Минимально нужное топливо не помещается в баки
+    Weight,        // Упираемся в MTOW
+    Envelope       // Упираемся в конверт центровки
+};
+
+// Результат аналитического подбора загрузки
+struct LoadSolution {
+    bool feasible = false;       // Есть ли хотя бы одна допустимая загрузка
+    double minFuel = 0;          // Минимальное законное топливо (расход * время + 10%), л
+    double maxPayload = 0;       // Максимальная загрузка при minFuel, кг
+    double cgAtMaxPayload = 0;   // Центровка при максимальной загрузке
+    LoadLimit limit = LoadLimit::None;  // Что ограничило maxPayload
+};
+
+// Задание на рейс для подбора борта
+struct MissionRequest {
+    int flightTimeMinutes = 0;
+    double payload = 0;  // Требуемая загрузка (люди + груз), кг
+};
+
+// Борт-кандидат для задания
+struct FleetCandidate {
+    Aircraft aircraft;
+    LoadSolution solution;
+    double payloadMargin = 0;  // Запас по загрузке: maxPayload - payload
+};
+
+// Аналитический решатель загрузки: без перебора, только по линейным
+// соотношениям массы/момента и ребрам конверта центровки
+class LoadSolver {
+public:
+    LoadSolver();
+
+    LoadSolution solve(const AircraftModel& model, const Aircraft& aircraft, int flightTimeMinutes) const;
+
+    // Ранжирование исправных бортов флота по запасу загрузки.
+    // Борта, не готовые к вылету по ресурсу или дефектам (по правилам rules), пропускаются
+    std::vector<FleetCandidate> rankFleet(const std::vector<Aircraft>& fleet,
+                                          const QHash<QUuid, AircraftModel>& models,
+                                          const QHash<QUuid, DefectCounts>& defects,
+                                          const CompiledRules& rules,
+                                          const MissionRequest& mission) const;
+};
+
+#endif // LOADSOLVER_H
@@ -0,0 +1,139 @@
+#include "src/services/MaintenanceForecast.h"
+#include "src/services/Trace.h"
+#include "src/services/ParallelFor.h"
+#include <QMutexLocker>
+#include <cmath>
+
+namespace {
+
+// Сглаживание с окном ~14 дней: alpha = 2 / (N + 1)
+const double ALPHA = 2.0 / 15.0;
+
+} // namespace
+
+MaintenanceForecast& MaintenanceForecast::instance() {
+    static MaintenanceForecast forecast;
+    return forecast;
+}
+
+MaintenanceForecast::MaintenanceForecast() {
+}
+
+void MaintenanceForecast::addDay(Utilisation& u, const QDate& day, double hours) {
+    if (u.lastDay.isValid() && day <= u.lastDay) {
+        // Тот же день (или запись задним числом) - копим в открытый день
+        u.lastDayHours += hours;
+        return;
+    }
+
+    if (u.lastDay.isValid()) {
+        // Закрываем предыдущий день и пропущенные дни без полетов
+        u.rate = ALPHA * u.lastDayHours + (1.0 - ALPHA) * u.rate;
+        u.decay *= (1.0 - ALPHA);
+
+        qint64 gap = u.lastDay.daysTo(day) - 1;
+        if (gap > 0) {
+            double k = std::pow(1.0 - ALPHA, (double)gap);
+            u.rate *= k;
+            u.decay *= k;
+        }
+    }
+
+    u.lastDay = day;
+    u.lastDayHours = hours;
+}
+
+double MaintenanceForecast::dailyRate(const Utilisation& u, const QDate& today) {
+    if (!u.lastDay.isValid()) return 0;
+
+    // Открытый день закрываем на лету, затем затухание до сегодняшнего дня
+    double rate = ALPHA * u.lastDayHours + (1.0 - ALPHA) * u.rate;
+    double decay = u.decay * (1.0 - ALPHA);
+
+    qint64 gap = u.lastDay.daysTo(today);
+    if (gap > 0) {
+        double k = std::pow(1.0 - ALPHA, (double)gap);
+        rate *= k;
+        decay *= k;
+    }
+
+    // Поправка на короткую историю (иначе первые дни занижают оценку)
+    double weight = 1.0 - decay;
+    return weight > 0 ? rate / weight : 0;
+}
+
+void MaintenanceForecast::ensureLoaded() {
+    TRACE_FUNCTION("service");
+    if (m_loaded) return;
+
+    // Одна агрегированная выборка по всему журналу (строки отсортированы по борту и дате)
+    std::vector<DailyFlightHours> days = m_logRepo.getDailyTotals();
+    m_state.clear();
+    m_state.reserve(days.size() / 4 + 1);
+
+    Utilisation* current = nullptr;
+    QUuid currentId;
+    for (const DailyFlightHours& d : days) {
+        if (current == nullptr || d.aircraftId != currentId) {
+            currentId = d.aircraftId;
+            current = &m_state[currentId];
+        }
+        addDay(*current, d.day, d.hours);
+    }
+    m_loaded = true;
+}
+
+std::vector<ServiceForecast> MaintenanceForecast::project(const std::vector<Aircraft>& fleet, const QDate& today) {
+    TRACE_FUNCTION("service");
+    const size_t n = fleet.size();
+    std::vector<ServiceForecast> result(n);
+
+    // 1. Колонки: остаток ресурса и налет в день (поиск в кэше под одной блокировкой)
+    std::vector<double> remaining(n);
+    std::vector<double> rate(n);
+    {
+        QMutexLocker locker(&m_mutex);
+        ensureLoaded();
+        for (size_t i = 0; i < n; ++i) {
+            remaining[i] = fleet[i].engineHoursNextService - fleet[i].engineHoursTotal;
+            auto it = m_state.constFind(fleet[i].id);
+            rate[i] = (it == m_state.constEnd()) ? 0.0 : dailyRate(*it, today);
+        }
+    }
+
+    // 2. Проекция: дни = остаток / налет в день
+    const double minRate = 1e-3;  // Меньше ~4 минут в месяц считаем "не летает"
+    ParallelFor::run(n, 4096, [&](size_t from, size_t to) {
+        for (size_t i = from; i < to; ++i) {
+            ServiceForecast& f = result[i];
+            f.hoursRemaining = remaining[i];
+            f.dailyHours = rate[i];
+
+            if (remaining[i] <= 0) {
+                f.daysToService = 0;
+            } else if (rate[i] > minRate) {
+                f.daysToService = (int)std::ceil(remaining[i] / rate[i]);
+            }
+            if (f.daysToService >= 0) f.dueDate = today.addDays(f.daysToService);
+        }
+    });
+    return result;
+}
+
+void MaintenanceForecast::recordFlight(QUuid aircraftId, const QDate& day, double hours) {
+    QMutexLocker locker(&m_mutex);
+    // Пока кэш не построен, полет попадет в него из журнала при первой загрузке
+    if (!m_loaded) return;
+    addDay(m_state[aircraftId], day, hours);
+}
+
+void MaintenanceForecast::forget(QUuid aircraftId) {
+    QMutexLocker locker(&m_mutex);
+    m_state.remove(aircraftId);
+}
+
+void MaintenanceForecast::reset() {
+    QMutexLocker locker(&m_mutex);
+    m_state.clear();
+    m_loaded = false;
+}
@@ -0,0 +1,60 @@
+#ifndef MAINTENANCEFORECAST_H
+#define MAINTENANCEFORECAST_H
+
+#include "src/models/Entities.h"
+#include "src/repositories/FlightLogRepository.h"
+#include <QHash>
+#include <QMutex>
+#include <vector>
+
+// Прогноз даты ТО одного борта
+struct ServiceForecast {
+    double hoursRemaining = 0;  // Остаток ресурса до ТО, ч
+    double dailyHours = 0;      // Оценка среднего налета в день, ч
+    int daysToService = -1;     // Дней до ТО (-1 - борт не летает, прогноз невозможен)
+    QDate dueDate;              // Ожидаемая дата выхода на ТО
+
+    bool isKnown() const { return daysToService >= 0; }
+};
+
+// Прогноз выхода бортов на ТО по истории налета.
+// Средний налет в день оценивается экспоненциальным сглаживанием по дням
+// (дни без полетов учитываются как нулевые). Состояние строится один раз
+// из агрегированного журнала и дальше обновляется по каждому полету.
+class MaintenanceForecast {
+public:
+    // Singleton pattern (общий кэш для главного окна и диалогов)
+    static MaintenanceForecast& instance();
+
+    // Прогноз для всего флота одним проходом (результат в порядке fleet)
+    std::vector<ServiceForecast> project(const std::vector<Aircraft>& fleet, const QDate& today);
+
+    // Учет нового полета без пересчета истории
+    void recordFlight(QUuid aircraftId, const QDate& day, double hours);
+
+    // Сброс борта (удаление) или всего кэша (очистка/перезаливка БД)
+    void forget(QUuid aircraftId);
+    void reset();
+
+private:
+    MaintenanceForecast();
+
+    // Состояние сглаживания одного борта
+    struct Utilisation {
+        double rate = 0;        // Сглаженный налет по закрытым дням
+        double decay = 1;       // (1 - alpha)^n, для поправки на короткую историю
+        QDate lastDay;          // Последний день с налетом (еще не закрыт)
+        double lastDayHours = 0;
+    };
+
+    void ensureLoaded();
+    static void addDay(Utilisation& u, const QDate& day, double hours);
+    static double dailyRate(const Utilisation& u, const QDate& today);
+
+    FlightLogRepository m_logRepo;
+    QMutex m_mutex;
+    bool m_loaded = false;
+    QHash<QUuid, Utilisation> m_state;
+};
+
+#endif // MAINTENANCEFORECAST_H
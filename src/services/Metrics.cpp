@@ -0,0 +1,191 @@
+#include "src/services/Metrics.h"
+#include "src/services/Trace.h"
+#include <QHash>
+#include <QSaveFile>
+#include <QDebug>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+const double MetricHistogram::Bounds[MetricHistogram::Buckets] = {
+    0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0
+};
+
+void MetricHistogram::observeNs(qint64 ns) {
+    double seconds = ns / 1e9;
+    for (int b = 0; b < Buckets; ++b) {
+        if (seconds <= Bounds[b]) {
+            m_buckets[b].fetch_add(1, std::memory_order_relaxed);
+            break;
+        }
+    }
+    // Больше последней границы - только в +Inf (count)
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_sumNs.fetch_add(ns, std::memory_order_relaxed);
+}
+
+namespace {
+
+enum class MetricType { Counter, Gauge, Histogram };
+
+struct Series {
+    QString labels;
+    std::unique_ptr<MetricCounter> counter;
+    std::unique_ptr<MetricGauge> gauge;
+    std::unique_ptr<MetricHistogram> histogram;
+};
+
+struct Family {
+    QString name;
+    QString help;
+    MetricType type;
+    std::vector<std::unique_ptr<Series>> series;
+};
+
+// Семейства в порядке регистрации; объекты не перемещаются, ссылки на них вечные
+std::mutex s_mutex;
+std::vector<std::unique_ptr<Family>> s_families;
+
+std::atomic<bool> s_queryAttribution(false);
+
+Series& findSeries(const QString& name, const QString& help, const QString& labels, MetricType type) {
+    Family* family = nullptr;
+    for (const std::unique_ptr<Family>& f : s_families) {
+        if (f->name == name) {
+            family = f.get();
+            break;
+        }
+    }
+    if (!family) {
+        s_families.emplace_back(new Family{ name, help, type, {} });
+        family = s_families.back().get();
+    } else if (family->type != type) {
+        // Ошибка в коде: одно имя с разными типами. Ряд живет вне реестра
+        qDebug() << "Metrics: type mismatch for" << name;
+        static Series orphan[3];
+        Series& s = orphan[(int)type];
+        if (!s.counter) {
+            s.counter.reset(new MetricCounter);
+            s.gauge.reset(new MetricGauge);
+            s.histogram.reset(new MetricHistogram);
+        }
+        return s;
+    }
+
+    for (const std::unique_ptr<Series>& s : family->series) {
+        if (s->labels == labels) return *s;
+    }
+
+    family->series.emplace_back(new Series);
+    Series& s = *family->series.back();
+    s.labels = labels;
+    switch (type) {
+    case MetricType::Counter: s.counter.reset(new MetricCounter); break;
+    case MetricType::Gauge: s.gauge.reset(new MetricGauge); break;
+    case MetricType::Histogram: s.histogram.reset(new MetricHistogram); break;
+    }
+    return s;
+}
+
+// name{labels} или name{labels,extra}
+QByteArray seriesName(const QString& name, const QString& labels, const QByteArray& extra = QByteArray()) {
+    QByteArray out = name.toUtf8();
+    if (labels.isEmpty() && extra.isEmpty()) return out;
+    out += '{';
+    out += labels.toUtf8();
+    if (!labels.isEmpty() && !extra.isEmpty()) out += ',';
+    out += extra;
+    out += '}';
+    return out;
+}
+}
+
+namespace Metrics {
+
+MetricCounter& counter(const QString& name, const QString& help, const QString& labels) {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    return *findSeries(name, help, labels, MetricType::Counter).counter;
+}
+
+MetricGauge& gauge(const QString& name, const QString& help, const QString& labels) {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    return *findSeries(name, help, labels, MetricType::Gauge).gauge;
+}
+
+MetricHistogram& histogram(const QString& name, const QString& help, const QString& labels) {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    return *findSeries(name, help, labels, MetricType::Histogram).histogram;
+}
+
+void countQuery() {
+    if (!s_queryAttribution.load(std::memory_order_relaxed)) return;
+
+    // Ряд метода ищется в кэше потока, реестр - только при первом запросе метода
+    thread_local QHash<const char*, MetricCounter*> t_byMethod;
+    const char* method = Trace::innermost("repository");
+    MetricCounter*& series = t_byMethod[method];
+    if (!series) {
+        QString label = method ? Trace::displayName(method) : QString("other");
+        series = &counter("skyready_repository_queries_total", "SQL statements executed, by repository method.",
+                          QString("method=\"%1\"").arg(label));
+    }
+    series->inc();
+}
+
+void setQueryAttribution(bool on) {
+    bool was = s_queryAttribution.exchange(on);
+    if (on && !was) Trace::retainTracking();
+    if (!on && was) Trace::releaseTracking();
+}
+
+QByteArray toPrometheusText() {
+    std::lock_guard<std::mutex> lock(s_mutex);
+
+    QByteArray out;
+    for (const std::unique_ptr<Family>& family : s_families) {
+        static const char* typeNames[] = { "counter", "gauge", "histogram" };
+        out += "# HELP " + family->name.toUtf8() + ' ' + family->help.toUtf8() + '\n';
+        out += "# TYPE " + family->name.toUtf8() + ' ' + typeNames[(int)family->type] + '\n';
+
+        for (const std::unique_ptr<Series>& s : family->series) {
+            switch (family->type) {
+            case MetricType::Counter:
+                out += seriesName(family->name, s->labels) + ' ' + QByteArray::number(s->counter->value()) + '\n';
+                break;
+            case MetricType::Gauge:
+                out += seriesName(family->name, s->labels) + ' ' + QByteArray::number(s->gauge->value()) + '\n';
+                break;
+            case MetricType::Histogram: {
+                // Корзины в выгрузке накопительные; count читается первым, чтобы +Inf
+                // не оказался меньше последней корзины при параллельном обновлении
+                const MetricHistogram& h = *s->histogram;
+                quint64 count = h.count();
+                quint64 cumulative = 0;
+                QString bucketName = family->name + "_bucket";
+                for (int b = 0; b < MetricHistogram::Buckets; ++b) {
+                    cumulative += h.bucketCount(b);
+                    QByteArray le = "le=\"" + QByteArray::number(MetricHistogram::Bounds[b]) + '"';
+                    out += seriesName(bucketName, s->labels, le) + ' ' + QByteArray::number(qMin(cumulative, count)) + '\n';
+                }
+                out += seriesName(bucketName, s->labels, "le=\"+Inf\"") + ' ' + QByteArray::number(count) + '\n';
+                out += seriesName(family->name + "_sum", s->labels) + ' ' + QByteArray::number(h.sumSeconds(), 'g', 12) + '\n';
+                out += seriesName(family->name + "_count", s->labels) + ' ' + QByteArray::number(count) + '\n';
+                break;
+            }
+            }
+        }
+    }
+    return out;
+}
+
+bool writeTextFile(const QString& path) {
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qDebug() << "Metrics: cannot write" << path << ":" << file.errorString();
+        return false;
+    }
+    file.write(toPrometheusText());
+    return file.commit();
+}
+
+} // namespace Metrics
@@ -0,0 +1,78 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <QByteArray>
+#include <QString>
+#include <atomic>
+
+// Метрики для долго работающих станций диспетчера: счетчики, значения и
+// гистограммы длительностей в текстовом формате Prometheus (textfile collector
+// node_exporter или GET /metrics сервера).
+// Регистрация - под мьютексом, один раз: вызывающий хранит ссылку
+// (обычно в static-переменной функции). Обновление - атомарные операции
+// без блокировок, поэтому метрики можно трогать на горячих путях:
+//
+//   static MetricCounter& hits = Metrics::counter("skyready_context_cache_hits_total", "...");
+//   hits.inc();
+
+// Монотонный счетчик
+class MetricCounter {
+public:
+    void inc(quint64 n = 1) { m_value.fetch_add(n, std::memory_order_relaxed); }
+    quint64 value() const { return m_value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<quint64> m_value{0};
+};
+
+// Текущее значение (размер флота, длина очереди)
+class MetricGauge {
+public:
+    void set(qint64 value) { m_value.store(value, std::memory_order_relaxed); }
+    qint64 value() const { return m_value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<qint64> m_value{0};
+};
+
+// Гистограмма длительностей. Границы корзин фиксированы (от 0.5 мс до 10 с),
+// в выгрузке - секунды, как принято в Prometheus
+class MetricHistogram {
+public:
+    static const int Buckets = 14;
+    static const double Bounds[Buckets];
+
+    void observeNs(qint64 ns);
+
+    quint64 bucketCount(int bucket) const { return m_buckets[bucket].load(std::memory_order_relaxed); }
+    quint64 count() const { return m_count.load(std::memory_order_relaxed); }
+    double sumSeconds() const { return m_sumNs.load(std::memory_order_relaxed) / 1e9; }
+
+private:
+    std::atomic<quint64> m_buckets[Buckets] = {};  // Без накопления; накапливается при выгрузке
+    std::atomic<quint64> m_count{0};
+    std::atomic<qint64> m_sumNs{0};
+};
+
+namespace Metrics {
+
+// Ряд метрики name с метками labels ("verdict=\"go\"", пусто - без меток).
+// Повторный вызов с теми же name и labels возвращает тот же объект
+MetricCounter& counter(const QString& name, const QString& help, const QString& labels = QString());
+MetricGauge& gauge(const QString& name, const QString& help, const QString& labels = QString());
+MetricHistogram& histogram(const QString& name, const QString& help, const QString& labels = QString());
+
+// Запросы к БД по методам репозиториев (метод - ближайший интервал "repository",
+// см. Trace). Требует отслеживания активных интервалов, включается setQueryAttribution
+void countQuery();
+void setQueryAttribution(bool on);
+
+// Все метрики в текстовом формате Prometheus 0.0.4
+QByteArray toPrometheusText();
+
+// Запись через временный файл и переименование: сборщик не увидит файл наполовину
+bool writeTextFile(const QString& path);
+
+} // namespace Metrics
+
+#endif // METRICS_H
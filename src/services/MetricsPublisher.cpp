@@ -0,0 +1,32 @@
+#include "src/services/MetricsPublisher.h"
+
+MetricsPublisher::MetricsPublisher(const QString& loop, const QString& path, int writeIntervalMs, QObject *parent)
+    : QObject(parent),
+      m_path(path),
+      m_loopLag(Metrics::histogram("skyready_event_loop_lag_seconds",
+                                   "Delay of a periodic timer beyond its interval (event loop busy).",
+                                   QString("loop=\"%1\"").arg(loop)))
+{
+    // Точный таймер: опоздание тогда говорит о занятом цикле, а не о слиянии таймеров
+    m_probeTimer.setTimerType(Qt::PreciseTimer);
+    m_probeTimer.setInterval(ProbeIntervalMs);
+    connect(&m_probeTimer, &QTimer::timeout, this, &MetricsPublisher::onProbe);
+    m_sinceProbe.start();
+    m_probeTimer.start();
+
+    if (!m_path.isEmpty()) {
+        m_writeTimer.setInterval(qMax(1000, writeIntervalMs));
+        connect(&m_writeTimer, &QTimer::timeout, this, &MetricsPublisher::onWrite);
+        m_writeTimer.start();
+    }
+}
+
+void MetricsPublisher::onProbe() {
+    qint64 elapsedNs = m_sinceProbe.nsecsElapsed();
+    m_sinceProbe.restart();
+    m_loopLag.observeNs(qMax<qint64>(0, elapsedNs - qint64(ProbeIntervalMs) * 1000000));
+}
+
+void MetricsPublisher::onWrite() {
+    Metrics::writeTextFile(m_path);
+}
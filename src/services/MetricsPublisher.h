@@ -0,0 +1,37 @@
+#ifndef METRICSPUBLISHER_H
+#define METRICSPUBLISHER_H
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QString>
+#include "src/services/Metrics.h"
+
+// Живет в потоке с циклом событий (GUI или прием соединений сервера):
+// замеряет задержку цикла событий таймером-пробником и периодически
+// записывает все метрики в файл для textfile collector node_exporter
+// (путь пустой - только замер задержки; итоговую запись при выходе делает main)
+class MetricsPublisher : public QObject {
+    Q_OBJECT
+
+public:
+    static const int ProbeIntervalMs = 100;
+    static const int DefaultWriteIntervalMs = 15000;
+
+    // loop - метка цикла событий в метрике задержки ("gui", "server")
+    MetricsPublisher(const QString& loop, const QString& path, int writeIntervalMs = DefaultWriteIntervalMs,
+                     QObject *parent = nullptr);
+
+private slots:
+    void onProbe();
+    void onWrite();
+
+private:
+    QString m_path;
+    QTimer m_probeTimer;
+    QTimer m_writeTimer;
+    QElapsedTimer m_sinceProbe;
+    MetricHistogram& m_loopLag;
+};
+
+#endif // METRICSPUBLISHER_H
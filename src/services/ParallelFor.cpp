@@ -0,0 +1,51 @@
+#include "src/services/ParallelFor.h"
+#include <QThreadPool>
+#include <QtConcurrent/QtConcurrentRun>
+#include <QFuture>
+#include <QVector>
+#include <algorithm>
+#include <atomic>
+
+namespace ParallelFor {
+
+int threadCount() {
+    return qMax(1, QThreadPool::globalInstance()->maxThreadCount());
+}
+
+void run(size_t count, size_t grain, const std::function<void(size_t from, size_t to)>& body) {
+    if (count == 0) return;
+    grain = std::max<size_t>(grain, 1);
+
+    const size_t chunks = (count + grain - 1) / grain;
+    const int threads = (int)std::min<size_t>(chunks, (size_t)threadCount());
+
+    // Мало работы - без накладных расходов на пул
+    if (threads <= 1) {
+        body(0, count);
+        return;
+    }
+
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        for (size_t c = next.fetch_add(1); c < chunks; c = next.fetch_add(1)) {
+            size_t from = c * grain;
+            body(from, std::min(from + grain, count));
+        }
+    };
+
+    QVector<QFuture<void>> futures;
+    futures.reserve(threads - 1);
+    for (int i = 1; i < threads; ++i) {
+        futures.append(QtConcurrent::run(worker));
+    }
+
+    worker();
+
+    // Задачи, которые пул не успел запустить, выполняются здесь же (waitForFinished
+    // забирает их из очереди), поэтому вложенный вызов из потока пула не блокируется
+    for (QFuture<void>& f : futures) {
+        f.waitForFinished();
+    }
+}
+
+} // namespace ParallelFor
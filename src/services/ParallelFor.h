@@ -0,0 +1,22 @@
+#ifndef PARALLELFOR_H
+#define PARALLELFOR_H
+
+#include <functional>
+#include <cstddef>
+
+// Параллельная обработка диапазона индексов на общем пуле потоков (QThreadPool).
+// Диапазон [0, count) режется на блоки фиксированного размера grain, потоки
+// разбирают блоки по одному из общего счетчика, так что быстрые потоки забирают
+// работу у медленных. Каждый блок пишет только в свою часть заранее выделенного
+// результата, поэтому итог не зависит от числа потоков и порядка выполнения.
+namespace ParallelFor {
+
+// body(from, to) вызывается для каждого блока; вызывающий поток тоже участвует
+void run(size_t count, size_t grain, const std::function<void(size_t from, size_t to)>& body);
+
+// Сколько потоков будет задействовано (для подбора размера блока)
+int threadCount();
+
+} // namespace ParallelFor
+
+#endif // PARALLELFOR_H
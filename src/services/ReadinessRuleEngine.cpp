@@ -0,0 +1,205 @@
+#include "src/services/ReadinessRuleEngine.h"
+#include <algorithm>
+
+namespace {
+
+// Строки обрабатываются блоками: колонки приводятся к double во временных
+// массивах на стеке, после чего каждая инструкция - простой цикл сравнения
+const size_t BLOCK_SIZE = 256;
+
+} // namespace
+
+void AircraftColumns::reserve(size_t n) {
+    hoursRemaining.reserve(n);
+    criticalDefects.reserve(n);
+    minorDefects.reserve(n);
+    modelIndex.reserve(n);
+}
+
+void AircraftColumns::append(double hours, int critical, int minor, int model) {
+    hoursRemaining.push_back(hours);
+    criticalDefects.push_back(critical);
+    minorDefects.push_back(minor);
+    modelIndex.push_back(model);
+}
+
+void PilotColumns::reserve(size_t n) {
+    licenseDays.reserve(n);
+    medicalDays.reserve(n);
+    modelIndex.reserve(n);
+}
+
+void PilotColumns::append(int license, int medical, int model) {
+    licenseDays.push_back(license);
+    medicalDays.push_back(medical);
+    modelIndex.push_back(model);
+}
+
+int CompiledRules::modelIndex(const QUuid& modelId) const {
+    return m_modelIndex.value(modelId, 0);
+}
+
+const ReadinessThresholds& CompiledRules::thresholds(int modelIndex) const {
+    if (modelIndex < 0 || modelIndex >= (int)m_thresholds.size()) return m_thresholds[0];
+    return m_thresholds[modelIndex];
+}
+
+void CompiledRules::run(const std::vector<Instruction>& program, const double* const* columns,
+                        const qint32* modelIndex, quint16* out, size_t count) const
+{
+    double threshold[BLOCK_SIZE];
+
+    std::fill(out, out + count, 0);
+
+    for (const Instruction& ins : program) {
+        const double* col = columns[ins.column];
+
+        if (ins.constant) {
+            std::fill(threshold, threshold + count, ins.value);
+        } else {
+            for (size_t i = 0; i < count; ++i) {
+                threshold[i] = m_table[(size_t)modelIndex[i] * SlotCount + ins.slot];
+            }
+        }
+
+        const quint16 flag = ins.flag;
+        switch (ins.op) {
+        case OpLess:
+            for (size_t i = 0; i < count; ++i) out[i] |= (col[i] < threshold[i]) ? flag : 0;
+            break;
+        case OpLessEq:
+            for (size_t i = 0; i < count; ++i) out[i] |= (col[i] <= threshold[i]) ? flag : 0;
+            break;
+        case OpGreater:
+            for (size_t i = 0; i < count; ++i) out[i] |= (col[i] > threshold[i]) ? flag : 0;
+            break;
+        case OpGreaterEq:
+            for (size_t i = 0; i < count; ++i) out[i] |= (col[i] >= threshold[i]) ? flag : 0;
+            break;
+        }
+    }
+}
+
+void CompiledRules::evaluateAircraft(const AircraftColumns& columns, quint16* out, size_t from, size_t to) const {
+    double hours[BLOCK_SIZE];
+    double critical[BLOCK_SIZE];
+    double minor[BLOCK_SIZE];
+    const double* cols[] = { hours, critical, minor, nullptr, nullptr };
+
+    for (size_t start = from; start < to; start += BLOCK_SIZE) {
+        size_t n = std::min(BLOCK_SIZE, to - start);
+        for (size_t i = 0; i < n; ++i) {
+            hours[i] = columns.hoursRemaining[start + i];
+            critical[i] = columns.criticalDefects[start + i];
+            minor[i] = columns.minorDefects[start + i];
+        }
+        run(m_aircraftProgram, cols, columns.modelIndex.data() + start, out + start, n);
+    }
+}
+
+void CompiledRules::evaluatePilots(const PilotColumns& columns, quint16* out, size_t from, size_t to) const {
+    double license[BLOCK_SIZE];
+    double medical[BLOCK_SIZE];
+    const double* cols[] = { nullptr, nullptr, nullptr, license, medical };
+
+    for (size_t start = from; start < to; start += BLOCK_SIZE) {
+        size_t n = std::min(BLOCK_SIZE, to - start);
+        for (size_t i = 0; i < n; ++i) {
+            license[i] = columns.licenseDays[start + i];
+            medical[i] = columns.medicalDays[start + i];
+        }
+        run(m_pilotProgram, cols, columns.modelIndex.data() + start, out + start, n);
+    }
+}
+
+quint16 CompiledRules::evaluateAircraft(double hoursRemaining, int criticalDefects, int minorDefects, int modelIndex) const {
+    double critical = criticalDefects;
+    double minor = minorDefects;
+    qint32 model = modelIndex;
+    const double* cols[] = { &hoursRemaining, &critical, &minor, nullptr, nullptr };
+
+    quint16 flags;
+    run(m_aircraftProgram, cols, &model, &flags, 1);
+    return flags;
+}
+
+quint16 CompiledRules::evaluatePilot(int licenseDays, int medicalDays, int modelIndex) const {
+    double license = licenseDays;
+    double medical = medicalDays;
+    qint32 model = modelIndex;
+    const double* cols[] = { nullptr, nullptr, nullptr, &license, &medical };
+
+    quint16 flags;
+    run(m_pilotProgram, cols, &model, &flags, 1);
+    return flags;
+}
+
+std::shared_ptr<const CompiledRules> ReadinessRuleEngine::compile(const std::vector<ReadinessThresholds>& rules) {
+    auto compiled = std::make_shared<CompiledRules>();
+
+    // 1. Таблица порогов: [0] - по умолчанию, дальше переопределения моделей
+    ReadinessThresholds defaults;
+    for (const auto& r : rules) {
+        if (r.modelId.isNull()) defaults = r;
+    }
+    compiled->m_thresholds.push_back(defaults);
+
+    for (const auto& r : rules) {
+        if (r.modelId.isNull() || compiled->m_modelIndex.contains(r.modelId)) continue;
+        compiled->m_modelIndex.insert(r.modelId, (int)compiled->m_thresholds.size());
+        compiled->m_thresholds.push_back(r);
+    }
+
+    for (const auto& t : compiled->m_thresholds) {
+        compiled->m_table.push_back(t.serviceSoonHours);
+        compiled->m_table.push_back(t.maxMinorDefects);
+        compiled->m_table.push_back(t.licenseWarningDays);
+    }
+
+    // 2. Если порог одинаков у всех моделей, подставляем его константой
+    auto threshold = [&](CompiledRules::Slot slot) {
+        CompiledRules::Instruction ins;
+        ins.slot = slot;
+        ins.value = compiled->m_table[slot];
+        ins.constant = true;
+        for (size_t m = 1; m < compiled->m_thresholds.size(); ++m) {
+            if (compiled->m_table[m * CompiledRules::SlotCount + slot] != ins.value) ins.constant = false;
+        }
+        return ins;
+    };
+    auto constant = [](double value) {
+        CompiledRules::Instruction ins;
+        ins.slot = CompiledRules::SlotServiceSoon;
+        ins.value = value;
+        ins.constant = true;
+        return ins;
+    };
+    auto addInstruction = [](std::vector<CompiledRules::Instruction>& program, CompiledRules::Instruction ins,
+                   CompiledRules::Column column, CompiledRules::Op op, quint16 flag) {
+        ins.column = column;
+        ins.op = op;
+        ins.flag = flag;
+        program.push_back(ins);
+    };
+
+    // 3. Программа для бортов
+    auto& ap = compiled->m_aircraftProgram;
+    addInstruction(ap, constant(0), CompiledRules::ColHours, CompiledRules::OpLessEq, AircraftEngineExhausted);
+    addInstruction(ap, threshold(CompiledRules::SlotServiceSoon), CompiledRules::ColHours, CompiledRules::OpLess, AircraftServiceSoon);
+    addInstruction(ap, constant(0), CompiledRules::ColCritical, CompiledRules::OpGreater, AircraftCriticalDefect);
+    addInstruction(ap, threshold(CompiledRules::SlotMaxMinor), CompiledRules::ColMinor, CompiledRules::OpGreaterEq, AircraftMinorLimit);
+    addInstruction(ap, constant(0), CompiledRules::ColMinor, CompiledRules::OpGreater, AircraftMinorDefects);
+
+    // 4. Программа для пилотов
+    auto& pp = compiled->m_pilotProgram;
+    addInstruction(pp, constant(0), CompiledRules::ColLicense, CompiledRules::OpLess, PilotLicenseExpired);
+    addInstruction(pp, threshold(CompiledRules::SlotLicenseWarning), CompiledRules::ColLicense, CompiledRules::OpLess, PilotLicenseSoon);
+    addInstruction(pp, constant(0), CompiledRules::ColMedical, CompiledRules::OpLess, PilotMedicalExpired);
+
+    return compiled;
+}
+
+std::shared_ptr<const CompiledRules> ReadinessRuleEngine::defaults() {
+    static const std::shared_ptr<const CompiledRules> rules = compile({});
+    return rules;
+}
@@ -0,0 +1,107 @@
+#ifndef READINESSRULEENGINE_H
+#define READINESSRULEENGINE_H
+
+#include "src/models/Entities.h"
+#include <QHash>
+#include <memory>
+#include <vector>
+
+// Флаги состояния борта (результат программы правил)
+enum AircraftStatusFlag : quint16 {
+    AircraftEngineExhausted = 1 << 0,  // Ресурс двигателя исчерпан
+    AircraftServiceSoon     = 1 << 1,  // Скоро ТО
+    AircraftCriticalDefect  = 1 << 2,  // Есть критические дефекты
+    AircraftMinorLimit      = 1 << 3,  // Превышен лимит мелких дефектов
+    AircraftMinorDefects    = 1 << 4,  // Есть мелкие дефекты
+
+    AircraftGroundedMask = AircraftEngineExhausted | AircraftCriticalDefect | AircraftMinorLimit,
+    AircraftWarningMask  = AircraftServiceSoon | AircraftMinorDefects
+};
+
+// Флаги состояния пилота
+enum PilotStatusFlag : quint16 {
+    PilotLicenseExpired = 1 << 0,
+    PilotLicenseSoon    = 1 << 1,
+    PilotMedicalExpired = 1 << 2,
+
+    PilotGroundedMask = PilotLicenseExpired | PilotMedicalExpired
+};
+
+// Колонки флота для пакетной оценки (все массивы одной длины)
+struct AircraftColumns {
+    std::vector<double> hoursRemaining;
+    std::vector<qint32> criticalDefects;
+    std::vector<qint32> minorDefects;
+    std::vector<qint32> modelIndex;  // Индекс из CompiledRules::modelIndex
+
+    size_t size() const { return hoursRemaining.size(); }
+    void reserve(size_t n);
+    void append(double hours, int critical, int minor, int model);
+};
+
+// Колонки пилотов: дни до истечения документов
+struct PilotColumns {
+    std::vector<qint32> licenseDays;
+    std::vector<qint32> medicalDays;
+    std::vector<qint32> modelIndex;
+
+    size_t size() const { return licenseDays.size(); }
+    void reserve(size_t n);
+    void append(int license, int medical, int model);
+};
+
+// Скомпилированные правила: таблица порогов по моделям и плоская программа сравнений
+class CompiledRules {
+public:
+    // Индекс модели в таблице порогов (0 - значения оператора по умолчанию)
+    int modelIndex(const QUuid& modelId) const;
+    const ReadinessThresholds& thresholds(int modelIndex) const;
+
+    // Оценка диапазона строк [from, to). Результат пишется в out[from..to)
+    void evaluateAircraft(const AircraftColumns& columns, quint16* out, size_t from, size_t to) const;
+    void evaluatePilots(const PilotColumns& columns, quint16* out, size_t from, size_t to) const;
+
+    // Оценка одной записи той же программой
+    quint16 evaluateAircraft(double hoursRemaining, int criticalDefects, int minorDefects, int modelIndex) const;
+    quint16 evaluatePilot(int licenseDays, int medicalDays, int modelIndex) const;
+
+private:
+    friend class ReadinessRuleEngine;
+
+    // Колонки и пороги, с которыми работает программа
+    enum Column : quint8 { ColHours, ColCritical, ColMinor, ColLicense, ColMedical };
+    enum Slot : quint8 { SlotServiceSoon, SlotMaxMinor, SlotLicenseWarning, SlotCount };
+    enum Op : quint8 { OpLess, OpLessEq, OpGreater, OpGreaterEq };
+
+    // Одна инструкция: flags |= (column OP threshold) ? flag : 0
+    struct Instruction {
+        Column column;
+        Op op;
+        bool constant;     // Порог одинаков для всех моделей
+        double value;      // Значение постоянного порога
+        Slot slot;         // Иначе берется из таблицы по индексу модели
+        quint16 flag;
+    };
+
+    std::vector<ReadinessThresholds> m_thresholds;  // [0] - по умолчанию
+    std::vector<double> m_table;                    // [modelIndex * SlotCount + slot]
+    QHash<QUuid, int> m_modelIndex;
+    std::vector<Instruction> m_aircraftProgram;
+    std::vector<Instruction> m_pilotProgram;
+
+    void run(const std::vector<Instruction>& program, const double* const* columns,
+             const qint32* modelIndex, quint16* out, size_t count) const;
+};
+
+// Компилятор правил готовности
+class ReadinessRuleEngine {
+public:
+    // rules - записи из readiness_rules. Запись без modelId задает значения по умолчанию,
+    // если ее нет - используются встроенные (10 ч, 3 дефекта, 30 дней)
+    static std::shared_ptr<const CompiledRules> compile(const std::vector<ReadinessThresholds>& rules);
+
+    // Встроенные значения без обращения к БД (общий экземпляр)
+    static std::shared_ptr<const CompiledRules> defaults();
+};
+
+#endif // READINESSRULEENGINE_H
@@ -1,108 +1,269 @@
 #include "src/services/ReadinessService.h"
+#include "src/services/Trace.h"
+#include "src/services/Metrics.h"
+#include "src/services/ReadinessRuleEngine.h"
+#include "src/services/ParallelFor.h"
 #include <QVariant>
 #include <QDebug>
 
+namespace {
+// Вердикты проверок для метрики skyready_readiness_checks_total
+enum Verdict { VerdictGo, VerdictWarning, VerdictNoGo, VerdictCount };
+
+Verdict verdictOf(const ReadinessReport& report) {
+    if (!report.isReady) return VerdictNoGo;
+    return report.warnings.count > 0 ? VerdictWarning : VerdictGo;
+}
+
+MetricCounter& verdictCounter(int verdict) {
+    static const char* help = "Readiness evaluations, by verdict.";
+    static MetricCounter* counters[VerdictCount] = {
+        &Metrics::counter("skyready_readiness_checks_total", help, "verdict=\"go\""),
+        &Metrics::counter("skyready_readiness_checks_total", help, "verdict=\"warning\""),
+        &Metrics::counter("skyready_readiness_checks_total", help, "verdict=\"no_go\"")
+    };
+    return *counters[verdict];
+}
+}
+
 ReadinessService::ReadinessService() {
 }
 
 ReadinessReport ReadinessService::checkReadiness(QUuid aircraftId, QUuid pilotId, const FlightParams& params) {
+    TRACE_FUNCTION("service");
+    ReadinessContext context = loadContext(aircraftId);
+    Pilot pilot = m_pilotRepo.getById(pilotId);
+    return evaluate(context, pilot, params);
+}
+
+ReadinessContext ReadinessService::loadContext(QUuid aircraftId) {
+    TRACE_FUNCTION("service");
+    ReadinessContext context;
+
+    context.aircraft = m_aircraftRepo.getById(aircraftId);
+    if (!context.isLoaded()) {
+        return context;
+    }
+
+    context.model = m_modelRepo.getById(context.aircraft.modelId);
+    context.rules = loadRules();
+
+    // Один запрос вместо отдельных COUNT по критическим и мелким дефектам
+    context.defects = m_defectRepo.getByAircraftId(aircraftId);
+    for (const auto& d : context.defects) {
+        if (d.severity == "CRITICAL") context.criticalDefects++;
+        else if (d.severity == "MINOR") context.minorDefects++;
+    }
+
+    return context;
+}
+
+ReadinessReport ReadinessService::evaluate(const ReadinessContext& context, const Pilot& pilot, const FlightParams& params) {
+    ReadinessReport report = assess(context, pilot, params);
+    verdictCounter(verdictOf(report)).inc();
+    return report;
+}
+
+ReadinessReport ReadinessService::assess(const ReadinessContext& context, const Pilot& pilot, const FlightParams& params) {
     ReadinessReport report;
     report.isReady = true; // По умолчанию считаем, что готов, пока не найдем проблему
 
     // 1. Проверка самолёта
-    Aircraft aircraft = m_aircraftRepo.getById(aircraftId);
-    if (aircraft.id.isNull()) {
+    if (!context.isLoaded()) {
         report.isReady = false;
-        report.errors.append("Ошибка: Самолет не найден в базе данных.");
+        report.errors.add(IssueCode::AircraftNotFound);
         return report; // Дальше проверять нет смысла
     }
+    const Aircraft& aircraft = context.aircraft;
+
+    // Правила из контекста; если контекст собран без них - встроенные пороги
+    std::shared_ptr<const CompiledRules> rules = context.rules ? context.rules : ReadinessRuleEngine::defaults();
+    int modelIndex = rules->modelIndex(aircraft.modelId);
+    const ReadinessThresholds& thresholds = rules->thresholds(modelIndex);
 
     // Проверка ресурса двигателя
     // engineHoursNextService - это отметка, когда нужно делать ТО.
     // Остаток = NextService - Total
     double hoursRemaining = aircraft.engineHoursNextService - aircraft.engineHoursTotal;
+    int minorCount = context.minorDefects;
 
-    if (hoursRemaining <= 0) {
+    quint16 status = rules->evaluateAircraft(hoursRemaining, context.criticalDefects, minorCount, modelIndex);
+
+    if (status & AircraftEngineExhausted) {
         report.isReady = false;
-        report.errors.append(QString("Ресурс двигателя исчерпан! Переработка: %1 ч.").arg(qAbs(hoursRemaining)));
-    } else if (hoursRemaining < 10.0) {
-        report.warnings.append(QString("Внимание: Скоро ТО двигателя. Осталось %1 ч.").arg(hoursRemaining));
+        report.errors.add(IssueCode::EngineHoursExhausted, qAbs(hoursRemaining));
+    } else if (status & AircraftServiceSoon) {
+        report.warnings.add(IssueCode::EngineServiceSoon, hoursRemaining);
     }
 
     // 2. Проверка дефектов
-    if (m_defectRepo.hasCriticalDefects(aircraft.id)) {
+    if (status & AircraftCriticalDefect) {
         report.isReady = false;
-        report.errors.append("Запрет вылета: На борту есть КРИТИЧЕСКИЕ неисправности!");
+        report.errors.add(IssueCode::CriticalDefects, context.criticalDefects);
     }
 
-    int minorCount = m_defectRepo.countMinorDefects(aircraft.id);
-    if (minorCount >= 3) {
+    if (status & AircraftMinorLimit) {
         report.isReady = false;
-        report.errors.append(QString("Запрет вылета: Превышен лимит мелких неисправностей (%1 из 3 допустимых).").arg(minorCount));
-    } else if (minorCount > 0) {
-        report.warnings.append(QString("На борту имеются мелкие неисправности: %1 шт.").arg(minorCount));
+        report.errors.add(IssueCode::MinorDefectLimit, minorCount, thresholds.maxMinorDefects);
+    } else if (status & AircraftMinorDefects) {
+        report.warnings.add(IssueCode::MinorDefects, minorCount);
     }
 
     // 3. Проверка пилота
-    Pilot pilot = m_pilotRepo.getById(pilotId);
     if (pilot.id.isNull()) {
         report.isReady = false;
-        report.errors.append("Ошибка: Пилот не выбран или не найден.");
+        report.errors.add(IssueCode::PilotNotFound);
     } else {
         QDate today = QDate::currentDate();
 
+        // Дни до истечения документов (незаполненная дата считается истекшей)
+        int licenseDays = pilot.licenseExpiryDate.isValid() ? today.daysTo(pilot.licenseExpiryDate) : -1;
+        int medicalDays = pilot.medicalExpiryDate.isValid() ? today.daysTo(pilot.medicalExpiryDate) : -1;
+        quint16 pilotStatus = rules->evaluatePilot(licenseDays, medicalDays, modelIndex);
+
         // Лицензия
-        if (pilot.licenseExpiryDate < today) {
+        if (pilotStatus & PilotLicenseExpired) {
             report.isReady = false;
-            report.errors.append(QString("Лицензия пилота истекла %1").arg(pilot.licenseExpiryDate.toString("dd.MM.yyyy")));
-        } else if (pilot.licenseExpiryDate < today.addDays(30)) {
-            report.warnings.append("Срок действия лицензии пилота истекает менее чем через месяц.");
+            report.errors.add(IssueCode::LicenseExpired, pilot.licenseExpiryDate.toJulianDay());
+        } else if (pilotStatus & PilotLicenseSoon) {
+            report.warnings.add(IssueCode::LicenseExpiringSoon, licenseDays);
         }
 
         // Медицина (ВЛЭК)
-        if (pilot.medicalExpiryDate < today) {
+        if (pilotStatus & PilotMedicalExpired) {
             report.isReady = false;
-            report.errors.append("Медицинская справка пилота просрочена.");
+            report.errors.add(IssueCode::MedicalExpired);
         }
 
         // Допуск на тип (Type Rating)
         if (!pilot.allowedModels.contains(aircraft.modelId)) {
             report.isReady = false;
-            report.errors.append(QString("У пилота %1 нет допуска к управлению типом '%2'").arg(pilot.fullName, aircraft.modelName));
+            report.errors.add(IssueCode::NoTypeRating);
         }
     }
 
     // 4.Расчёт загрузки и топлива
 
-    // Нам нужно получить полные данные модели (вес, расход, конверт) для калькулятора
-    AircraftModel model = m_modelRepo.getById(aircraft.modelId);
+    // Полные данные модели (вес, расход, конверт) уже загружены в контекст
+    const AircraftModel& model = context.model;
 
     if (model.id.isNull()) {
         report.isReady = false;
-        report.errors.append("Ошибка данных: Не найдены характеристики модели самолета.");
+        report.errors.add(IssueCode::ModelNotFound);
     } else {
         // Запускаем математический расчет
         BalanceResult calcResult = m_calculator.calculate(model, aircraft, params);
 
-        // Собираем список отказавших систем
-        QStringList failedSystems;
-        if (!calcResult.isWeightOk) failedSystems << "Масса";
-        if (!calcResult.isCgOk) failedSystems << "Центровка";
-        if (!calcResult.isFuelOk) failedSystems << "Топливо";
+        // Маска отказавших систем
+        int failedSystems = 0;
+        if (!calcResult.isWeightOk) failedSystems |= CheckWeight;
+        if (!calcResult.isCgOk) failedSystems |= CheckCg;
+        if (!calcResult.isFuelOk) failedSystems |= CheckFuel;
 
-        if (!failedSystems.isEmpty()) {
+        if (failedSystems != 0) {
             // Если есть проблемы, формируем компактный отчет
             report.isReady = false;
 
             // 1. Заголовок с перечислением
-            report.errors.append("Нарушения ограничений: " + failedSystems.join(", "));
+            report.errors.add(IssueCode::LoadLimitsViolated, failedSystems);
 
-            // 2. Детальный текст (один раз)
-            if (!calcResult.message.isEmpty()) {
-                report.errors.append(calcResult.message);
+            // 2. Подробности по каждому ограничению
+            for (const Issue& issue : calcResult.issues) {
+                report.errors.add(issue.code, issue.values[0], issue.values[1], issue.values[2]);
             }
         }
     }
 
     return report;
 }
+
+std::vector<ReadinessContext> ReadinessService::loadFleetContexts() {
+    TRACE_FUNCTION("service");
+    std::vector<ReadinessContext> contexts;
+
+    std::vector<Aircraft> fleet = m_aircraftRepo.getAll();
+
+    QHash<QUuid, AircraftModel> models;
+    for (const AircraftModel& m : m_modelRepo.getAll()) {
+        models.insert(m.id, m);
+    }
+
+    QHash<QUuid, DefectCounts> defects = m_defectRepo.getDefectCountsByAircraft();
+
+    // Правила общие для всех контекстов (компилируются один раз)
+    std::shared_ptr<const CompiledRules> rules = loadRules();
+
+    contexts.resize(fleet.size());
+    for (size_t i = 0; i < fleet.size(); ++i) {
+        ReadinessContext& context = contexts[i];
+        context.aircraft = fleet[i];
+        context.model = models.value(fleet[i].modelId);
+        context.rules = rules;
+
+        DefectCounts counts = defects.value(fleet[i].id);
+        context.criticalDefects = counts.critical;
+        context.minorDefects = counts.minor;
+    }
+    return contexts;
+}
+
+void ReadinessService::evaluateBatch(const std::vector<ReadinessCheck>& checks, std::vector<ReadinessReport>& reports) {
+    TRACE_FUNCTION("service");
+    static const ReadinessContext missingContext{};
+    static const Pilot missingPilot{};
+
+    reports.resize(checks.size());
+
+    // evaluate читает только контекст и калькулятор без состояния - блоки независимы
+    // Вердикты считаются по блоку и добавляются в метрику один раз на блок
+    ParallelFor::run(checks.size(), 512, [&](size_t from, size_t to) {
+        quint64 verdicts[VerdictCount] = {};
+        for (size_t i = from; i < to; ++i) {
+            const ReadinessCheck& check = checks[i];
+            reports[i] = assess(check.context ? *check.context : missingContext,
+                                check.pilot ? *check.pilot : missingPilot,
+                                check.params);
+            verdicts[verdictOf(reports[i])]++;
+        }
+        for (int v = 0; v < VerdictCount; ++v) {
+            if (verdicts[v]) verdictCounter(v).inc(verdicts[v]);
+        }
+    });
+}
+
+std::vector<FleetCandidate> ReadinessService::rankFleetForMission(const MissionRequest& mission) {
+    TRACE_FUNCTION("service");
+    // Четыре запроса на весь флот: борта, модели, сводка дефектов и пороги
+    std::vector<Aircraft> fleet = m_aircraftRepo.getAll();
+
+    QHash<QUuid, AircraftModel> models;
+    for (const AircraftModel& m : m_modelRepo.getAll()) {
+        models.insert(m.id, m);
+    }
+
+    QHash<QUuid, DefectCounts> defects = m_defectRepo.getDefectCountsByAircraft();
+
+    return m_solver.rankFleet(fleet, models, defects, *loadRules(), mission);
+}
+
+DispatchPlan ReadinessService::planDispatch(const std::vector<MissionRequest>& missions, const QDate& day,
+                                           std::vector<Aircraft>& fleet, std::vector<Pilot>& pilots) {
+    TRACE_FUNCTION("service");
+    // Пять запросов на весь день, дальше расчет только в памяти
+    fleet = m_aircraftRepo.getAll();
+    pilots = m_pilotRepo.getAll();
+
+    QHash<QUuid, AircraftModel> models;
+    for (const AircraftModel& m : m_modelRepo.getAll()) {
+        models.insert(m.id, m);
+    }
+
+    QHash<QUuid, DefectCounts> defects = m_defectRepo.getDefectCountsByAircraft();
+
+    return m_planner.plan(missions, fleet, models, defects, pilots, *loadRules(), day);
+}
+
+std::shared_ptr<const CompiledRules> ReadinessService::loadRules() {
+    TRACE_FUNCTION("service");
+    return ReadinessRuleEngine::compile(m_ruleRepo.getAll());
+}
@@ -7,6 +7,17 @@
 #include "src/repositories/DefectRepository.h"
 #include "src/services/WeightCalculator.h"
 #include "src/repositories/AircraftModelRepository.h"
+#include "src/services/LoadSolver.h"
+#include "src/services/DispatchPlanner.h"
+#include "src/repositories/ReadinessRuleRepository.h"
+
+// Одна проверка пакета: контекст борта и пилот принадлежат вызывающему
+// (nullptr - борт или пилот не найден)
+struct ReadinessCheck {
+    const ReadinessContext* context = nullptr;
+    const Pilot* pilot = nullptr;
+    FlightParams params;
+};
 
 // Этот класс отвечает за принятие решения "Готов / Не готов"
 class ReadinessService {
@@ -14,12 +25,42 @@ public:
     ReadinessService();
     ReadinessReport checkReadiness(QUuid aircraftId, QUuid pilotId, const FlightParams& params);  // Комплексная проверка перед вылетом
 
+    // Загрузка из БД всего, что нужно для проверки борта (самолет, модель, дефекты)
+    ReadinessContext loadContext(QUuid aircraftId);
+
+    // Проверка по уже загруженному контексту. Не обращается к БД
+    ReadinessReport evaluate(const ReadinessContext& context, const Pilot& pilot, const FlightParams& params);
+
+    // Контексты всего флота за четыре запроса (вместо списков дефектов - только счетчики).
+    // Результат в порядке AircraftRepository::getAll
+    std::vector<ReadinessContext> loadFleetContexts();
+
+    // Пакетная проверка по загруженным контекстам, параллельно на пуле потоков.
+    // reports[i] соответствует checks[i]. Не обращается к БД
+    void evaluateBatch(const std::vector<ReadinessCheck>& checks, std::vector<ReadinessReport>& reports);
+
+    // Распределение бортов и пилотов по заданиям дня (списки нужны для вывода плана)
+    DispatchPlan planDispatch(const std::vector<MissionRequest>& missions, const QDate& day,
+                              std::vector<Aircraft>& fleet, std::vector<Pilot>& pilots);
+
+    // Пороги готовности из readiness_rules, скомпилированные в программу
+    std::shared_ptr<const CompiledRules> loadRules();
+
+    // Исправные борта флота, отсортированные по запасу загрузки для задания
+    std::vector<FleetCandidate> rankFleetForMission(const MissionRequest& mission);
+
 private:
+    // Сама проверка (evaluate добавляет учет вердикта в метриках)
+    ReadinessReport assess(const ReadinessContext& context, const Pilot& pilot, const FlightParams& params);
+
     AircraftRepository m_aircraftRepo;
     PilotRepository m_pilotRepo;
     DefectRepository m_defectRepo;
     WeightCalculator m_calculator;
     AircraftModelRepository m_modelRepo;
+    LoadSolver m_solver;
+    DispatchPlanner m_planner;
+    ReadinessRuleRepository m_ruleRepo;
 };
 
 #endif // READINESSSERVICE_H
@@ -0,0 +1,111 @@
+#include "src/services/ReadinessText.h"
+#include "src/services/WeightCalculator.h"
+#include <QDate>
+#include <QJsonArray>
+
+namespace {
+QJsonArray issuesToJson(const IssueList& issues, const QString& pilotName, const QString& modelName) {
+    QJsonArray list;
+    for (const Issue& issue : issues) {
+        QJsonObject item;
+        item.insert("code", ReadinessText::codeName(issue.code));
+        item.insert("message", ReadinessText::describe(issue, pilotName, modelName));
+        list.append(item);
+    }
+    return list;
+}
+}
+
+QString ReadinessText::describe(const Issue& issue, const QString& pilotName, const QString& modelName) {
+    const double* v = issue.values;
+
+    switch (issue.code) {
+    case IssueCode::AircraftNotFound:
+        return "Ошибка: Самолет не найден в базе данных.";
+    case IssueCode::EngineHoursExhausted:
+        return QString("Ресурс двигателя исчерпан! Переработка: %1 ч.").arg(v[0]);
+    case IssueCode::EngineServiceSoon:
+        return QString("Внимание: Скоро ТО двигателя. Осталось %1 ч.").arg(v[0]);
+    case IssueCode::CriticalDefects:
+        return "Запрет вылета: На борту есть КРИТИЧЕСКИЕ неисправности!";
+    case IssueCode::MinorDefectLimit:
+        return QString("Запрет вылета: Превышен лимит мелких неисправностей (%1 из %2 допустимых).")
+                .arg((int)v[0]).arg((int)v[1]);
+    case IssueCode::MinorDefects:
+        return QString("На борту имеются мелкие неисправности: %1 шт.").arg((int)v[0]);
+    case IssueCode::PilotNotFound:
+        return "Ошибка: Пилот не выбран или не найден.";
+    case IssueCode::LicenseExpired:
+        return QString("Лицензия пилота истекла %1")
+                .arg(QDate::fromJulianDay((qint64)v[0]).toString("dd.MM.yyyy"));
+    case IssueCode::LicenseExpiringSoon:
+        return "Срок действия лицензии пилота истекает менее чем через месяц.";
+    case IssueCode::MedicalExpired:
+        return "Медицинская справка пилота просрочена.";
+    case IssueCode::NoTypeRating:
+        return QString("У пилота %1 нет допуска к управлению типом '%2'").arg(pilotName, modelName);
+    case IssueCode::ModelNotFound:
+        return "Ошибка данных: Не найдены характеристики модели самолета.";
+    case IssueCode::LoadLimitsViolated: {
+        int mask = (int)v[0];
+        QStringList failedSystems;
+        if (mask & CheckWeight) failedSystems << "Масса";
+        if (mask & CheckCg) failedSystems << "Центровка";
+        if (mask & CheckFuel) failedSystems << "Топливо";
+        return "Нарушения ограничений: " + failedSystems.join(", ");
+    }
+    case IssueCode::Overweight:
+        return QString("Перегруз! Текущий вес: %1 кг (Макс: %2).").arg(v[0]).arg(v[1]);
+    case IssueCode::FuelInsufficient:
+        return QString("Мало топлива! Нужно: %1 л (с запасом), В баках: %2 л.")
+                .arg(QString::number(v[0], 'f', 1))
+                .arg(v[1]);
+    case IssueCode::FuelOverCapacity:
+        return QString("Топлива больше объема баков! Баки: %1 л.").arg(v[0]);
+    case IssueCode::CgOutOfEnvelope:
+        return QString("Нарушена центровка! CG: %1 (Допуск: %2-%3).")
+                .arg(QString::number(v[0], 'f', 1))
+                .arg(v[1])
+                .arg(v[2]);
+    }
+    return QString();
+}
+
+const char* ReadinessText::codeName(IssueCode code) {
+    switch (code) {
+    case IssueCode::AircraftNotFound:     return "AIRCRAFT_NOT_FOUND";
+    case IssueCode::EngineHoursExhausted: return "ENGINE_HOURS_EXHAUSTED";
+    case IssueCode::EngineServiceSoon:    return "ENGINE_SERVICE_SOON";
+    case IssueCode::CriticalDefects:      return "CRITICAL_DEFECTS";
+    case IssueCode::MinorDefectLimit:     return "MINOR_DEFECT_LIMIT";
+    case IssueCode::MinorDefects:         return "MINOR_DEFECTS";
+    case IssueCode::PilotNotFound:        return "PILOT_NOT_FOUND";
+    case IssueCode::LicenseExpired:       return "LICENSE_EXPIRED";
+    case IssueCode::LicenseExpiringSoon:  return "LICENSE_EXPIRING_SOON";
+    case IssueCode::MedicalExpired:       return "MEDICAL_EXPIRED";
+    case IssueCode::NoTypeRating:         return "NO_TYPE_RATING";
+    case IssueCode::ModelNotFound:        return "MODEL_NOT_FOUND";
+    case IssueCode::LoadLimitsViolated:   return "LOAD_LIMITS_VIOLATED";
+    case IssueCode::Overweight:           return "OVERWEIGHT";
+    case IssueCode::FuelInsufficient:     return "FUEL_INSUFFICIENT";
+    case IssueCode::FuelOverCapacity:     return "FUEL_OVER_CAPACITY";
+    case IssueCode::CgOutOfEnvelope:      return "CG_OUT_OF_ENVELOPE";
+    }
+    return "UNKNOWN";
+}
+
+QJsonObject ReadinessText::reportToJson(const ReadinessReport& report, const QString& pilotName, const QString& modelName) {
+    QJsonObject obj;
+    obj.insert("ready", report.isReady);
+    obj.insert("errors", issuesToJson(report.errors, pilotName, modelName));
+    obj.insert("warnings", issuesToJson(report.warnings, pilotName, modelName));
+    return obj;
+}
+
+QStringList ReadinessText::describeAll(const IssueList& issues, const QString& pilotName, const QString& modelName) {
+    QStringList list;
+    for (const Issue& issue : issues) {
+        list.append(describe(issue, pilotName, modelName));
+    }
+    return list;
+}
@@ -0,0 +1,32 @@
+#ifndef READINESSTEXT_H
+#define READINESSTEXT_H
+
+#include "src/models/Entities.h"
+#include <QString>
+#include <QStringList>
+#include <QJsonObject>
+
+// Перевод кодов проверки в текст для пользователя.
+// Вызывается только при показе результата, а не при каждом расчете
+class ReadinessText {
+public:
+    // pilotName и modelName нужны для сообщения о допуске на тип
+    static QString describe(const Issue& issue,
+                            const QString& pilotName = QString(),
+                            const QString& modelName = QString());
+
+    // Постоянное машинное имя кода (для пакетного режима и API), например "CRITICAL_DEFECTS"
+    static const char* codeName(IssueCode code);
+
+    // Отчет проверки в JSON (пакетный режим, HTTP API):
+    // {"ready": bool, "errors": [{"code", "message"}], "warnings": [...]}
+    static QJsonObject reportToJson(const ReadinessReport& report,
+                                    const QString& pilotName = QString(),
+                                    const QString& modelName = QString());
+
+    static QStringList describeAll(const IssueList& issues,
+                                   const QString& pilotName = QString(),
+                                   const QString& modelName = QString());
+};
+
+#endif // READINESSTEXT_H
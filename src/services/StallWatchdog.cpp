@@ -0,0 +1,174 @@
+#include "src/services/StallWatchdog.h"
+#include "src/services/Metrics.h"
+#include <QMetaObject>
+#include <QStringList>
+#include <QDebug>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace {
+// Снимков стека за одно зависание (дальше держатель уже ясен)
+const size_t MaxSamples = 256;
+
+const char* s_noSpan = "(без интервала)";
+}
+
+StallWatchdog::StallWatchdog(QObject *target, int thresholdMs)
+    : m_target(target),
+      m_stack(Trace::currentStack()),
+      m_thresholdMs(qMax(1, thresholdMs)),
+      m_ping(std::make_shared<PingState>())
+{
+    Trace::retainTracking();
+    m_thread = std::thread([this] { run(); });
+}
+
+StallWatchdog::~StallWatchdog() {
+    {
+        std::lock_guard<std::mutex> lock(m_stopMutex);
+        m_stop = true;
+    }
+    m_stopCondition.notify_all();
+    m_thread.join();
+    Trace::releaseTracking();
+}
+
+void StallWatchdog::run() {
+    const qint64 thresholdNs = qint64(m_thresholdMs) * 1000000;
+    // Опрос в несколько раз чаще порога: стек снимается, пока поток еще занят
+    const int pollMs = qBound(2, m_thresholdMs / 5, 50);
+
+    quint64 seq = 0;
+    qint64 sentNs = 0;
+    bool outstanding = false;
+    std::vector<std::vector<Trace::ActiveSpan>> samples;
+    std::vector<qint64> sampleTimes;
+
+    std::unique_lock<std::mutex> lock(m_stopMutex);
+    while (!m_stop) {
+        lock.unlock();
+
+        qint64 now = Trace::nowNs();
+        if (!outstanding) {
+            seq++;
+            sentNs = now;
+            outstanding = true;
+            samples.clear();
+            sampleTimes.clear();
+
+            std::shared_ptr<PingState> ping = m_ping;
+            quint64 sent = seq;
+            QMetaObject::invokeMethod(m_target, [ping, sent]() {
+                ping->answeredNs.store(Trace::nowNs(), std::memory_order_relaxed);
+                ping->answeredSeq.store(sent, std::memory_order_release);
+            }, Qt::QueuedConnection);
+        } else if (m_ping->answeredSeq.load(std::memory_order_acquire) == seq) {
+            qint64 lagNs = m_ping->answeredNs.load(std::memory_order_relaxed) - sentNs;
+            if (lagNs >= thresholdNs) recordStall(lagNs, samples, sampleTimes);
+            outstanding = false;
+        } else if (now - sentNs >= thresholdNs && samples.size() < MaxSamples) {
+            samples.push_back(Trace::activeSpans(m_stack));
+            sampleTimes.push_back(now);
+        }
+
+        lock.lock();
+        m_stopCondition.wait_for(lock, std::chrono::milliseconds(pollMs), [this] { return m_stop; });
+    }
+}
+
+void StallWatchdog::recordStall(qint64 durationNs, const std::vector<std::vector<Trace::ActiveSpan>>& samples,
+                                const std::vector<qint64>& sampleTimes) {
+    static MetricCounter& stalls = Metrics::counter("skyready_ui_stalls_total",
+                                                    "Event loop stalls longer than the watchdog threshold.");
+    static MetricHistogram& stallTime = Metrics::histogram("skyready_ui_stall_seconds",
+                                                           "Duration of event loop stalls.");
+    stalls.inc();
+    stallTime.observeNs(durationNs);
+    m_stallCount.fetch_add(1, std::memory_order_relaxed);
+
+    // Держатель в каждом снимке - самый внутренний метод репозитория (запрос),
+    // иначе самый внутренний интервал. Итог - держатель большинства снимков
+    QString slot;
+    QString stack;
+    QHash<QString, int> votes;
+    QHash<QString, qint64> heldNs;
+    for (size_t i = 0; i < samples.size(); ++i) {
+        const std::vector<Trace::ActiveSpan>& spans = samples[i];
+        if (spans.empty()) continue;
+
+        if (slot.isEmpty()) slot = Trace::displayName(spans.front().name);
+
+        const Trace::ActiveSpan* holder = &spans.back();
+        for (auto it = spans.rbegin(); it != spans.rend(); ++it) {
+            if (it->category && std::strcmp(it->category, "repository") == 0) {
+                holder = &*it;
+                break;
+            }
+        }
+        QString name = Trace::displayName(holder->name);
+        votes[name]++;
+        heldNs[name] = qMax(heldNs.value(name), sampleTimes[i] - holder->startNs);
+
+        QStringList names;
+        for (const Trace::ActiveSpan& span : spans) names << Trace::displayName(span.name);
+        stack = names.join(" > ");
+    }
+
+    QString blocker;
+    int bestVotes = 0;
+    for (auto it = votes.constBegin(); it != votes.constEnd(); ++it) {
+        if (it.value() > bestVotes) {
+            bestVotes = it.value();
+            blocker = it.key();
+        }
+    }
+    if (slot.isEmpty()) slot = s_noSpan;
+    if (blocker.isEmpty()) blocker = s_noSpan;
+
+    qDebug() << "StallWatchdog: event loop blocked" << durationNs / 1000000 << "ms in"
+             << (stack.isEmpty() ? QString(s_noSpan) : stack);
+
+    std::lock_guard<std::mutex> lock(m_sitesMutex);
+    StallSite& site = m_sites[slot + '\n' + blocker];
+    site.slot = slot;
+    site.blocker = blocker;
+    if (!stack.isEmpty()) site.stack = stack;
+    site.count++;
+    site.totalNs += durationNs;
+    site.maxNs = qMax(site.maxNs, durationNs);
+    site.maxBlockerNs = qMax(site.maxBlockerNs, heldNs.value(blocker));
+}
+
+std::vector<StallWatchdog::StallSite> StallWatchdog::sites() const {
+    std::vector<StallSite> list;
+    {
+        std::lock_guard<std::mutex> lock(m_sitesMutex);
+        for (const StallSite& site : m_sites) list.push_back(site);
+    }
+    std::sort(list.begin(), list.end(), [](const StallSite& a, const StallSite& b) {
+        return a.totalNs > b.totalNs;
+    });
+    return list;
+}
+
+QString StallWatchdog::report() const {
+    std::vector<StallSite> list = sites();
+
+    QString text = QString("Зависаний цикла событий дольше %1 мс: %2\n").arg(m_thresholdMs).arg(stallCount());
+    if (list.empty()) return text;
+
+    text += QString("\n%1 %2 %3 %4  %5\n")
+                .arg("Раз", 6).arg("Всего, мс", 10).arg("Макс, мс", 9).arg("В держателе, мс", 16)
+                .arg("Слот -> держатель");
+    for (const StallSite& site : list) {
+        text += QString("%1 %2 %3 %4  %5 -> %6\n")
+                    .arg(site.count, 6)
+                    .arg(site.totalNs / 1000000, 10)
+                    .arg(site.maxNs / 1000000, 9)
+                    .arg(site.maxBlockerNs / 1000000, 16)
+                    .arg(site.slot, site.blocker);
+        if (!site.stack.isEmpty()) text += QString("%1  %2\n").arg(QString(), 44).arg(site.stack);
+    }
+    return text;
+}
@@ -0,0 +1,75 @@
+#ifndef STALLWATCHDOG_H
+#define STALLWATCHDOG_H
+
+#include <QObject>
+#include <QString>
+#include <QHash>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "src/services/Trace.h"
+
+// Сторож цикла событий. Отдельный поток ставит в очередь наблюдаемого потока
+// (обычно GUI) пустое задание и ждет его выполнения. Если ответа нет дольше
+// порога, поток занят: сторож снимает стек активных интервалов (Trace) и после
+// освобождения записывает зависание - слот, метод репозитория или запрос,
+// на котором он стоял, и длительность. Повторы одного места складываются.
+// Создается в наблюдаемом потоке; на время работы включает отслеживание интервалов
+class StallWatchdog {
+public:
+    // Место зависания: внешний интервал UI и то, что его держало
+    struct StallSite {
+        QString slot;       // Внешний интервал ("MainWindow::onRefreshBtnClicked")
+        QString blocker;    // Метод репозитория или самый внутренний интервал
+        QString stack;      // Последний снятый стек целиком
+        int count = 0;
+        qint64 totalNs = 0;
+        qint64 maxNs = 0;
+        qint64 maxBlockerNs = 0;  // Самое долгое пребывание в blocker на момент снятия стека
+    };
+
+    // target - любой объект наблюдаемого потока (через него ставятся пинги)
+    StallWatchdog(QObject *target, int thresholdMs = 50);
+    ~StallWatchdog();
+
+    int thresholdMs() const { return m_thresholdMs; }
+    quint64 stallCount() const { return m_stallCount.load(std::memory_order_relaxed); }
+
+    // Места по убыванию суммарного времени зависаний
+    std::vector<StallSite> sites() const;
+
+    // Отчет для человека (таблица мест)
+    QString report() const;
+
+private:
+    // Ответ наблюдаемого потока на пинг; общий с заданиями в очереди,
+    // поэтому переживает сторожа, если задание выполнится после него
+    struct PingState {
+        std::atomic<quint64> answeredSeq{0};
+        std::atomic<qint64> answeredNs{0};
+    };
+
+    void run();
+    void recordStall(qint64 durationNs, const std::vector<std::vector<Trace::ActiveSpan>>& samples,
+                     const std::vector<qint64>& sampleTimes);
+
+    QObject *m_target;
+    const Trace::ActiveStack* m_stack;
+    int m_thresholdMs;
+
+    std::shared_ptr<PingState> m_ping;
+    std::atomic<quint64> m_stallCount{0};
+
+    mutable std::mutex m_sitesMutex;
+    QHash<QString, StallSite> m_sites;  // Ключ - slot + blocker
+
+    std::mutex m_stopMutex;
+    std::condition_variable m_stopCondition;
+    bool m_stop = false;
+    std::thread m_thread;
+};
+
+#endif // STALLWATCHDOG_H
@@ -0,0 +1,264 @@
+#include "src/services/Trace.h"
+#include <QCoreApplication>
+#include <QFile>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QThread>
+#include <QDebug>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+struct TraceEvent {
+    const char* category = nullptr;
+    const char* name = nullptr;
+    qint64 startNs = 0;
+    qint64 durationNs = 0;
+    QByteArray detail;
+};
+
+// Кольцо одного потока. Мьютекс берет только сам поток при записи и выгрузка,
+// поэтому на горячем пути он не конкурирует
+struct ThreadBuffer {
+    std::mutex mutex;
+    std::vector<TraceEvent> events;
+    size_t next = 0;       // Позиция следующей записи
+    bool wrapped = false;  // Кольцо заполнялось целиком
+    int threadId = 0;
+    QString threadName;
+};
+
+// Буферы переживают свои потоки (пул, рабочие потоки сервера), чтобы их
+// интервалы попали в выгрузку; удаляются в clear()
+std::mutex s_registryMutex;
+std::vector<std::shared_ptr<ThreadBuffer>> s_buffers;
+int s_nextThreadId = 1;
+
+thread_local std::shared_ptr<ThreadBuffer> t_buffer;
+thread_local Trace::ActiveStack t_activeStack;
+
+ThreadBuffer& currentBuffer() {
+    if (!t_buffer) {
+        std::shared_ptr<ThreadBuffer> buffer = std::make_shared<ThreadBuffer>();
+        buffer->events.resize(Trace::EventsPerThread);
+
+        QThread* thread = QThread::currentThread();
+        buffer->threadName = thread->objectName();
+
+        std::lock_guard<std::mutex> lock(s_registryMutex);
+        buffer->threadId = s_nextThreadId++;
+        if (buffer->threadName.isEmpty()) {
+            bool isMain = QCoreApplication::instance() && QCoreApplication::instance()->thread() == thread;
+            buffer->threadName = isMain ? QString("main") : QString("thread %1").arg(buffer->threadId);
+        }
+        s_buffers.push_back(buffer);
+        t_buffer = buffer;
+    }
+    return *t_buffer;
+}
+
+}
+
+namespace Trace {
+
+namespace detail {
+std::atomic<int> state(0);
+}
+
+void setEnabled(bool on) {
+    if (on) detail::state.fetch_or(1, std::memory_order_relaxed);
+    else detail::state.fetch_and(~1, std::memory_order_relaxed);
+}
+
+void retainTracking() {
+    detail::state.fetch_add(2, std::memory_order_relaxed);
+}
+
+void releaseTracking() {
+    detail::state.fetch_sub(2, std::memory_order_relaxed);
+}
+
+void clear() {
+    std::lock_guard<std::mutex> registryLock(s_registryMutex);
+    std::vector<std::shared_ptr<ThreadBuffer>> alive;
+    for (const std::shared_ptr<ThreadBuffer>& buffer : s_buffers) {
+        // Единственная ссылка у реестра - поток уже завершился
+        if (buffer.use_count() == 1) continue;
+        std::lock_guard<std::mutex> lock(buffer->mutex);
+        for (TraceEvent& event : buffer->events) event.detail.clear();
+        buffer->next = 0;
+        buffer->wrapped = false;
+        alive.push_back(buffer);
+    }
+    s_buffers.swap(alive);
+}
+
+qint64 nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void record(const char* category, const char* name, qint64 startNs, qint64 endNs, const QByteArray& detail) {
+    ThreadBuffer& buffer = currentBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+
+    TraceEvent& event = buffer.events[buffer.next];
+    event.category = category;
+    event.name = name;
+    event.startNs = startNs;
+    event.durationNs = endNs - startNs;
+    event.detail = detail;
+
+    if (++buffer.next == buffer.events.size()) {
+        buffer.next = 0;
+        buffer.wrapped = true;
+    }
+}
+
+const ActiveStack* currentStack() {
+    return &t_activeStack;
+}
+
+std::vector<ActiveSpan> activeSpans(const ActiveStack* stack) {
+    std::vector<ActiveSpan> spans;
+    int depth = qMin(stack->depth.load(std::memory_order_acquire), MaxActiveDepth);
+    for (int i = 0; i < depth; ++i) {
+        const ActiveFrame& frame = stack->frames[i];
+        ActiveSpan span;
+        span.category = frame.category.load(std::memory_order_relaxed);
+        span.name = frame.name.load(std::memory_order_relaxed);
+        span.startNs = frame.startNs.load(std::memory_order_relaxed);
+        if (span.name) spans.push_back(span);
+    }
+    return spans;
+}
+
+const char* innermost(const char* category) {
+    int depth = qMin(t_activeStack.depth.load(std::memory_order_relaxed), MaxActiveDepth);
+    for (int i = depth - 1; i >= 0; --i) {
+        const ActiveFrame& frame = t_activeStack.frames[i];
+        if (std::strcmp(frame.category.load(std::memory_order_relaxed), category) == 0) {
+            return frame.name.load(std::memory_order_relaxed);
+        }
+    }
+    return nullptr;
+}
+
+QString displayName(const char* name) {
+    QString full = QString::fromLatin1(name);
+    int paren = full.indexOf('(');
+    if (paren < 0) return full;
+    int space = full.lastIndexOf(' ', paren);
+    return full.mid(space + 1, paren - space - 1);
+}
+
+QByteArray toChromeJson() {
+    // Копия под блокировками, разбор - без них
+    struct Snapshot {
+        int threadId;
+        QString threadName;
+        std::vector<TraceEvent> events;
+    };
+    std::vector<Snapshot> snapshots;
+    {
+        std::lock_guard<std::mutex> registryLock(s_registryMutex);
+        for (const std::shared_ptr<ThreadBuffer>& buffer : s_buffers) {
+            std::lock_guard<std::mutex> lock(buffer->mutex);
+            Snapshot snapshot;
+            snapshot.threadId = buffer->threadId;
+            snapshot.threadName = buffer->threadName;
+            if (buffer->wrapped) {
+                snapshot.events.assign(buffer->events.begin() + buffer->next, buffer->events.end());
+            }
+            snapshot.events.insert(snapshot.events.end(), buffer->events.begin(), buffer->events.begin() + buffer->next);
+            snapshots.push_back(std::move(snapshot));
+        }
+    }
+
+    // Время отсчитывается от самого раннего интервала
+    qint64 originNs = 0;
+    bool haveOrigin = false;
+    for (const Snapshot& snapshot : snapshots) {
+        for (const TraceEvent& event : snapshot.events) {
+            if (!haveOrigin || event.startNs < originNs) originNs = event.startNs;
+            haveOrigin = true;
+        }
+    }
+
+    qint64 pid = QCoreApplication::applicationPid();
+    QHash<const char*, QString> names;
+    QJsonArray traceEvents;
+
+    for (const Snapshot& snapshot : snapshots) {
+        QJsonObject meta;
+        meta["name"] = "thread_name";
+        meta["ph"] = "M";
+        meta["pid"] = pid;
+        meta["tid"] = snapshot.threadId;
+        meta["args"] = QJsonObject{ { "name", snapshot.threadName } };
+        traceEvents.append(meta);
+
+        for (const TraceEvent& event : snapshot.events) {
+            auto cached = names.find(event.name);
+            if (cached == names.end()) cached = names.insert(event.name, displayName(event.name));
+
+            // Полные события ("X"), время в микросекундах
+            QJsonObject obj;
+            obj["name"] = cached.value();
+            obj["cat"] = QString::fromLatin1(event.category);
+            obj["ph"] = "X";
+            obj["ts"] = (event.startNs - originNs) / 1000.0;
+            obj["dur"] = event.durationNs / 1000.0;
+            obj["pid"] = pid;
+            obj["tid"] = snapshot.threadId;
+            if (!event.detail.isEmpty()) {
+                obj["args"] = QJsonObject{ { "detail", QString::fromUtf8(event.detail) } };
+            }
+            traceEvents.append(obj);
+        }
+    }
+
+    QJsonObject root;
+    root["traceEvents"] = traceEvents;
+    root["displayTimeUnit"] = "ms";
+    return QJsonDocument(root).toJson(QJsonDocument::Compact);
+}
+
+bool exportChromeJson(const QString& path) {
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qDebug() << "Trace: cannot write" << path << ":" << file.errorString();
+        return false;
+    }
+    return file.write(toChromeJson()) >= 0;
+}
+
+} // namespace Trace
+
+void TraceScope::begin(int state, const char* name) {
+    m_name = name;
+    m_record = state & 1;
+    m_startNs = Trace::nowNs();
+
+    // Кадр заполняется до увеличения глубины: читатель не увидит пустой кадр
+    Trace::ActiveStack& stack = t_activeStack;
+    int depth = stack.depth.load(std::memory_order_relaxed);
+    if (depth < Trace::MaxActiveDepth) {
+        Trace::ActiveFrame& frame = stack.frames[depth];
+        frame.category.store(m_category, std::memory_order_relaxed);
+        frame.name.store(name, std::memory_order_relaxed);
+        frame.startNs.store(m_startNs, std::memory_order_relaxed);
+    }
+    stack.depth.store(depth + 1, std::memory_order_release);
+}
+
+void TraceScope::end() {
+    t_activeStack.depth.fetch_sub(1, std::memory_order_release);
+    if (m_record) Trace::record(m_category, m_name, m_startNs, Trace::nowNs(), m_detail);
+}
@@ -0,0 +1,134 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <QByteArray>
+#include <QString>
+#include <atomic>
+#include <vector>
+
+// Трассировка интервалов выполнения (span) для разбора медленных действий:
+// слот окна -> сервис -> метод репозитория -> SQL-запрос.
+// Законченные интервалы пишутся в кольцевой буфер своего потока (старые
+// затираются), выгрузка - в формате Chrome trace (chrome://tracing, ui.perfetto.dev).
+// Кроме записи интервалы могут только отслеживаться: стек активных интервалов
+// потока нужен метрикам (запросы по методам репозиториев) и без записи в буфер.
+// Выключенная трассировка стоит одного чтения атомарного флага на интервал;
+// сборка с DEFINES+=SKYREADY_NO_TRACE убирает интервалы из кода совсем.
+//
+//   void FleetService::commitFlight(...) {
+//       TRACE_FUNCTION("service");
+//       ...
+namespace Trace {
+
+// Интервалов в буфере каждого потока (при переполнении остаются последние)
+const int EventsPerThread = 16384;
+
+// Глубина отслеживаемого стека (более глубокие интервалы не видны в стеке)
+const int MaxActiveDepth = 32;
+
+namespace detail {
+// Бит 0 - запись в буфер, старшие биты - число пользователей отслеживания
+extern std::atomic<int> state;
+}
+
+#ifdef SKYREADY_NO_TRACE
+inline int state() { return 0; }  // Интервалы вырезаются компилятором
+#else
+inline int state() { return detail::state.load(std::memory_order_relaxed); }
+#endif
+inline bool isEnabled() { return state() & 1; }
+void setEnabled(bool on);
+
+// Отслеживание активных интервалов без записи (парные вызовы от каждого пользователя)
+void retainTracking();
+void releaseTracking();
+
+// Удаляет записанные интервалы (и буферы завершившихся потоков)
+void clear();
+
+// Монотонное время, нс
+qint64 nowNs();
+
+// Законченный интервал в буфер текущего потока. category и name должны жить
+// до выгрузки (строковые литералы, Q_FUNC_INFO), detail копируется
+void record(const char* category, const char* name, qint64 startNs, qint64 endNs,
+            const QByteArray& detail = QByteArray());
+
+// Стек активных интервалов потока. Пишет только сам поток; другие потоки
+// читают его без блокировок и могут увидеть кадр в момент смены
+struct ActiveFrame {
+    std::atomic<const char*> category{nullptr};
+    std::atomic<const char*> name{nullptr};
+    std::atomic<qint64> startNs{0};
+};
+
+struct ActiveStack {
+    ActiveFrame frames[MaxActiveDepth];
+    std::atomic<int> depth{0};
+};
+
+struct ActiveSpan {
+    const char* category;
+    const char* name;
+    qint64 startNs;
+};
+
+// Стек текущего потока (указатель действителен, пока поток жив)
+const ActiveStack* currentStack();
+
+// Снимок стека, от внешнего интервала к внутреннему
+std::vector<ActiveSpan> activeSpans(const ActiveStack* stack);
+
+// Имя ближайшего активного интервала категории category в текущем потоке
+const char* innermost(const char* category);
+
+// "std::vector<Aircraft> AircraftRepository::getAll()" -> "AircraftRepository::getAll"
+QString displayName(const char* name);
+
+// Все буферы в формате Chrome trace JSON ({"traceEvents": [...]})
+QByteArray toChromeJson();
+bool exportChromeJson(const QString& path);
+
+} // namespace Trace
+
+// Интервал от создания до выхода из области видимости
+class TraceScope {
+public:
+    TraceScope(const char* category, const char* name)
+        : m_category(category)
+    {
+        int state = Trace::state();
+        if (state) begin(state, name);
+    }
+
+    ~TraceScope() {
+        if (m_name) end();
+    }
+
+    // Подробность в args интервала (например, текст SQL); только при записи
+    bool active() const { return m_record; }
+    void setDetail(const QByteArray& detail) { if (m_record) m_detail = detail; }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    void begin(int state, const char* name);
+    void end();
+
+    const char* m_category;
+    const char* m_name = nullptr;
+    bool m_record = false;
+    qint64 m_startNs = 0;
+    QByteArray m_detail;
+};
+
+#define TRACE_CONCAT_IMPL(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_IMPL(a, b)
+
+#define TRACE_SCOPE(category, name) TraceScope TRACE_CONCAT(traceScope_, __LINE__)(category, name)
+
+// Имя интервала - сигнатура функции (при выгрузке сокращается до Класс::метод)
+#define TRACE_FUNCTION(category) TRACE_SCOPE(category, Q_FUNC_INFO)
+
+#endif // TRACE_H
@@ -1,15 +1,240 @@
 #include "src/services/WeightCalculator.h"
-#include <QJsonDocument>
-#include <QJsonArray>
-#include <QJsonObject>
+#include "src/services/CgEnvelope.h"
+#include "src/services/ParallelFor.h"
 #include <QDebug>
-#include <QPointF>
 
-// Если FUEL_DENSITY не определен в хедере, задаем стандартную плотность авиабензина
-#ifndef FUEL_DENSITY
-#define FUEL_DENSITY 0.72
+// Набор инструкций для пакетного расчета выбирается при сборке
+// (CONFIG += simd_avx2 в SkyReady.pro включает AVX2, SSE2 есть на любом x86-64)
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define SKYREADY_SIMD_AVX2
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SKYREADY_SIMD_SSE2
 #endif
 
+namespace {
+
+// Константы модели, общие для всех сценариев пакета
+struct BatchConstants {
+    double emptyWeight;
+    double emptyMoment;
+    double armFuel;
+    double armPayload;
+    double maxTakeoffWeight;
+    double fuelCapacity;
+    double fuelConsumption;
+};
+
+// Входные массивы пакета. Если массив не задан, используется константа
+struct BatchInput {
+    const double* fuel;
+    const double* cargo;
+    double cargoConst;
+    const double* minutes;
+    double minutesConst;
+    size_t count;
+};
+
+// Скалярная версия. Формулы и порядок операций совпадают с calculate()
+inline quint8 scenarioMask(const BatchConstants& k, const CgEnvelope& env,
+                           double fuel, double cargo, double minutes)
+{
+    double fuelWeight = fuel * WeightCalculator::FUEL_DENSITY;
+    double weight = k.emptyWeight + fuelWeight + cargo;
+    double moment = k.emptyMoment + fuelWeight * k.armFuel + cargo * k.armPayload;
+    double cg = weight > 0 ? moment / weight : 0;
+    double fuelNeeded = (minutes / 60.0 * k.fuelConsumption) * 1.1;
+
+    quint8 mask = 0;
+    if (weight <= k.maxTakeoffWeight) mask |= CheckWeight;
+    if (env.contains(cg, weight)) mask |= CheckCg;
+    if (fuel >= fuelNeeded) mask |= CheckFuel;
+    if (fuel <= k.fuelCapacity) mask |= CheckCapacity;
+    return mask;
+}
+
+void scalarBatch(const BatchConstants& k, const CgEnvelope& env, const BatchInput& in, size_t from, quint8* out) {
+    for (size_t i = from; i < in.count; ++i) {
+        double cargo = in.cargo ? in.cargo[i] : in.cargoConst;
+        double minutes = in.minutes ? in.minutes[i] : in.minutesConst;
+        out[i] = scenarioMask(k, env, in.fuel[i], cargo, minutes);
+    }
+}
+
+#if defined(SKYREADY_SIMD_AVX2)
+
+// 4 сценария за итерацию
+size_t simdBatch(const BatchConstants& k, const CgEnvelope& env, const BatchInput& in, quint8* out) {
+    const __m256d density = _mm256_set1_pd(WeightCalculator::FUEL_DENSITY);
+    const __m256d emptyWeight = _mm256_set1_pd(k.emptyWeight);
+    const __m256d emptyMoment = _mm256_set1_pd(k.emptyMoment);
+    const __m256d armFuel = _mm256_set1_pd(k.armFuel);
+    const __m256d armPayload = _mm256_set1_pd(k.armPayload);
+    const __m256d mtow = _mm256_set1_pd(k.maxTakeoffWeight);
+    const __m256d capacity = _mm256_set1_pd(k.fuelCapacity);
+    const __m256d consumption = _mm256_set1_pd(k.fuelConsumption);
+    const __m256d sixty = _mm256_set1_pd(60.0);
+    const __m256d reserve = _mm256_set1_pd(1.1);
+    const __m256d minCg = _mm256_set1_pd(env.minCg);
+    const __m256d maxCg = _mm256_set1_pd(env.maxCg);
+    const __m256d minWeight = _mm256_set1_pd(env.minWeight);
+    const __m256d maxWeight = _mm256_set1_pd(env.maxWeight);
+    const __m256d cargoConst = _mm256_set1_pd(in.cargoConst);
+    const __m256d minutesConst = _mm256_set1_pd(in.minutesConst);
+
+    size_t i = 0;
+    for (; i + 4 <= in.count; i += 4) {
+        __m256d fuel = _mm256_loadu_pd(in.fuel + i);
+        __m256d cargo = in.cargo ? _mm256_loadu_pd(in.cargo + i) : cargoConst;
+        __m256d minutes = in.minutes ? _mm256_loadu_pd(in.minutes + i) : minutesConst;
+
+        __m256d fuelWeight = _mm256_mul_pd(fuel, density);
+        __m256d weight = _mm256_add_pd(_mm256_add_pd(emptyWeight, fuelWeight), cargo);
+        __m256d moment = _mm256_add_pd(_mm256_add_pd(emptyMoment, _mm256_mul_pd(fuelWeight, armFuel)),
+                                       _mm256_mul_pd(cargo, armPayload));
+        __m256d cg = _mm256_div_pd(moment, weight);
+        __m256d fuelNeeded = _mm256_mul_pd(_mm256_mul_pd(_mm256_div_pd(minutes, sixty), consumption), reserve);
+
+        __m256d weightOk = _mm256_cmp_pd(weight, mtow, _CMP_LE_OQ);
+        __m256d fuelOk = _mm256_cmp_pd(fuel, fuelNeeded, _CMP_GE_OQ);
+        __m256d capacityOk = _mm256_cmp_pd(fuel, capacity, _CMP_LE_OQ);
+
+        // Конверт: описывающий прямоугольник + четность пересечений ребер
+        __m256d inBox = _mm256_and_pd(
+            _mm256_and_pd(_mm256_cmp_pd(cg, minCg, _CMP_GE_OQ), _mm256_cmp_pd(cg, maxCg, _CMP_LE_OQ)),
+            _mm256_and_pd(_mm256_cmp_pd(weight, minWeight, _CMP_GE_OQ), _mm256_cmp_pd(weight, maxWeight, _CMP_LE_OQ)));
+        __m256d parity = _mm256_setzero_pd();
+        for (const CgEnvelope::Edge& e : env.edges) {
+            __m256d yLow = _mm256_set1_pd(e.yLow);
+            __m256d span = _mm256_and_pd(_mm256_cmp_pd(weight, yLow, _CMP_GE_OQ),
+                                         _mm256_cmp_pd(weight, _mm256_set1_pd(e.yHigh), _CMP_LT_OQ));
+            __m256d x = _mm256_add_pd(_mm256_set1_pd(e.x0),
+                                      _mm256_mul_pd(_mm256_sub_pd(weight, yLow), _mm256_set1_pd(e.slope)));
+            __m256d crosses = _mm256_and_pd(span, _mm256_cmp_pd(cg, x, _CMP_LT_OQ));
+            parity = _mm256_xor_pd(parity, crosses);
+        }
+        __m256d cgOk = _mm256_and_pd(inBox, parity);
+
+        int w = _mm256_movemask_pd(weightOk);
+        int c = _mm256_movemask_pd(cgOk);
+        int f = _mm256_movemask_pd(fuelOk);
+        int t = _mm256_movemask_pd(capacityOk);
+        for (int lane = 0; lane < 4; ++lane) {
+            out[i + lane] = (quint8)(((w >> lane) & 1)
+                                   | (((c >> lane) & 1) << 1)
+                                   | (((f >> lane) & 1) << 2)
+                                   | (((t >> lane) & 1) << 3));
+        }
+    }
+    return i;
+}
+
+#elif defined(SKYREADY_SIMD_SSE2)
+
+// 2 сценария за итерацию
+size_t simdBatch(const BatchConstants& k, const CgEnvelope& env, const BatchInput& in, quint8* out) {
+    const __m128d density = _mm_set1_pd(WeightCalculator::FUEL_DENSITY);
+    const __m128d emptyWeight = _mm_set1_pd(k.emptyWeight);
+    const __m128d emptyMoment = _mm_set1_pd(k.emptyMoment);
+    const __m128d armFuel = _mm_set1_pd(k.armFuel);
+    const __m128d armPayload = _mm_set1_pd(k.armPayload);
+    const __m128d mtow = _mm_set1_pd(k.maxTakeoffWeight);
+    const __m128d capacity = _mm_set1_pd(k.fuelCapacity);
+    const __m128d consumption = _mm_set1_pd(k.fuelConsumption);
+    const __m128d sixty = _mm_set1_pd(60.0);
+    const __m128d reserve = _mm_set1_pd(1.1);
+    const __m128d minCg = _mm_set1_pd(env.minCg);
+    const __m128d maxCg = _mm_set1_pd(env.maxCg);
+    const __m128d minWeight = _mm_set1_pd(env.minWeight);
+    const __m128d maxWeight = _mm_set1_pd(env.maxWeight);
+    const __m128d cargoConst = _mm_set1_pd(in.cargoConst);
+    const __m128d minutesConst = _mm_set1_pd(in.minutesConst);
+
+    size_t i = 0;
+    for (; i + 2 <= in.count; i += 2) {
+        __m128d fuel = _mm_loadu_pd(in.fuel + i);
+        __m128d cargo = in.cargo ? _mm_loadu_pd(in.cargo + i) : cargoConst;
+        __m128d minutes = in.minutes ? _mm_loadu_pd(in.minutes + i) : minutesConst;
+
+        __m128d fuelWeight = _mm_mul_pd(fuel, density);
+        __m128d weight = _mm_add_pd(_mm_add_pd(emptyWeight, fuelWeight), cargo);
+        __m128d moment = _mm_add_pd(_mm_add_pd(emptyMoment, _mm_mul_pd(fuelWeight, armFuel)),
+                                    _mm_mul_pd(cargo, armPayload));
+        __m128d cg = _mm_div_pd(moment, weight);
+        __m128d fuelNeeded = _mm_mul_pd(_mm_mul_pd(_mm_div_pd(minutes, sixty), consumption), reserve);
+
+        __m128d weightOk = _mm_cmple_pd(weight, mtow);
+        __m128d fuelOk = _mm_cmpge_pd(fuel, fuelNeeded);
+        __m128d capacityOk = _mm_cmple_pd(fuel, capacity);
+
+        __m128d inBox = _mm_and_pd(_mm_and_pd(_mm_cmpge_pd(cg, minCg), _mm_cmple_pd(cg, maxCg)),
+                                   _mm_and_pd(_mm_cmpge_pd(weight, minWeight), _mm_cmple_pd(weight, maxWeight)));
+        __m128d parity = _mm_setzero_pd();
+        for (const CgEnvelope::Edge& e : env.edges) {
+            __m128d yLow = _mm_set1_pd(e.yLow);
+            __m128d span = _mm_and_pd(_mm_cmpge_pd(weight, yLow), _mm_cmplt_pd(weight, _mm_set1_pd(e.yHigh)));
+            __m128d x = _mm_add_pd(_mm_set1_pd(e.x0), _mm_mul_pd(_mm_sub_pd(weight, yLow), _mm_set1_pd(e.slope)));
+            parity = _mm_xor_pd(parity, _mm_and_pd(span, _mm_cmplt_pd(cg, x)));
+        }
+        __m128d cgOk = _mm_and_pd(inBox, parity);
+
+        int w = _mm_movemask_pd(weightOk);
+        int c = _mm_movemask_pd(cgOk);
+        int f = _mm_movemask_pd(fuelOk);
+        int t = _mm_movemask_pd(capacityOk);
+        for (int lane = 0; lane < 2; ++lane) {
+            out[i + lane] = (quint8)(((w >> lane) & 1)
+                                   | (((c >> lane) & 1) << 1)
+                                   | (((f >> lane) & 1) << 2)
+                                   | (((t >> lane) & 1) << 3));
+        }
+    }
+    return i;
+}
+
+#else
+
+// Без SIMD все сценарии считает скалярный цикл
+size_t simdBatch(const BatchConstants&, const CgEnvelope&, const BatchInput&, quint8*) {
+    return 0;
+}
+
+#endif
+
+BatchConstants batchConstants(const AircraftModel& model, const CgEnvelope& envelope) {
+    BatchConstants k;
+    k.emptyWeight = model.emptyWeight;
+    k.emptyMoment = model.emptyWeight * envelope.armEmpty;
+    k.armFuel = envelope.armFuel;
+    k.armPayload = envelope.armPayload;
+    k.maxTakeoffWeight = model.maxTakeoffWeight;
+    k.fuelCapacity = model.fuelCapacity;
+    k.fuelConsumption = model.fuelConsumption;
+    return k;
+}
+
+void runBatch(const BatchConstants& k, const CgEnvelope& envelope, const BatchInput& in, quint8* out) {
+    // Векторная часть + скалярный хвост
+    size_t done = simdBatch(k, envelope, in, out);
+    scalarBatch(k, envelope, in, done, out);
+}
+
+double gridValue(double from, double to, int steps, int index) {
+    if (steps <= 1) return from;
+    return from + (to - from) * index / (steps - 1);
+}
+
+} // namespace
+
+double FeasibilityGrid::fuelAt(int fuelIndex) const {
+    return gridValue(fuelFrom, fuelTo, fuelSteps, fuelIndex);
+}
+
+double FeasibilityGrid::cargoAt(int cargoIndex) const {
+    return gridValue(cargoFrom, cargoTo, cargoSteps, cargoIndex);
+}
+
 WeightCalculator::WeightCalculator() {
 }
 
@@ -17,27 +242,13 @@ BalanceResult WeightCalculator::calculate(const AircraftModel& model,
                                           const Aircraft& aircraft,
                                           const FlightParams& params)
 {
+    Q_UNUSED(aircraft); // Профиль берется из модели, а не из названия борта
+
     BalanceResult result;
-    result.message = "";
-
-    // 1. Настройка параметров центровки под конкретную модель
-    double armEmpty, armFuel, armPilot;
-    double cgMin, cgMax;
-
-    // Используем modelName из объекта aircraft для выбора профиля
-    if (aircraft.modelName.contains("Piper")) {
-        armEmpty = 85.0;
-        armFuel = 95.0;
-        armPilot = 85.5;
-        cgMin = 82.0;
-        cgMax = 93.0;
-    } else {
-        armEmpty = 39.0;
-        armFuel = 48.0;
-        armPilot = 37.0;
-        cgMin = 35.0;
-        cgMax = 47.5;
-    }
+
+    // 1. Конверт и плечи модели (собраны заранее из cg_envelope_json)
+    std::shared_ptr<const CgEnvelope> envelopePtr = CgEnvelope::forModel(model);
+    const CgEnvelope& envelope = *envelopePtr;
 
     // 2. Расчет весов
     double fuelWeight = params.fuelAmount * FUEL_DENSITY;
@@ -49,17 +260,15 @@ BalanceResult WeightCalculator::calculate(const AircraftModel& model,
     // 3. Проверка максимального взлетного веса (MTOW)
     if (result.totalWeight > model.maxTakeoffWeight) {
         result.isWeightOk = false;
-        result.message += QString("Перегруз! Текущий вес: %1 кг (Макс: %2). \n")
-                          .arg(result.totalWeight)
-                          .arg(model.maxTakeoffWeight);
+        result.issues.add(IssueCode::Overweight, result.totalWeight, model.maxTakeoffWeight);
     } else {
         result.isWeightOk = true;
     }
 
     // 4. Расчет моментов (Weight * Arm) с использованием динамических плеч
-    double momentEmpty = emptyWeight * armEmpty;
-    double momentFuel = fuelWeight * armFuel;
-    double momentPayload = payloadWeight * armPilot;
+    double momentEmpty = emptyWeight * envelope.armEmpty;
+    double momentFuel = fuelWeight * envelope.armFuel;
+    double momentPayload = payloadWeight * envelope.armPayload;
 
     double totalMoment = momentEmpty + momentFuel + momentPayload;
 
@@ -76,34 +285,94 @@ BalanceResult WeightCalculator::calculate(const AircraftModel& model,
 
     if (params.fuelAmount < fuelNeededLiters) {
         result.isFuelOk = false;
-        result.message += QString("Мало топлива! Нужно: %1 л (с запасом), В баках: %2 л. \n")
-                          .arg(QString::number(fuelNeededLiters, 'f', 1))
-                          .arg(params.fuelAmount);
+        result.issues.add(IssueCode::FuelInsufficient, fuelNeededLiters, params.fuelAmount);
     } else if (params.fuelAmount > model.fuelCapacity) {
         result.isFuelOk = false;
-        result.message += QString("Топлива больше объема баков! Баки: %1 л. \n")
-                          .arg(model.fuelCapacity);
+        result.issues.add(IssueCode::FuelOverCapacity, model.fuelCapacity);
     } else {
         result.isFuelOk = true;
     }
 
     // 7. Проверка конверта
-    QPolygonF envelope;
-    envelope << QPointF(cgMin, 0.0)
-             << QPointF(cgMin, model.maxTakeoffWeight)
-             << QPointF(cgMax, model.maxTakeoffWeight)
-             << QPointF(cgMax, 0.0);
-
-    if (envelope.containsPoint(QPointF(result.cgPosition, result.totalWeight), Qt::OddEvenFill)) {
+    if (envelope.contains(result.cgPosition, result.totalWeight)) {
         result.isCgOk = true;
     } else {
         result.isCgOk = false;
-        result.message += QString("Нарушена центровка! CG: %1 (Допуск: %2-%3). \n")
-                          .arg(QString::number(result.cgPosition, 'f', 1))
-                          .arg(cgMin)
-                          .arg(cgMax);
+
+        // Допуск на текущей массе (для пояснения)
+        double cgFrom, cgTo;
+        envelope.cgRangeAt(result.totalWeight, cgFrom, cgTo);
+        result.issues.add(IssueCode::CgOutOfEnvelope, result.cgPosition, cgFrom, cgTo);
     }
 
     return result;
 }
 
+
+void WeightCalculator::evaluateBatch(const AircraftModel& model, const LoadScenarios& scenarios, quint8* outMasks) {
+    if (scenarios.count == 0) return;
+
+    BatchInput in;
+    in.fuel = scenarios.fuelAmount;
+    in.cargo = scenarios.cargoWeight;
+    in.cargoConst = 0;
+    in.minutes = scenarios.flightMinutes;
+    in.minutesConst = 0;
+    in.count = scenarios.count;
+
+    std::shared_ptr<const CgEnvelope> envelope = CgEnvelope::forModel(model);
+    BatchConstants k = batchConstants(model, *envelope);
+
+    // Сценарии независимы: режем массив на блоки и раздаем потокам пула
+    ParallelFor::run(scenarios.count, 16384, [&](size_t from, size_t to) {
+        BatchInput part = in;
+        part.fuel = in.fuel + from;
+        part.cargo = in.cargo ? in.cargo + from : nullptr;
+        part.minutes = in.minutes ? in.minutes + from : nullptr;
+        part.count = to - from;
+        runBatch(k, *envelope, part, outMasks + from);
+    });
+}
+
+FeasibilityGrid WeightCalculator::sweepGrid(const AircraftModel& model, int flightTimeMinutes,
+                                            double fuelFrom, double fuelTo, int fuelSteps,
+                                            double cargoFrom, double cargoTo, int cargoSteps)
+{
+    FeasibilityGrid grid;
+    grid.fuelFrom = fuelFrom;
+    grid.fuelTo = fuelTo;
+    grid.fuelSteps = qMax(fuelSteps, 0);
+    grid.cargoFrom = cargoFrom;
+    grid.cargoTo = cargoTo;
+    grid.cargoSteps = qMax(cargoSteps, 0);
+    grid.masks.resize((size_t)grid.fuelSteps * grid.cargoSteps);
+
+    if (grid.masks.empty()) return grid;
+
+    // Значения топлива одинаковы для всех строк сетки
+    std::vector<double> fuel(grid.fuelSteps);
+    for (int i = 0; i < grid.fuelSteps; ++i) {
+        fuel[i] = grid.fuelAt(i);
+    }
+
+    std::shared_ptr<const CgEnvelope> envelope = CgEnvelope::forModel(model);
+    BatchConstants k = batchConstants(model, *envelope);
+
+    // Строки сетки считаются параллельно, блок - не меньше ~16k ячеек
+    size_t rowsPerChunk = qMax<size_t>(1, 16384 / (size_t)grid.fuelSteps);
+    ParallelFor::run(grid.cargoSteps, rowsPerChunk, [&](size_t from, size_t to) {
+        BatchInput in;
+        in.fuel = fuel.data();
+        in.cargo = nullptr;
+        in.minutes = nullptr;
+        in.minutesConst = flightTimeMinutes;
+        in.count = fuel.size();
+
+        for (size_t row = from; row < to; ++row) {
+            in.cargoConst = grid.cargoAt((int)row);
+            runBatch(k, *envelope, in, grid.masks.data() + row * grid.fuelSteps);
+        }
+    });
+
+    return grid;
+}
@@ -3,8 +3,8 @@
 
 #include "src/models/Entities.h"
 #include <QString>
-#include <QPolygonF>
-#include <QJsonObject>
+#include <QtGlobal>
+#include <vector>
 
 // Результат расчетов
 struct BalanceResult {
@@ -13,7 +13,39 @@ struct BalanceResult {
     bool isWeightOk;  // Не перегружен ли самолет
     bool isCgOk;  // Попадает ли центровка в конверт
     bool isFuelOk;  // Хватает ли топлива на полет
-    QString message;  // Текстовое пояснение
+    IssueList issues;  // Подробности нарушений (текст - через ReadinessText)
+};
+
+// Битовые флаги пройденных проверок для пакетного расчета
+enum LoadCheck : quint8 {
+    CheckWeight   = 1 << 0,  // Масса не превышает MTOW
+    CheckCg       = 1 << 1,  // Точка (CG, масса) внутри конверта
+    CheckFuel     = 1 << 2,  // Топлива хватает на полет с запасом 10%
+    CheckCapacity = 1 << 3,  // Топливо помещается в баки
+    CheckAll      = CheckWeight | CheckCg | CheckFuel | CheckCapacity
+};
+
+// Набор сценариев загрузки (структура массивов, все массивы длины count)
+struct LoadScenarios {
+    const double* fuelAmount = nullptr;     // Топливо, л
+    const double* cargoWeight = nullptr;    // Груз + пассажиры, кг
+    const double* flightMinutes = nullptr;  // Время полета, мин
+    size_t count = 0;
+};
+
+// Результат перебора сетки "топливо x загрузка" при фиксированном времени полета
+struct FeasibilityGrid {
+    double fuelFrom = 0;
+    double fuelTo = 0;
+    int fuelSteps = 0;
+    double cargoFrom = 0;
+    double cargoTo = 0;
+    int cargoSteps = 0;
+    std::vector<quint8> masks;  // Построчно: [cargoIndex * fuelSteps + fuelIndex]
+
+    quint8 at(int fuelIndex, int cargoIndex) const { return masks[(size_t)cargoIndex * fuelSteps + fuelIndex]; }
+    double fuelAt(int fuelIndex) const;
+    double cargoAt(int cargoIndex) const;
 };
 
 class WeightCalculator {
@@ -23,15 +55,19 @@ public:
                             const Aircraft& aircraft,
                             const FlightParams& params);
 
-private:
-    // Плотность авиационного бензина (AvGas 100LL) ~ 0.72 кг/л
-    const double FUEL_DENSITY = 0.72;
+    // Пакетная проверка сценариев. В outMasks пишется по одному байту флагов LoadCheck
+    // на сценарий. Использует AVX2/SSE2, если они доступны при сборке
+    void evaluateBatch(const AircraftModel& model, const LoadScenarios& scenarios, quint8* outMasks);
+
+    // Перебор равномерной сетки топливо x загрузка для заданного времени полета
+    FeasibilityGrid sweepGrid(const AircraftModel& model, int flightTimeMinutes,
+                              double fuelFrom, double fuelTo, int fuelSteps,
+                              double cargoFrom, double cargoTo, int cargoSteps);
 
-    // Стандартные плечи (расстояния от носа до груза) для упрощенной модели
-    const double ARM_EMPTY = 38.0;  // Плечо пустого самолета
-    const double ARM_PILOT = 37.0;  // Плечо передних кресел
-    const double ARM_FUEL = 48.0;  // Плечо баков
-    const double ARM_CARGO = 95.0;  // Плечо багажника
+    // Плотность авиационного бензина (AvGas 100LL) ~ 0.72 кг/л. Единственное
+    // определение: им пользуются и расчет загрузки, и LoadSolver.
+    // Плечи станций и конверт центровки задаются для каждой модели (см. CgEnvelope)
+    static constexpr double FUEL_DENSITY = 0.72;
 };
 
 #endif // WEIGHTCALCULATOR_H
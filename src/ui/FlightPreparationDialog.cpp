@@ -1,7 +1,8 @@
 #include "src/ui/FlightPreparationDialog.h"
+#include "src/services/Trace.h"
 #include "src/db/DatabaseManager.h"
-#include "src/repositories/AircraftRepository.h"
-#include "src/repositories/DefectRepository.h"
+#include "src/services/ReadinessText.h"
+#include "src/services/AircraftContextCache.h"
 #include <QVBoxLayout>
 #include <QFormLayout>
 #include <QMessageBox>
@@ -11,6 +12,8 @@ FlightPreparationDialog::FlightPreparationDialog(QUuid aircraftId, QWidget *pare
     : QDialog(parent), m_aircraftId(aircraftId)
 {
     setupUi();
+    // Контекст обычно уже загружен в фоне при выборе строки в главном окне
+    applyContext(AircraftContextCache::instance().get(m_aircraftId));
     loadData();
 
     // Сразу запускаем проверку с дефолтными значениями
@@ -21,8 +24,9 @@ FlightPreparationDialog::~FlightPreparationDialog() {
 }
 
 void FlightPreparationDialog::setupUi() {
+    TRACE_FUNCTION("ui");
     setWindowTitle("Подготовка к вылету");
-    resize(500, 650); // Немного увеличим высоту для комфорта
+    resize(500, 850); // Немного увеличим высоту для комфорта
 
     QVBoxLayout *mainLayout = new QVBoxLayout(this);
 
@@ -40,7 +44,19 @@ void FlightPreparationDialog::setupUi() {
     QGroupBox *inputGroup = new QGroupBox("Параметры рейса", this);
     QFormLayout *formLayout = new QFormLayout(inputGroup);
 
+    // Список пилотов подгружается страницами, поиск идет в БД
+    m_pilotSearch = new QLineEdit(this);
+    m_pilotSearch->setPlaceholderText("Поиск по имени...");
+    m_pilotSearch->setClearButtonEnabled(true);
+
+    m_pilotModel = new PilotListModel(this);
     m_pilotCombo = new QComboBox(this);
+    m_pilotCombo->setModel(m_pilotModel);
+    m_pilotCombo->setMaxVisibleItems(20);
+
+    m_pilotSearchTimer = new QTimer(this);
+    m_pilotSearchTimer->setSingleShot(true);
+    m_pilotSearchTimer->setInterval(250);
 
     m_fuelSpin = new QDoubleSpinBox(this);
     m_fuelSpin->setRange(0, 500);
@@ -57,13 +73,25 @@ void FlightPreparationDialog::setupUi() {
     m_timeSpin->setSuffix(" мин");
     m_timeSpin->setValue(60);
 
-    formLayout->addRow("Командир ВС:", m_pilotCombo);
+    formLayout->addRow("Командир ВС:", m_pilotSearch);
+    formLayout->addRow("", m_pilotCombo);
     formLayout->addRow("Топливо:", m_fuelSpin);
     formLayout->addRow("Загрузка (Люди+Груз):", m_cargoSpin);
     formLayout->addRow("План. время полета:", m_timeSpin);
 
+    m_btnOptimize = new QPushButton("Подобрать топливо", this);
+    m_btnOptimize->setToolTip("Минимальное законное топливо и максимальная загрузка для выбранного времени полета");
+    formLayout->addRow("", m_btnOptimize);
+
     mainLayout->addWidget(inputGroup);
 
+    // 2.1. Допустимая область загрузки для выбранного времени полета
+    QGroupBox *chartGroup = new QGroupBox("Допустимая область (топливо / загрузка)", this);
+    QVBoxLayout *chartLayout = new QVBoxLayout(chartGroup);
+    m_chart = new FeasibilityChart(this);
+    chartLayout->addWidget(m_chart);
+    mainLayout->addWidget(chartGroup);
+
     // 3. Блок результата
     m_resultGroup = new QGroupBox(this); // Убрали текст заголовка
     QVBoxLayout *resLayout = new QVBoxLayout(m_resultGroup);
@@ -103,37 +131,103 @@ void FlightPreparationDialog::setupUi() {
     // Сигналы
     connect(m_btnClose, &QPushButton::clicked, this, &QDialog::reject);
     connect(m_btnCommit, &QPushButton::clicked, this, &FlightPreparationDialog::onCommitFlight);
+    connect(m_btnOptimize, &QPushButton::clicked, this, &FlightPreparationDialog::onOptimizeLoad);
+    connect(&FlightCommitQueue::instance(), &FlightCommitQueue::flightCommitted, this, &FlightPreparationDialog::onFlightCommitted);
 
     // Автопересчет при смене параметро
-    connect(m_pilotCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &FlightPreparationDialog::onCheckReadiness);
+    connect(m_pilotCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &FlightPreparationDialog::onPilotChanged);
+    connect(m_pilotSearch, &QLineEdit::textEdited, m_pilotSearchTimer, QOverload<>::of(&QTimer::start));
+    connect(m_pilotSearchTimer, &QTimer::timeout, this, &FlightPreparationDialog::onPilotSearchTimeout);
     connect(m_fuelSpin, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &FlightPreparationDialog::onCheckReadiness);
     connect(m_cargoSpin, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &FlightPreparationDialog::onCheckReadiness);
     connect(m_timeSpin, QOverload<int>::of(&QSpinBox::valueChanged), this, &FlightPreparationDialog::onCheckReadiness);
+    connect(m_timeSpin, QOverload<int>::of(&QSpinBox::valueChanged), this, &FlightPreparationDialog::updateFeasibilityGrid);
+}
+
+void FlightPreparationDialog::reloadContext() {
+    TRACE_FUNCTION("ui");
+    AircraftContextCache::instance().invalidate(m_aircraftId);
+    applyContext(m_readinessService.loadContext(m_aircraftId));
+}
+
+void FlightPreparationDialog::applyContext(const ReadinessContext& context) {
+    TRACE_FUNCTION("ui");
+    m_context = context;
+
+    // Инфо о самолете для заголовка
+    if (m_context.isLoaded()) {
+        m_lblAircraftInfo->setText(QString("%1 (%2)").arg(m_context.aircraft.regNumber, m_context.aircraft.modelName));
+    }
+
+    // Реальные названия дефектов, чтобы выводить их в скобках
+    m_criticalDefectNames.clear();
+    m_minorDefectNames.clear();
+    for (const auto& d : m_context.defects) {
+        if (d.severity == "CRITICAL") {
+            m_criticalDefectNames.append(d.description);
+        } else {
+            m_minorDefectNames.append(d.description);
+        }
+    }
+
+    updateFeasibilityGrid();
+}
+
+void FlightPreparationDialog::updateFeasibilityGrid() {
+    TRACE_FUNCTION("ui");
+    if (!m_context.isLoaded() || m_context.model.id.isNull()) return;
+
+    const AircraftModel& model = m_context.model;
+
+    // Диапазоны осей берем с запасом, чтобы была видна граница области
+    double fuelTo = model.fuelCapacity * 1.25;
+    double cargoTo = qMax(model.maxTakeoffWeight - model.emptyWeight, 0.0) * 1.25;
+
+    m_chart->setGrid(m_calculator.sweepGrid(model, m_timeSpin->value(),
+                                            0.0, fuelTo, 240,
+                                            0.0, cargoTo, 120));
 }
 
 void FlightPreparationDialog::loadData() {
-    // 1. Загрузка инфо о самолете для заголовка
-    AircraftRepository repo;
-    Aircraft plane = repo.getById(m_aircraftId);
-    if (!plane.id.isNull()) {
-        m_lblAircraftInfo->setText(QString("%1 (%2)").arg(plane.regNumber, plane.modelName));
+    TRACE_FUNCTION("ui");
+    // Первая страница пилотов, ранжированная под тип этого самолета
+    m_pilotCombo->blockSignals(true);
+    m_pilotModel->setAircraftModel(m_context.aircraft.modelId);
+    m_pilotCombo->setCurrentIndex(m_pilotModel->rowCount() > 0 ? 0 : -1);
+    m_pilotCombo->blockSignals(false);
+
+    QUuid pilotId = m_pilotModel->pilotIdAt(m_pilotCombo->currentIndex());
+    m_currentPilot = pilotId.isNull() ? Pilot() : m_pilotRepo.getById(pilotId);
+
+    if (m_pilotModel->rowCount() == 0) {
+         m_detailsText->append("Внимание: База пилотов пуста. Функционал ограничен.");
     }
+}
 
-    // 2. Загрузка пилотов
-    std::vector<Pilot> pilots = m_pilotRepo.getAll();
-    m_pilotCombo->clear();
+Pilot FlightPreparationDialog::currentPilot() const {
+    return m_currentPilot;
+}
 
-    for (const auto& p : pilots) {
-        m_pilotCombo->addItem(p.fullName, p.id.toString());
+void FlightPreparationDialog::onPilotChanged(int row) {
+    TRACE_FUNCTION("ui");
+    QUuid pilotId = m_pilotModel->pilotIdAt(row);
+    if (pilotId != m_currentPilot.id) {
+        m_currentPilot = pilotId.isNull() ? Pilot() : m_pilotRepo.getById(pilotId);
     }
+    onCheckReadiness();
+}
 
-    if (pilots.empty()) {
-         m_pilotCombo->addItem("Нет пилотов в БД", "");
-         m_detailsText->append("Внимание: База пилотов пуста. Функционал ограничен.");
+void FlightPreparationDialog::onPilotSearchTimeout() {
+    TRACE_FUNCTION("ui");
+    // Сброс модели сам выберет первую (лучшую) строку и запустит проверку
+    m_pilotModel->setNameFilter(m_pilotSearch->text());
+    if (m_pilotCombo->currentIndex() < 0 && m_pilotModel->rowCount() > 0) {
+        m_pilotCombo->setCurrentIndex(0);
     }
 }
 
 void FlightPreparationDialog::onCheckReadiness() {
+    TRACE_FUNCTION("ui");
     m_detailsText->clear();
 
     // Сбор данных
@@ -142,28 +236,11 @@ void FlightPreparationDialog::onCheckReadiness() {
     params.cargoWeight = m_cargoSpin->value();
     params.flightTimeMinutes = m_timeSpin->value();
 
-    QUuid pilotId;
-    QString pilotIdStr = m_pilotCombo->currentData().toString();
-    if (!pilotIdStr.isEmpty()) {
-        pilotId = QUuid(pilotIdStr);
-    }
+    m_chart->setCurrentPoint(params.fuelAmount, params.cargoWeight);
 
-    // Получаем реальные названия дефектов, чтобы вывести их в скобках
-    DefectRepository defectRepo;
-    std::vector<ActiveDefect> defects = defectRepo.getByAircraftId(m_aircraftId);
-    QStringList criticalDefectNames;
-    QStringList minorDefectNames;
-
-    for (const auto& d : defects) {
-        if (d.severity == "CRITICAL") {
-            criticalDefectNames.append(d.description);
-        } else {
-            minorDefectNames.append(d.description);
-        }
-    }
-
-    // Вызов бизнес-логики
-    ReadinessReport report = m_readinessService.checkReadiness(m_aircraftId, pilotId, params);
+    // Вызов бизнес-логики (только расчет в памяти, без запросов к БД)
+    Pilot pilot = currentPilot();
+    ReadinessReport report = m_readinessService.evaluate(m_context, pilot, params);
 
     // Обновление UI
     if (report.isReady) {
@@ -172,7 +249,7 @@ void FlightPreparationDialog::onCheckReadiness() {
         m_resultLabel->setStyleSheet("background-color: #4CAF50; color: white; border-radius: 4px; padding: 10px; font-weight: bold; font-size: 16px;");
         m_resultGroup->setStyleSheet("QGroupBox { border: 1px solid #4CAF50; font-weight: bold; }");
 
-        m_btnCommit->setEnabled(true);
+        m_btnCommit->setEnabled(m_commitTicket == 0); // Пока рейс записывается, повторно не выпускаем
         m_detailsText->append("Все системы в норме. Расчет центровки: ОК.\n");
     } else {
         m_resultLabel->setText("ВЫЛЕТ ЗАПРЕЩЕН");
@@ -183,17 +260,20 @@ void FlightPreparationDialog::onCheckReadiness() {
         m_btnCommit->setEnabled(false);
     }
 
+    // Текст формируется только здесь, при показе
+    const QString& modelName = m_context.aircraft.modelName;
+
     // Вывод ошибок (с красными маркерами)
-    for (const QString& err : report.errors) {
-        QString displayText = err;
+    for (const Issue& err : report.errors) {
+        QString displayText = ReadinessText::describe(err, pilot.fullName, modelName);
 
-        // Если сообщение касается критических дефектов, добавляем их список
-        if (displayText.contains("КРИТИЧЕСКИЕ неисправности") && !criticalDefectNames.isEmpty()) {
-            displayText += QString(" (%1)").arg(criticalDefectNames.join(", "));
+        // Для дефектов добавляем их список
+        if (err.code == IssueCode::CriticalDefects && !m_criticalDefectNames.isEmpty()) {
+            displayText += QString(" (%1)").arg(m_criticalDefectNames.join(", "));
         }
-        // Если сообщение о превышении лимита мелких дефектов (это ошибка)
-        if (displayText.contains("мелких неисправностей") && !minorDefectNames.isEmpty()) {
-            displayText += QString(" (%1)").arg(minorDefectNames.join(", "));
+        // Превышение лимита мелких дефектов (это ошибка)
+        if (err.code == IssueCode::MinorDefectLimit && !m_minorDefectNames.isEmpty()) {
+            displayText += QString(" (%1)").arg(m_minorDefectNames.join(", "));
         }
 
         // Используем HTML для цвета внутри текстового поля
@@ -201,19 +281,52 @@ void FlightPreparationDialog::onCheckReadiness() {
     }
 
     // Вывод предупреждений (с оранжевыми маркерами)
-    for (const QString& warn : report.warnings) {
-        QString displayText = warn;
+    for (const Issue& warn : report.warnings) {
+        QString displayText = ReadinessText::describe(warn, pilot.fullName, modelName);
 
-        // Если сообщение о наличии мелких дефектов (это предупреждение)
-        if (displayText.contains("мелкие неисправности") && !minorDefectNames.isEmpty()) {
-            displayText += QString(" (%1)").arg(minorDefectNames.join(", "));
+        // Наличие мелких дефектов (это предупреждение)
+        if (warn.code == IssueCode::MinorDefects && !m_minorDefectNames.isEmpty()) {
+            displayText += QString(" (%1)").arg(m_minorDefectNames.join(", "));
         }
 
         m_detailsText->insertHtml("<font color='#FF9800'> " + displayText + "</font><br>");
     }
 }
 
+void FlightPreparationDialog::onOptimizeLoad() {
+    TRACE_FUNCTION("ui");
+    if (!m_context.isLoaded() || m_context.model.id.isNull()) return;
+
+    LoadSolution solution = m_solver.solve(m_context.model, m_context.aircraft, m_timeSpin->value());
+
+    if (solution.limit == LoadLimit::FuelCapacity) {
+        QMessageBox::warning(this, "Подбор загрузки",
+            QString("Для полета нужно не менее %1 л топлива, а баки вмещают %2 л.")
+                .arg(QString::number(solution.minFuel, 'f', 1))
+                .arg(m_context.model.fuelCapacity));
+        return;
+    }
+    if (!solution.feasible) {
+        QMessageBox::warning(this, "Подбор загрузки",
+            "Даже без загрузки с минимальным топливом самолет выходит за ограничения массы или центровки.");
+        return;
+    }
+
+    // Смена значений сама запустит проверку
+    m_fuelSpin->setValue(solution.minFuel);
+    if (m_cargoSpin->value() > solution.maxPayload) {
+        m_cargoSpin->setValue(solution.maxPayload);
+    }
+
+    QString limitText = (solution.limit == LoadLimit::Weight) ? "MTOW" : "конверт центровки";
+    m_detailsText->append(QString("Минимум топлива: %1 л. Максимальная загрузка: %2 кг (ограничение: %3).")
+                          .arg(QString::number(solution.minFuel, 'f', 1))
+                          .arg(QString::number(solution.maxPayload, 'f', 1))
+                          .arg(limitText));
+}
+
 void FlightPreparationDialog::onCommitFlight() {
+    TRACE_FUNCTION("ui");
     // 1. Собираем данные
     int timeMinutes = m_timeSpin->value();
 
@@ -226,8 +339,19 @@ void FlightPreparationDialog::onCommitFlight() {
 
     if (reply == QMessageBox::No) return;
 
-    // 3. Вызов сервиса
-    bool success = m_fleetService.commitFlight(m_aircraftId, timeMinutes);
+    // 3. Постановка в очередь: полеты, закрытые в одно время, пишутся одной транзакцией.
+    // Ответ придет в onFlightCommitted
+    m_btnCommit->setEnabled(false);
+    m_btnCommit->setText("Запись...");
+    m_commitTicket = FlightCommitQueue::instance().submit(m_aircraftId, timeMinutes);
+}
+
+void FlightPreparationDialog::onFlightCommitted(quint64 ticket, QUuid aircraftId, bool success) {
+    TRACE_FUNCTION("ui");
+    Q_UNUSED(aircraftId);
+    if (ticket != m_commitTicket) return;  // Чужая заявка
+    m_commitTicket = 0;
+    m_btnCommit->setText("ВЫПУСТИТЬ В РЕЙС");
 
     if (success) {
         QMessageBox::information(this, "Рейс завершен",
@@ -236,5 +360,6 @@ void FlightPreparationDialog::onCommitFlight() {
     } else {
         QMessageBox::critical(this, "Ошибка",
             "Не удалось записать данные о полете в базу данных.");
+        m_btnCommit->setEnabled(true);
     }
 }
@@ -8,10 +8,15 @@
 #include <QLabel>
 #include <QPushButton>
 #include <QGroupBox>
+#include <QLineEdit>
+#include <QTimer>
 
 #include "src/services/ReadinessService.h"
 #include "src/repositories/PilotRepository.h"
-#include "src/services/FleetService.h"
+#include "src/services/FlightCommitQueue.h"
+#include "src/services/WeightCalculator.h"
+#include "src/ui/widgets/FeasibilityChart.h"
+#include "src/ui/models/PilotListModel.h"
 
 class FlightPreparationDialog : public QDialog {
     Q_OBJECT
@@ -20,25 +25,49 @@ public:
     explicit FlightPreparationDialog(QUuid aircraftId, QWidget *parent = nullptr);
     ~FlightPreparationDialog();
 
+public slots:
+    // Точка инвалидации: перечитать из БД самолет, модель и дефекты.
+    // Смена параметров рейса использует уже загруженный контекст
+    void reloadContext();
+
 private slots:
     void onCheckReadiness(); // Кнопка "Проверить" / Автопроверка
     void onCommitFlight();   // Кнопка "Выпустить в рейс"
+    void updateFeasibilityGrid(); // Пересчет допустимой области (при смене времени полета)
+    void onOptimizeLoad();   // Кнопка "Подобрать топливо": минимум топлива и предел загрузки
+    void onFlightCommitted(quint64 ticket, QUuid aircraftId, bool success); // Ответ очереди фиксации
+    void onPilotChanged(int row);     // Выбор пилота: полная запись читается только для выбранного
+    void onPilotSearchTimeout();      // Поиск пилота после паузы в наборе
 
 private:
     QUuid m_aircraftId;
 
+    // Загруженный контекст (обновляется только через reloadContext)
+    ReadinessContext m_context;
+    Pilot m_currentPilot;
+    QStringList m_criticalDefectNames;
+    QStringList m_minorDefectNames;
+    quint64 m_commitTicket = 0;  // Заявка в очереди фиксации (0 - нет)
+
     // Сервисы
     ReadinessService m_readinessService;
     PilotRepository m_pilotRepo;
-    FleetService m_fleetService;
+    WeightCalculator m_calculator;
+    LoadSolver m_solver;
 
     // UI Элементы
     QLabel *m_lblAircraftInfo;
 
+    QLineEdit *m_pilotSearch;
     QComboBox *m_pilotCombo;
+    PilotListModel *m_pilotModel;
+    QTimer *m_pilotSearchTimer;
     QDoubleSpinBox *m_fuelSpin;     // Топливо (литры)
     QDoubleSpinBox *m_cargoSpin;    // Вес груза/пасс (кг)
     QSpinBox *m_timeSpin;           // Время полета (мин)
+    QPushButton *m_btnOptimize;
+
+    FeasibilityChart *m_chart;      // Допустимая область топливо x загрузка
 
     // Блок результата
     QGroupBox *m_resultGroup;
@@ -48,7 +77,9 @@ private:
     QPushButton *m_btnClose;
 
     void setupUi();
+    void applyContext(const ReadinessContext& context);
     void loadData();
+    Pilot currentPilot() const;
 };
 
 #endif // FLIGHTPREPARATIONDIALOG_H
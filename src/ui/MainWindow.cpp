@@ -1,10 +1,16 @@
 #include "src/ui/MainWindow.h"
+#include "src/services/Trace.h"
 #include "src/ui/FlightPreparationDialog.h"
 #include "src/ui/dialogs/AddAircraftDialog.h"
 #include "src/ui/dialogs/AddPilotDialog.h"
 #include "src/ui/dialogs/AddDefectDialog.h"
 #include "src/ui/dialogs/MaintenanceDialog.h"
+#include "src/ui/dialogs/DispatchDialog.h"
+#include "src/ui/dialogs/GenerateFleetDialog.h"
 #include "src/db/DatabaseManager.h"
+#include "src/db/SqlQuery.h"
+#include "src/services/AircraftContextCache.h"
+#include "src/models/FleetSnapshot.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QHeaderView>
@@ -13,23 +19,50 @@
 #include <QMenuBar>
 #include <QUuid>
 #include <QInputDialog> // Для выбора пилота из списка
+#include <QFileDialog>
+#include <QDialog>
+#include <QPlainTextEdit>
+#include <QDialogButtonBox>
+#include <QFontDatabase>
+#include <QtConcurrent>
+
+namespace {
+// Пауза между проверками сервера в режиме только чтения
+const int ReconnectIntervalMs = 30000;
+}
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
 {
     setupUi();
 
+    // Порог зависания цикла событий, мс (SKYREADY_STALL_MS, 0 - сторож выключен)
+    bool thresholdSet = false;
+    int stallMs = qEnvironmentVariableIntValue("SKYREADY_STALL_MS", &thresholdSet);
+    if (!thresholdSet) stallMs = 50;
+    if (stallMs > 0) m_watchdog.reset(new StallWatchdog(this, stallMs));
+
+    m_backgroundPool.setMaxThreadCount(1);
+
+    m_reconnectTimer = new QTimer(this);
+    m_reconnectTimer->setSingleShot(true);
+    m_reconnectTimer->setInterval(ReconnectIntervalMs);
+    connect(m_reconnectTimer, &QTimer::timeout, this, &MainWindow::probeDatabase);
+
     if (DatabaseManager::instance().getDatabase().isOpen()) {
-        m_btnConnect->setEnabled(false);
-        m_btnRefresh->setEnabled(true);
-        m_btnPrepare->setEnabled(true);
-        m_btnSeed->setEnabled(true);
-        m_btnMaintenance->setEnabled(true);
+        enableDatabaseActions();
         loadAircrafts();
+    } else if (showSnapshot()) {
+        // Окно рисуется со снимком сразу, сервер проверяется в фоне
+        probeDatabase();
     }
 }
 
 MainWindow::~MainWindow() {
+    m_reconnectTimer->stop();
+    m_backgroundPool.waitForDone();
+    // Итог сеанса в журнал: где и сколько окно стояло
+    if (m_watchdog && m_watchdog->stallCount() > 0) qDebug().noquote() << m_watchdog->report();
 }
 
 void MainWindow::setupUi() {
@@ -72,17 +105,50 @@ void MainWindow::setupUi() {
 
     mainLayout->addLayout(topPanel);
 
-    m_table = new QTableWidget(this);
-    m_table->setColumnCount(5);
-    QStringList headers;
-    headers << "Бортовой номер" << "Тип ВС" << "Налет (ч)" << "Ресурс (ч)" << "Статус";
-    m_table->setHorizontalHeaderLabels(headers);
+    // Панель фильтра: номер, тип, категории статуса
+    QHBoxLayout *filterPanel = new QHBoxLayout();
+
+    m_filterReg = new QLineEdit(this);
+    m_filterReg->setPlaceholderText("Бортовой номер...");
+    m_filterReg->setClearButtonEnabled(true);
+
+    m_filterModel = new QComboBox(this);
+    m_filterModel->addItem("Все типы");
+    m_filterModel->setSizeAdjustPolicy(QComboBox::AdjustToContents);
+
+    m_filterReady = new QCheckBox("Готовы", this);
+    m_filterWarning = new QCheckBox("Предупреждения", this);
+    m_filterGrounded = new QCheckBox("Не готовы", this);
+    m_filterReady->setChecked(true);
+    m_filterWarning->setChecked(true);
+    m_filterGrounded->setChecked(true);
+
+    filterPanel->addWidget(new QLabel("Фильтр:", this));
+    filterPanel->addWidget(m_filterReg, 1);
+    filterPanel->addWidget(m_filterModel);
+    filterPanel->addWidget(m_filterReady);
+    filterPanel->addWidget(m_filterWarning);
+    filterPanel->addWidget(m_filterGrounded);
+
+    mainLayout->addLayout(filterPanel);
+
+    // Таблица флота: модель поверх колоночного хранилища, строки фиксированной высоты
+    m_fleetModel = new FleetTableModel(this);
+    m_table = new QTableView(this);
+    m_table->setModel(m_fleetModel);
 
     m_table->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    m_table->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    m_table->verticalHeader()->setDefaultSectionSize(m_table->fontMetrics().height() + 8);
+    m_table->setWordWrap(false);
     m_table->setSelectionBehavior(QAbstractItemView::SelectRows);
     m_table->setSelectionMode(QAbstractItemView::SingleSelection);
     m_table->setEditTriggers(QAbstractItemView::NoEditTriggers);
 
+    // Сортировку выполняет сама модель по заранее посчитанным ключам
+    m_table->setSortingEnabled(true);
+    m_table->horizontalHeader()->setSortIndicator(-1, Qt::AscendingOrder);
+
     mainLayout->addWidget(m_table);
 
     m_statusLabel = new QLabel("Ожидание подключения к базе данных...", this);
@@ -93,6 +159,14 @@ void MainWindow::setupUi() {
     connect(m_btnPrepare, &QPushButton::clicked, this, &MainWindow::onPrepareBtnClicked);
     connect(m_btnSeed, &QPushButton::clicked, this, &MainWindow::onSeedBtnClicked);
     connect(m_btnMaintenance, &QPushButton::clicked, this, &MainWindow::onMaintenanceClicked);
+
+    connect(m_table->selectionModel(), &QItemSelectionModel::currentRowChanged, this, &MainWindow::onCurrentRowChanged);
+
+    connect(m_filterReg, &QLineEdit::textChanged, this, &MainWindow::onFilterChanged);
+    connect(m_filterModel, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &MainWindow::onFilterChanged);
+    connect(m_filterReady, &QCheckBox::toggled, this, &MainWindow::onFilterChanged);
+    connect(m_filterWarning, &QCheckBox::toggled, this, &MainWindow::onFilterChanged);
+    connect(m_filterGrounded, &QCheckBox::toggled, this, &MainWindow::onFilterChanged);
 }
 
 void MainWindow::createMenus() {
@@ -103,6 +177,7 @@ void MainWindow::createMenus() {
     QAction *actAddPilot = fleetMenu->addAction("Добавить пилота...");
     fleetMenu->addSeparator();
     QAction *actAddDefect = fleetMenu->addAction("Зарегистрировать дефект...");
+    QAction *actDispatch = fleetMenu->addAction("План вылетов на день...");
 
     fleetMenu->addSeparator();
     QAction *actDeletePlane = fleetMenu->addAction("Удаление воздушного судна");
@@ -111,16 +186,32 @@ void MainWindow::createMenus() {
 
     fleetMenu->addSeparator();
     QAction *actClearDb = fleetMenu->addAction("Очистить базу данных...");
+    QAction *actGenerate = fleetMenu->addAction("Сгенерировать тестовый флот...");
 
     connect(actAddPlane, &QAction::triggered, this, &MainWindow::onAddAircraftClicked);
     connect(actAddPilot, &QAction::triggered, this, &MainWindow::onAddPilotClicked);
     connect(actAddDefect, &QAction::triggered, this, &MainWindow::onAddDefectClicked);
+    connect(actDispatch, &QAction::triggered, this, &MainWindow::onDispatchPlanClicked);
     connect(actDeletePlane, &QAction::triggered, this, &MainWindow::onDeleteAircraftClicked);
     connect(actDeletePilot, &QAction::triggered, this, &MainWindow::onDeletePilotClicked);
     connect(actClearDb, &QAction::triggered, this, &MainWindow::onClearDbClicked);
+    connect(actGenerate, &QAction::triggered, this, &MainWindow::onGenerateFleetClicked);
+
+    QMenu *diagMenu = bar->addMenu("Диагностика");
+    QAction *actTrace = diagMenu->addAction("Запись трассировки");
+    actTrace->setCheckable(true);
+    actTrace->setChecked(Trace::isEnabled());
+    QAction *actSaveTrace = diagMenu->addAction("Сохранить трассировку...");
+    diagMenu->addSeparator();
+    QAction *actStalls = diagMenu->addAction("Отчет о зависаниях...");
+
+    connect(actTrace, &QAction::toggled, this, &MainWindow::onTraceToggled);
+    connect(actSaveTrace, &QAction::triggered, this, &MainWindow::onSaveTraceClicked);
+    connect(actStalls, &QAction::triggered, this, &MainWindow::onStallReportClicked);
 }
 
 void MainWindow::onDeletePilotClicked() {
+    TRACE_FUNCTION("ui");
     if (!DatabaseManager::instance().getDatabase().isOpen()) return;
 
     // 1. Получаем список всех пилотов
@@ -163,17 +254,18 @@ void MainWindow::onDeletePilotClicked() {
 }
 
 void MainWindow::onDeleteAircraftClicked() {
+    TRACE_FUNCTION("ui");
+    if (!DatabaseManager::instance().getDatabase().isOpen()) return;
     // 1. Проверяем выбор в таблице
-    int row = m_table->currentRow();
+    int row = selectedRow();
     if (row < 0) {
         QMessageBox::warning(this, "Внимание", "Выберите самолет в списке, который нужно удалить.");
         return;
     }
 
     // 2. Получаем данные
-    QString regNum = m_table->item(row, 0)->text();
-    QString idStr = m_table->item(row, 0)->data(Qt::UserRole).toString();
-    QUuid id(idStr);
+    QString regNum = m_fleetModel->regNumberAt(row);
+    QUuid id = m_fleetModel->aircraftIdAt(row);
 
     // 3. Подтверждение
     QMessageBox::StandardButton reply;
@@ -186,7 +278,7 @@ void MainWindow::onDeleteAircraftClicked() {
 
     // 4. Удаление через сервис
     if (m_fleetService.deleteAircraft(id)) {
-        loadAircrafts(); // Обновляем таблицу
+        m_fleetModel->removeAircraft(id); // Убираем строку из таблицы
         QMessageBox::information(this, "Успех", "Самолет удален.");
     } else {
         QMessageBox::critical(this, "Ошибка", "Не удалось удалить самолет.");
@@ -194,6 +286,7 @@ void MainWindow::onDeleteAircraftClicked() {
 }
 
 void MainWindow::onClearDbClicked() {
+    TRACE_FUNCTION("ui");
     if (!DatabaseManager::instance().getDatabase().isOpen()) return;
 
     QMessageBox::StandardButton reply;
@@ -212,14 +305,22 @@ void MainWindow::onClearDbClicked() {
     }
 }
 
+void MainWindow::onGenerateFleetClicked() {
+    TRACE_FUNCTION("ui");
+    if (!DatabaseManager::instance().getDatabase().isOpen()) return;
+
+    GenerateFleetDialog dialog(this);
+    if (dialog.exec() == QDialog::Accepted) loadAircrafts();
+}
+
 void MainWindow::onAddAircraftClicked() {
+    TRACE_FUNCTION("ui");
     if (!DatabaseManager::instance().getDatabase().isOpen()) return;
     AddAircraftDialog dialog(this);
     if (dialog.exec() == QDialog::Accepted) {
-        loadAircrafts(); // Обновляем список, чтобы новый самолет появился
-
         // Сразу предлагаем подготовить рейс для нового борта
         QUuid newId = dialog.getCreatedAircraftId();
+        refreshAircraft(newId); // Новый самолет появляется строкой в конце таблицы
 
         if (!newId.isNull()) {
             QMessageBox::StandardButton reply = QMessageBox::question(this, "Подготовка к вылету",
@@ -230,7 +331,7 @@ void MainWindow::onAddAircraftClicked() {
             if (reply == QMessageBox::Yes) {
                 FlightPreparationDialog prepDialog(newId, this);
                 if (prepDialog.exec() == QDialog::Accepted) {
-                    loadAircrafts(); // Обновляем снова, если полет состоялся
+                    refreshAircraft(newId); // Обновляем снова, если полет состоялся
                 }
             }
         }
@@ -238,54 +339,114 @@ void MainWindow::onAddAircraftClicked() {
 }
 
 void MainWindow::onAddPilotClicked() {
+    TRACE_FUNCTION("ui");
     if (!DatabaseManager::instance().getDatabase().isOpen()) return;
     AddPilotDialog dialog(this);
     dialog.exec();
 }
 
 void MainWindow::onAddDefectClicked() {
+    TRACE_FUNCTION("ui");
     if (!DatabaseManager::instance().getDatabase().isOpen()) return;
     AddDefectDialog dialog(this);
-    if (dialog.exec() == QDialog::Accepted) loadAircrafts();
+    if (dialog.exec() == QDialog::Accepted) refreshAircraft(dialog.selectedAircraftId());
+}
+
+void MainWindow::onDispatchPlanClicked() {
+    TRACE_FUNCTION("ui");
+    if (!DatabaseManager::instance().getDatabase().isOpen()) return;
+
+    DispatchDialog dialog(this);
+    dialog.exec();
 }
 
 void MainWindow::onMaintenanceClicked() {
-    int row = m_table->currentRow();
+    TRACE_FUNCTION("ui");
+    int row = selectedRow();
     if (row < 0) {
         QMessageBox::warning(this, "Внимание", "Выберите самолет для обслуживания.");
         return;
     }
 
-    QString idStr = m_table->item(row, 0)->data(Qt::UserRole).toString();
-    QString regNum = m_table->item(row, 0)->text();
-    QUuid aircraftId(idStr);
+    QString regNum = m_fleetModel->regNumberAt(row);
+    QUuid aircraftId = m_fleetModel->aircraftIdAt(row);
 
     MaintenanceDialog dialog(aircraftId, regNum, this);
     dialog.exec();
 
-    loadAircrafts();
+    refreshAircraft(aircraftId);
 }
 
 void MainWindow::onConnectBtnClicked() {
+    TRACE_FUNCTION("ui");
     bool success = DatabaseManager::instance().connectToDatabase();
     if (success) {
         m_statusLabel->setText("База данных подключена успешно.");
-        m_btnConnect->setEnabled(false);
-        m_btnRefresh->setEnabled(true);
-        m_btnPrepare->setEnabled(true);
-        m_btnSeed->setEnabled(true);
-        m_btnMaintenance->setEnabled(true);
+        enableDatabaseActions();
         loadAircrafts();
     } else {
         QMessageBox::critical(this, "Ошибка", "Не удалось подключиться к БД.");
     }
 }
 
+void MainWindow::probeDatabase() {
+    TRACE_FUNCTION("ui");
+    if (m_probing || DatabaseManager::instance().getDatabase().isOpen()) return;
+    m_probing = true;
+    m_statusLabel->setText(m_snapshotStatus + " Подключение к базе данных...");
+
+    // Недоступный сервер держит подключение до connect_timeout - это время
+    // проходит в фоновом потоке, окно остается отзывчивым
+    QtConcurrent::run(&m_backgroundPool, [this]() {
+        bool reachable = DatabaseManager::probeConnection();
+        QMetaObject::invokeMethod(this, [this, reachable]() { onProbeFinished(reachable); }, Qt::QueuedConnection);
+    });
+}
+
+void MainWindow::onProbeFinished(bool reachable) {
+    TRACE_FUNCTION("ui");
+    m_probing = false;
+    // Пока шла проверка, пользователь мог подключиться кнопкой
+    if (DatabaseManager::instance().getDatabase().isOpen()) return;
+
+    // Сервер только что ответил: основное подключение открывается быстро.
+    // Загрузка применяется к модели разницей - расхождения со снимком обновятся на месте
+    if (reachable && DatabaseManager::instance().connectToDatabase()) {
+        enableDatabaseActions();
+        loadAircrafts();
+        return;
+    }
+
+    // БД недоступна: остается снимок, повтор по таймеру или кнопкой
+    m_statusLabel->setText(QString("База данных недоступна. %1 Повтор через %2 с.")
+                               .arg(m_snapshotStatus).arg(ReconnectIntervalMs / 1000));
+    m_reconnectTimer->start();
+}
+
+void MainWindow::enableDatabaseActions() {
+    m_reconnectTimer->stop();
+    m_btnConnect->setEnabled(false);
+    m_btnRefresh->setEnabled(true);
+    m_btnPrepare->setEnabled(true);
+    m_btnSeed->setEnabled(true);
+    m_btnMaintenance->setEnabled(true);
+}
+
+void MainWindow::disableDatabaseActions() {
+    m_btnConnect->setEnabled(true);
+    m_btnRefresh->setEnabled(false);
+    m_btnPrepare->setEnabled(false);
+    m_btnSeed->setEnabled(false);
+    m_btnMaintenance->setEnabled(false);
+}
+
 void MainWindow::onRefreshBtnClicked() {
+    TRACE_FUNCTION("ui");
     loadAircrafts();
 }
 
 void MainWindow::onSeedBtnClicked() {
+    TRACE_FUNCTION("ui");
     QMessageBox::StandardButton reply;
     reply = QMessageBox::question(this, "Перезапись данных",
                                   "Вы уверены? Это сотрет ВСЕ текущие данные.",
@@ -301,75 +462,227 @@ void MainWindow::onSeedBtnClicked() {
 }
 
 void MainWindow::onPrepareBtnClicked() {
-    int row = m_table->currentRow();
+    TRACE_FUNCTION("ui");
+    int row = selectedRow();
     if (row < 0) {
         QMessageBox::warning(this, "Внимание", "Выберите самолет для вылета.");
         return;
     }
-    QString idStr = m_table->item(row, 0)->data(Qt::UserRole).toString();
-    FlightPreparationDialog dialog(QUuid(idStr), this);
-    if (dialog.exec() == QDialog::Accepted) loadAircrafts();
+    QUuid aircraftId = m_fleetModel->aircraftIdAt(row);
+    FlightPreparationDialog dialog(aircraftId, this);
+    if (dialog.exec() == QDialog::Accepted) refreshAircraft(aircraftId);
 }
 
 void MainWindow::loadAircrafts() {
+    TRACE_FUNCTION("ui");
     m_statusLabel->setText("Загрузка данных...");
-    m_table->setRowCount(0);
-    std::vector<Aircraft> fleet = m_aircraftRepo.getAll();
-    if (fleet.empty()) {
+    AircraftContextCache::instance().clear();
+
+    // Новое состояние применяется к модели как разница: выделение и прокрутка сохраняются
+    FleetStore store;
+    if (!m_statusService.load(store)) {
+        // БД пропала посреди сеанса: неполная загрузка не заменяет ни таблицу,
+        // ни снимок на диске. Окно переходит в режим только чтения и ждет сервер
+        DatabaseManager::instance().disconnectFromDatabase();
+        disableDatabaseActions();
+        if (m_fleetModel->totalCount() > 0) {
+            m_snapshotStatus = "Только просмотр: данные последней загрузки.";
+        } else if (!showSnapshot()) {
+            m_snapshotStatus = "Только просмотр.";
+        }
+        m_statusLabel->setText(QString("Ошибка загрузки данных из БД. %1 Повтор через %2 с.")
+                                   .arg(m_snapshotStatus).arg(ReconnectIntervalMs / 1000));
+        m_reconnectTimer->start();
+        return;
+    }
+
+    size_t count = store.size();
+    saveSnapshot(store);
+    m_fleetModel->applyStore(store);
+    updateModelFilter();
+
+    if (count == 0) {
         m_statusLabel->setText("Флот пуст.");
         return;
     }
-    m_table->setRowCount(fleet.size());
-    for (size_t i = 0; i < fleet.size(); ++i) {
-        const Aircraft& plane = fleet[i];
-
-        QTableWidgetItem *itemReg = new QTableWidgetItem(plane.regNumber);
-        itemReg->setTextAlignment(Qt::AlignCenter);
-        itemReg->setData(Qt::UserRole, plane.id.toString());
-        m_table->setItem(i, 0, itemReg);
-
-        QTableWidgetItem *itemModel = new QTableWidgetItem(plane.modelName);
-        itemModel->setTextAlignment(Qt::AlignCenter);
-        m_table->setItem(i, 1, itemModel);
-
-        QTableWidgetItem *itemHours = new QTableWidgetItem(QString::number(plane.engineHoursTotal, 'f', 1));
-        itemHours->setTextAlignment(Qt::AlignCenter);
-        m_table->setItem(i, 2, itemHours);
-
-        double remaining = plane.engineHoursNextService - plane.engineHoursTotal;
-        QTableWidgetItem *itemRes = new QTableWidgetItem(QString::number(remaining, 'f', 1));
-        if (remaining < 10) itemRes->setForeground(Qt::red);
-        itemRes->setTextAlignment(Qt::AlignCenter);
-        m_table->setItem(i, 3, itemRes);
-
-        QString statusText = calculateStatusText(plane);
-        QColor statusColor = calculateStatusColor(plane);
-        QTableWidgetItem *itemStatus = new QTableWidgetItem(statusText);
-        itemStatus->setBackground(statusColor);
-        itemStatus->setTextAlignment(Qt::AlignCenter);
-        if (statusColor == Qt::red || statusColor == Qt::green) itemStatus->setForeground(Qt::white);
-        else itemStatus->setForeground(Qt::black);
-        itemStatus->setFont(QFont("Arial", 9, QFont::Bold));
-        m_table->setItem(i, 4, itemStatus);
+    updateCountLabel();
+}
+
+bool MainWindow::showSnapshot() {
+    TRACE_FUNCTION("ui");
+    FleetSnapshot snapshot;
+    if (!snapshot.open(FleetSnapshot::defaultPath())) {
+        qDebug() << "Snapshot: not used -" << snapshot.errorString();
+        return false;
+    }
+
+    FleetStore store;
+    snapshot.readFleet(store);
+    m_fleetModel->applyStore(store);
+    updateModelFilter();
+
+    m_snapshotStatus = QString("Только просмотр: снимок от %1, %2 бортов, %3 пилотов.")
+                           .arg(snapshot.createdAt().toString("dd.MM.yyyy HH:mm"))
+                           .arg(snapshot.aircraftCount())
+                           .arg(snapshot.pilotCount());
+    m_statusLabel->setText(m_snapshotStatus);
+    return true;
+}
+
+void MainWindow::saveSnapshot(const FleetStore& store) {
+    if (!DatabaseManager::instance().getDatabase().isOpen()) return;
+
+    // Пилоты читаются в потоке записи (свое соединение), окно не ждет
+    QtConcurrent::run(&m_backgroundPool, [store]() {
+        TRACE_SCOPE("service", "FleetSnapshot::write");
+        const qint64 errorsBefore = SqlQuery::counters().errors;
+        std::vector<Pilot> pilots = PilotRepository().getAll();
+        if (SqlQuery::counters().errors != errorsBefore) {
+            qDebug() << "Snapshot: pilot query failed, previous snapshot kept";
+            return;
+        }
+        FleetSnapshot::write(FleetSnapshot::defaultPath(), store, pilots);
+    });
+}
+
+void MainWindow::updateModelFilter() {
+    TRACE_FUNCTION("ui");
+    const FleetStore& store = m_fleetModel->store();
+    QString selected = (m_filterModel->currentIndex() > 0) ? m_filterModel->currentText() : QString();
+
+    QStringList names;
+    for (int m = 0; m < store.modelCount(); ++m) names << store.modelNameAt(m);
+    names.removeDuplicates();
+    names.sort();
+
+    // Без сигналов: фильтр применяется один раз в конце
+    m_filterModel->blockSignals(true);
+    m_filterModel->clear();
+    m_filterModel->addItem("Все типы");
+    m_filterModel->addItems(names);
+    int restored = selected.isEmpty() ? 0 : m_filterModel->findText(selected);
+    m_filterModel->setCurrentIndex(qMax(0, restored));
+    m_filterModel->blockSignals(false);
+
+    // Индексы моделей в хранилище могли смениться после полной перезагрузки
+    onFilterChanged();
+}
+
+void MainWindow::onFilterChanged() {
+    TRACE_FUNCTION("ui");
+    FleetFilter filter;
+    filter.regPrefix = m_filterReg->text().trimmed();
+
+    filter.statuses = 0;
+    if (m_filterReady->isChecked()) filter.statuses |= FleetFilter::Ready;
+    if (m_filterWarning->isChecked()) filter.statuses |= FleetFilter::Warning;
+    if (m_filterGrounded->isChecked()) filter.statuses |= FleetFilter::Grounded;
+
+    if (m_filterModel->currentIndex() > 0) {
+        const FleetStore& store = m_fleetModel->store();
+        QString name = m_filterModel->currentText();
+        for (int m = 0; m < store.modelCount(); ++m) {
+            if (store.modelNameAt(m) == name) {
+                filter.modelIndex = m;
+                break;
+            }
+        }
+    }
+
+    m_fleetModel->setFilter(filter);
+    updateCountLabel();
+}
+
+void MainWindow::updateCountLabel() {
+    int total = m_fleetModel->totalCount();
+    int shown = m_fleetModel->rowCount();
+    if (total == 0) return;
+
+    if (shown == total) {
+        m_statusLabel->setText(QString("Загружено %1 бортов.").arg(total));
+    } else {
+        m_statusLabel->setText(QString("Показано %1 из %2 бортов.").arg(shown).arg(total));
+    }
+}
+
+void MainWindow::refreshAircraft(QUuid aircraftId) {
+    TRACE_FUNCTION("ui");
+    if (aircraftId.isNull()) return;
+    AircraftContextCache::instance().invalidate(aircraftId);
+
+    FleetRow row;
+    switch (m_statusService.loadAircraft(aircraftId, row)) {
+    case FleetStatusService::RowLoaded:
+        m_fleetModel->applyRow(row);
+        break;
+    case FleetStatusService::RowNotFound:
+        m_fleetModel->removeAircraft(aircraftId);
+        break;
+    case FleetStatusService::RowError:
+        // Сбой запроса не значит, что борт удален: строка остается до следующего обновления
+        m_statusLabel->setText("Не удалось обновить строку борта: ошибка запроса к БД.");
+        break;
+    }
+}
+
+void MainWindow::onCurrentRowChanged(const QModelIndex &current) {
+    TRACE_FUNCTION("ui");
+    if (!current.isValid() || !DatabaseManager::instance().getDatabase().isOpen()) return;
+
+    // Выбранная строка первой, затем соседние (к ним обычно переходят стрелками)
+    int row = current.row();
+    std::vector<QUuid> ids;
+    for (int r : { row, row + 1, row - 1 }) {
+        QUuid id = m_fleetModel->aircraftIdAt(r);
+        if (!id.isNull()) ids.push_back(id);
+    }
+    AircraftContextCache::instance().prefetch(ids);
+}
+
+int MainWindow::selectedRow() const {
+    QModelIndex index = m_table->currentIndex();
+    return index.isValid() ? index.row() : -1;
+}
+
+void MainWindow::onTraceToggled(bool enabled) {
+    // Новая запись начинается с пустых буферов
+    if (enabled) Trace::clear();
+    Trace::setEnabled(enabled);
+}
+
+void MainWindow::onSaveTraceClicked() {
+    QString path = QFileDialog::getSaveFileName(this, "Сохранить трассировку", "skyready-trace.json",
+                                                "Chrome trace (*.json)");
+    if (path.isEmpty()) return;
+
+    if (Trace::exportChromeJson(path)) {
+        m_statusLabel->setText(QString("Трассировка сохранена: %1 (открыть в ui.perfetto.dev)").arg(path));
+    } else {
+        QMessageBox::critical(this, "Ошибка", "Не удалось сохранить трассировку.");
+    }
+}
+
+void MainWindow::onStallReportClicked() {
+    if (!m_watchdog) {
+        QMessageBox::information(this, "Зависания", "Сторож зависаний отключен (SKYREADY_STALL_MS=0).");
+        return;
     }
-    m_statusLabel->setText(QString("Загружено %1 бортов.").arg(fleet.size()));
-}
-
-QColor MainWindow::calculateStatusColor(const Aircraft& plane) {
-    double remaining = plane.engineHoursNextService - plane.engineHoursTotal;
-    if (remaining <= 0 || m_defectRepo.hasCriticalDefects(plane.id)) return Qt::red;
-    if (m_defectRepo.countMinorDefects(plane.id) >= 3) return Qt::red;
-    if (remaining < 10.0 || m_defectRepo.countMinorDefects(plane.id) > 0) return Qt::yellow;
-    return Qt::green;
-}
-
-QString MainWindow::calculateStatusText(const Aircraft& plane) {
-    if (m_defectRepo.hasCriticalDefects(plane.id)) return "CRITICAL DEFECT";
-    double remaining = plane.engineHoursNextService - plane.engineHoursTotal;
-    if (remaining <= 0) return "SERVICE REQ";
-    int minorCount = m_defectRepo.countMinorDefects(plane.id);
-    if (minorCount >= 3) return "TOO MANY DEFECTS";
-    if (remaining < 10.0) return "SERVICE SOON";
-    if (minorCount > 0) return QString("WARNINGS (%1)").arg(minorCount);
-    return "READY";
+
+    QDialog dialog(this);
+    dialog.setWindowTitle("Зависания окна");
+    dialog.resize(900, 400);
+
+    QPlainTextEdit *text = new QPlainTextEdit(&dialog);
+    text->setReadOnly(true);
+    text->setLineWrapMode(QPlainTextEdit::NoWrap);
+    text->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+    text->setPlainText(m_watchdog->report());
+
+    QDialogButtonBox *buttons = new QDialogButtonBox(QDialogButtonBox::Close, &dialog);
+    connect(buttons, &QDialogButtonBox::rejected, &dialog, &QDialog::reject);
+
+    QVBoxLayout *layout = new QVBoxLayout(&dialog);
+    layout->addWidget(text);
+    layout->addWidget(buttons);
+    dialog.exec();
 }
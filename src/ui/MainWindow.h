@@ -2,15 +2,22 @@
 #define MAINWINDOW_H
 
 #include <QMainWindow>
-#include <QTableWidget>
+#include <QTableView>
 #include <QPushButton>
 #include <QLabel>
+#include <QLineEdit>
+#include <QComboBox>
+#include <QCheckBox>
 #include <QMenu>
 #include <QMenuBar>
-#include "src/repositories/AircraftRepository.h"
-#include "src/repositories/DefectRepository.h"
 #include "src/repositories/PilotRepository.h"
 #include "src/services/FleetService.h"
+#include "src/services/FleetStatusService.h"
+#include "src/ui/models/FleetTableModel.h"
+#include "src/services/StallWatchdog.h"
+#include <QThreadPool>
+#include <QTimer>
+#include <memory>
 
 class MainWindow : public QMainWindow {
     Q_OBJECT
@@ -30,13 +37,30 @@ private slots:
     void onAddPilotClicked();
     void onAddDefectClicked();
     void onMaintenanceClicked();
+    void onDispatchPlanClicked();
     // Слоты очистки
     void onClearDbClicked();
+    void onGenerateFleetClicked();
     void onDeleteAircraftClicked();
     void onDeletePilotClicked();
 
+    // Панель фильтра таблицы
+    void onFilterChanged();
+
+    // Фоновая загрузка контекста выбранного борта и соседних строк
+    void onCurrentRowChanged(const QModelIndex &current);
+
+    // Диагностика: запись интервалов и выгрузка в Chrome trace
+    void onTraceToggled(bool enabled);
+    void onSaveTraceClicked();
+    void onStallReportClicked();
+
+    // Проверка сервера в фоне, пока на экране снимок (при запуске и по таймеру повтора)
+    void probeDatabase();
+
 private:
-    QTableWidget *m_table;
+    QTableView *m_table;
+    FleetTableModel *m_fleetModel;
     QPushButton *m_btnConnect;
     QPushButton *m_btnRefresh;
     QPushButton *m_btnPrepare;
@@ -45,17 +69,50 @@ private:
 
     QLabel *m_statusLabel;
 
-    AircraftRepository m_aircraftRepo;
-    DefectRepository m_defectRepo;
+    // Фильтр флота
+    QLineEdit *m_filterReg;
+    QComboBox *m_filterModel;
+    QCheckBox *m_filterReady;
+    QCheckBox *m_filterWarning;
+    QCheckBox *m_filterGrounded;
+
     FleetService m_fleetService;
+    FleetStatusService m_statusService;
     PilotRepository m_pilotRepo;
 
+    // Сторож зависаний окна (нет - отключен через SKYREADY_STALL_MS=0)
+    std::unique_ptr<StallWatchdog> m_watchdog;
+
+    // Фоновые задачи окна: запись снимка флота и проверка сервера (один поток, по очереди)
+    QThreadPool m_backgroundPool;
+
+    // Режим только чтения по снимку: повтор проверки сервера и строка статуса снимка
+    QTimer *m_reconnectTimer;
+    QString m_snapshotStatus;
+    bool m_probing = false;
+
     void setupUi();
     void createMenus();
     void loadAircrafts();
+    void enableDatabaseActions();
+    void disableDatabaseActions();
+
+    // Таблица из снимка на диске (false - снимка нет или он не прочитан)
+    bool showSnapshot();
+    // Фоновая запись снимка по только что загруженному хранилищу
+    void saveSnapshot(const FleetStore& store);
+    // Итог фоновой проверки сервера (в потоке окна)
+    void onProbeFinished(bool reachable);
+
+    // Список типов в фильтре по текущему хранилищу (выбор сохраняется по названию)
+    void updateModelFilter();
+    void updateCountLabel();
+
+    // Точечное обновление одной строки после диалога (удаленный борт убирается)
+    void refreshAircraft(QUuid aircraftId);
 
-    QColor calculateStatusColor(const Aircraft& plane);
-    QString calculateStatusText(const Aircraft& plane);
+    // Строка, выбранная в таблице (-1 - нет выбора)
+    int selectedRow() const;
 };
 
 #endif // MAINWINDOW_H
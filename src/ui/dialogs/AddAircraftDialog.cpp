@@ -1,4 +1,5 @@
 #include "src/ui/dialogs/AddAircraftDialog.h"
+#include "src/services/Trace.h"
 #include <QVBoxLayout>
 #include <QFormLayout>
 #include <QMessageBox>
@@ -16,6 +17,7 @@ AddAircraftDialog::~AddAircraftDialog() {
 }
 
 void AddAircraftDialog::setupUi() {
+    TRACE_FUNCTION("ui");
     setWindowTitle("Регистрация нового самолета");
     resize(400, 300);
 
@@ -74,6 +76,7 @@ void AddAircraftDialog::setupUi() {
 }
 
 void AddAircraftDialog::loadModels() {
+    TRACE_FUNCTION("ui");
     m_modelCombo->clear();
     std::vector<AircraftModel> models = m_modelRepo.getAll();
 
@@ -90,6 +93,7 @@ void AddAircraftDialog::loadModels() {
 }
 
 void AddAircraftDialog::onSaveClicked() {
+    TRACE_FUNCTION("ui");
     // 1. Валидация
     QString regNumber = m_regNumberEdit->text().trimmed();
     if (regNumber.isEmpty()) {
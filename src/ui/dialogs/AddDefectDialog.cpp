@@ -1,4 +1,5 @@
 #include "src/ui/dialogs/AddDefectDialog.h"
+#include "src/services/Trace.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QFormLayout>
@@ -17,6 +18,7 @@ AddDefectDialog::~AddDefectDialog() {
 }
 
 void AddDefectDialog::setupUi() {
+    TRACE_FUNCTION("ui");
     setWindowTitle("Регистрация неисправности");
     resize(450, 250);
 
@@ -56,7 +58,12 @@ void AddDefectDialog::setupUi() {
             this, &AddDefectDialog::updateSeverityLabel);
 }
 
+QUuid AddDefectDialog::selectedAircraftId() const {
+    return QUuid(m_aircraftCombo->currentData().toString());
+}
+
 void AddDefectDialog::loadData() {
+    TRACE_FUNCTION("ui");
     // 1. Загрузка самолетов
     m_aircraftCombo->clear();
     std::vector<Aircraft> fleet = m_aircraftRepo.getAll();
@@ -120,6 +127,7 @@ void AddDefectDialog::updateSeverityLabel() {
 }
 
 void AddDefectDialog::onSaveClicked() {
+    TRACE_FUNCTION("ui");
     if (!m_aircraftCombo->isEnabled() && m_aircraftCombo->count() == 0) return;
 
     // Даже если комбобокс выключен (disabled), мы все равно можем получить его текущие данные
@@ -18,6 +18,9 @@ public:
     explicit AddDefectDialog(QWidget *parent = nullptr, QUuid aircraftId = QUuid());
     ~AddDefectDialog();
 
+    // Борт, для которого зарегистрирован дефект (для точечного обновления таблицы)
+    QUuid selectedAircraftId() const;
+
 private slots:
     void onSaveClicked();
     void updateSeverityLabel();
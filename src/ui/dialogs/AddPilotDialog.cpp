@@ -1,4 +1,5 @@
 #include "src/ui/dialogs/AddPilotDialog.h"
+#include "src/services/Trace.h"
 #include <QVBoxLayout>
 #include <QFormLayout>
 #include <QMessageBox>
@@ -18,6 +19,7 @@ AddPilotDialog::~AddPilotDialog() {
 }
 
 void AddPilotDialog::setupUi() {
+    TRACE_FUNCTION("ui");
     setWindowTitle("Регистрация нового пилота");
     resize(400, 500); // Окно повыше из-за списка моделей
 
@@ -78,6 +80,7 @@ void AddPilotDialog::setupUi() {
 }
 
 void AddPilotDialog::loadModels() {
+    TRACE_FUNCTION("ui");
     m_modelsList->clear();
     std::vector<AircraftModel> models = m_modelRepo.getAll();
 
@@ -96,6 +99,7 @@ void AddPilotDialog::loadModels() {
 }
 
 void AddPilotDialog::onSaveClicked() {
+    TRACE_FUNCTION("ui");
     // 1. Валидация имени
     QString name = m_nameEdit->text().trimmed();
     if (name.isEmpty()) {
@@ -0,0 +1,162 @@
+#include "src/ui/dialogs/DispatchDialog.h"
+#include "src/services/Trace.h"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QGroupBox>
+#include <QSpinBox>
+#include <QDoubleSpinBox>
+#include <QMessageBox>
+#include <QElapsedTimer>
+
+DispatchDialog::DispatchDialog(QWidget *parent)
+    : QDialog(parent)
+{
+    setupUi();
+
+    // Пара типовых заданий, чтобы было с чего начать
+    addMissionRow("Задание 1", 60, 160);
+    addMissionRow("Задание 2", 90, 120);
+}
+
+void DispatchDialog::setupUi() {
+    TRACE_FUNCTION("ui");
+    setWindowTitle("План вылетов на день");
+    resize(700, 600);
+
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+
+    // Задания
+    QGroupBox *grpMissions = new QGroupBox("Задания", this);
+    QVBoxLayout *missionsLayout = new QVBoxLayout(grpMissions);
+
+    QHBoxLayout *dateLayout = new QHBoxLayout();
+    m_dateEdit = new QDateEdit(QDate::currentDate(), this);
+    m_dateEdit->setCalendarPopup(true);
+    dateLayout->addWidget(new QLabel("Дата вылетов:", this));
+    dateLayout->addWidget(m_dateEdit);
+    dateLayout->addStretch();
+    missionsLayout->addLayout(dateLayout);
+
+    m_missionsTable = new QTableWidget(0, 3, this);
+    m_missionsTable->setHorizontalHeaderLabels(QStringList() << "Задание" << "Время (мин)" << "Загрузка (кг)");
+    m_missionsTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    m_missionsTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+    missionsLayout->addWidget(m_missionsTable);
+
+    QHBoxLayout *missionBtnLayout = new QHBoxLayout();
+    m_btnAdd = new QPushButton("Добавить задание", this);
+    m_btnRemove = new QPushButton("Удалить выбранное", this);
+    missionBtnLayout->addWidget(m_btnAdd);
+    missionBtnLayout->addWidget(m_btnRemove);
+    missionBtnLayout->addStretch();
+    missionsLayout->addLayout(missionBtnLayout);
+
+    mainLayout->addWidget(grpMissions);
+
+    m_btnPlan = new QPushButton("Распределить борта и экипажи", this);
+    m_btnPlan->setStyleSheet("background-color: #2196F3; color: white; font-weight: bold; padding: 6px;");
+    mainLayout->addWidget(m_btnPlan);
+
+    // Результат
+    QGroupBox *grpPlan = new QGroupBox("План", this);
+    QVBoxLayout *planLayout = new QVBoxLayout(grpPlan);
+
+    m_planTable = new QTableWidget(0, 4, this);
+    m_planTable->setHorizontalHeaderLabels(QStringList() << "Задание" << "Борт" << "Пилот" << "Запас загрузки (кг)");
+    m_planTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    m_planTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    planLayout->addWidget(m_planTable);
+
+    m_summaryLabel = new QLabel(this);
+    planLayout->addWidget(m_summaryLabel);
+
+    mainLayout->addWidget(grpPlan);
+
+    connect(m_btnAdd, &QPushButton::clicked, this, &DispatchDialog::onAddMissionClicked);
+    connect(m_btnRemove, &QPushButton::clicked, this, &DispatchDialog::onRemoveMissionClicked);
+    connect(m_btnPlan, &QPushButton::clicked, this, &DispatchDialog::onPlanClicked);
+}
+
+void DispatchDialog::addMissionRow(const QString& name, int minutes, double payload) {
+    int row = m_missionsTable->rowCount();
+    m_missionsTable->insertRow(row);
+
+    m_missionsTable->setItem(row, 0, new QTableWidgetItem(name));
+
+    QSpinBox *timeSpin = new QSpinBox(this);
+    timeSpin->setRange(10, 600);
+    timeSpin->setSingleStep(10);
+    timeSpin->setValue(minutes);
+    m_missionsTable->setCellWidget(row, 1, timeSpin);
+
+    QDoubleSpinBox *payloadSpin = new QDoubleSpinBox(this);
+    payloadSpin->setRange(0, 2000);
+    payloadSpin->setDecimals(0);
+    payloadSpin->setValue(payload);
+    m_missionsTable->setCellWidget(row, 2, payloadSpin);
+}
+
+void DispatchDialog::onAddMissionClicked() {
+    TRACE_FUNCTION("ui");
+    addMissionRow(QString("Задание %1").arg(m_missionsTable->rowCount() + 1), 60, 160);
+}
+
+void DispatchDialog::onRemoveMissionClicked() {
+    TRACE_FUNCTION("ui");
+    int row = m_missionsTable->currentRow();
+    if (row >= 0) m_missionsTable->removeRow(row);
+}
+
+std::vector<MissionRequest> DispatchDialog::collectMissions() const {
+    std::vector<MissionRequest> missions;
+    missions.reserve(m_missionsTable->rowCount());
+
+    for (int row = 0; row < m_missionsTable->rowCount(); ++row) {
+        MissionRequest m;
+        m.flightTimeMinutes = qobject_cast<QSpinBox*>(m_missionsTable->cellWidget(row, 1))->value();
+        m.payload = qobject_cast<QDoubleSpinBox*>(m_missionsTable->cellWidget(row, 2))->value();
+        missions.push_back(m);
+    }
+    return missions;
+}
+
+void DispatchDialog::onPlanClicked() {
+    TRACE_FUNCTION("ui");
+    std::vector<MissionRequest> missions = collectMissions();
+    if (missions.empty()) {
+        QMessageBox::information(this, "План", "Добавьте хотя бы одно задание.");
+        return;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    std::vector<Aircraft> fleet;
+    std::vector<Pilot> pilots;
+    DispatchPlan plan = m_readinessService.planDispatch(missions, m_dateEdit->date(), fleet, pilots);
+
+    m_planTable->setRowCount((int)missions.size());
+    for (size_t i = 0; i < missions.size(); ++i) {
+        const DispatchAssignment& a = plan.assignments[i];
+        QTableWidgetItem *itemMission = m_missionsTable->item((int)i, 0);
+        m_planTable->setItem((int)i, 0, new QTableWidgetItem(itemMission ? itemMission->text() : QString()));
+
+        if (a.isAssigned()) {
+            m_planTable->setItem((int)i, 1, new QTableWidgetItem(fleet[a.aircraftIndex].regNumber + " (" + fleet[a.aircraftIndex].modelName + ")"));
+            m_planTable->setItem((int)i, 2, new QTableWidgetItem(pilots[a.pilotIndex].fullName));
+            m_planTable->setItem((int)i, 3, new QTableWidgetItem(QString::number(a.payloadMargin, 'f', 1)));
+        } else {
+            QTableWidgetItem *itemNone = new QTableWidgetItem("Нет борта/экипажа");
+            itemNone->setForeground(Qt::red);
+            m_planTable->setItem((int)i, 1, itemNone);
+            m_planTable->setItem((int)i, 2, new QTableWidgetItem("—"));
+            m_planTable->setItem((int)i, 3, new QTableWidgetItem("—"));
+        }
+    }
+
+    m_summaryLabel->setText(QString("Обеспечено заданий: %1 из %2. Готовых бортов: %3, пилотов с действующими документами: %4. Расчет: %5 мс")
+                            .arg(plan.assignedCount).arg(missions.size())
+                            .arg(plan.readyAircraft).arg(plan.validPilots)
+                            .arg(timer.elapsed()));
+}
@@ -0,0 +1,39 @@
+#ifndef DISPATCHDIALOG_H
+#define DISPATCHDIALOG_H
+
+#include <QDialog>
+#include <QTableWidget>
+#include <QPushButton>
+#include <QDateEdit>
+#include <QLabel>
+#include "src/services/ReadinessService.h"
+
+// План вылетов на день: список заданий и автоматическое распределение бортов и пилотов
+class DispatchDialog : public QDialog {
+    Q_OBJECT
+
+public:
+    explicit DispatchDialog(QWidget *parent = nullptr);
+
+private slots:
+    void onAddMissionClicked();
+    void onRemoveMissionClicked();
+    void onPlanClicked();
+
+private:
+    QDateEdit *m_dateEdit;
+    QTableWidget *m_missionsTable;
+    QTableWidget *m_planTable;
+    QPushButton *m_btnAdd;
+    QPushButton *m_btnRemove;
+    QPushButton *m_btnPlan;
+    QLabel *m_summaryLabel;
+
+    ReadinessService m_readinessService;
+
+    void setupUi();
+    void addMissionRow(const QString& name, int minutes, double payload);
+    std::vector<MissionRequest> collectMissions() const;
+};
+
+#endif // DISPATCHDIALOG_H
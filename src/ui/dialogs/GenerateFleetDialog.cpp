@@ -0,0 +1,175 @@
+#include "src/ui/dialogs/GenerateFleetDialog.h"
+#include "src/services/Trace.h"
+#include "src/services/FleetDataGenerator.h"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QFormLayout>
+#include <QGroupBox>
+#include <QLabel>
+#include <QMessageBox>
+#include <QtConcurrent>
+
+GenerateFleetDialog::GenerateFleetDialog(QWidget *parent)
+    : QDialog(parent)
+{
+    setupUi();
+}
+
+void GenerateFleetDialog::setupUi() {
+    TRACE_FUNCTION("ui");
+    setWindowTitle("Генерация тестового флота");
+    resize(420, 380);
+
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+
+    QGroupBox *sizeGroup = new QGroupBox("Размер и состав", this);
+    QFormLayout *formLayout = new QFormLayout(sizeGroup);
+
+    m_seedSpin = new QSpinBox(this);
+    m_seedSpin->setRange(0, 2147483647);
+    m_seedSpin->setValue(1);
+
+    m_aircraftSpin = new QSpinBox(this);
+    m_aircraftSpin->setRange(0, 1000000);
+    m_aircraftSpin->setSingleStep(1000);
+    m_aircraftSpin->setValue(1000);
+
+    m_pilotsSpin = new QSpinBox(this);
+    m_pilotsSpin->setRange(0, 1000000);
+    m_pilotsSpin->setSingleStep(100);
+    m_pilotsSpin->setValue(200);
+
+    m_defectRateSpin = new QDoubleSpinBox(this);
+    m_defectRateSpin->setRange(0.0, 100.0);
+    m_defectRateSpin->setSingleStep(0.5);
+    m_defectRateSpin->setValue(0.5);
+
+    m_criticalSpin = new QDoubleSpinBox(this);
+    m_criticalSpin->setRange(0.0, 100.0);
+    m_criticalSpin->setSuffix(" %");
+    m_criticalSpin->setValue(10.0);
+
+    m_ratingsSpin = new QDoubleSpinBox(this);
+    m_ratingsSpin->setRange(1.0, 5.0);
+    m_ratingsSpin->setSingleStep(0.1);
+    m_ratingsSpin->setValue(1.5);
+
+    m_expiredSpin = new QDoubleSpinBox(this);
+    m_expiredSpin->setRange(0.0, 100.0);
+    m_expiredSpin->setSuffix(" %");
+    m_expiredSpin->setValue(5.0);
+
+    m_mixEdit = new QLineEdit(this);
+    m_mixEdit->setPlaceholderText("Поровну, например: 5,3,1,1,0");
+    m_mixEdit->setToolTip("Веса типов по порядку: " + FleetDataGenerator::catalogueNames().join(", "));
+
+    formLayout->addRow("Зерно генератора:", m_seedSpin);
+    formLayout->addRow("Самолетов:", m_aircraftSpin);
+    formLayout->addRow("Пилотов:", m_pilotsSpin);
+    formLayout->addRow("Дефектов на борт:", m_defectRateSpin);
+    formLayout->addRow("Критических дефектов:", m_criticalSpin);
+    formLayout->addRow("Допусков на пилота:", m_ratingsSpin);
+    formLayout->addRow("Просроченных документов:", m_expiredSpin);
+    formLayout->addRow("Доли типов ВС:", m_mixEdit);
+
+    mainLayout->addWidget(sizeGroup);
+
+    QLabel *warningLabel = new QLabel("Все текущие самолеты, пилоты, полеты и дефекты будут удалены.", this);
+    warningLabel->setWordWrap(true);
+    warningLabel->setStyleSheet("color: #c62828;");
+    mainLayout->addWidget(warningLabel);
+
+    // Ход генерации (виден только во время записи)
+    m_progressBar = new QProgressBar(this);
+    m_progressBar->setRange(0, 1000);
+    m_progressBar->setTextVisible(false);
+    m_progressLabel = new QLabel(this);
+    m_progressBar->hide();
+    m_progressLabel->hide();
+    mainLayout->addWidget(m_progressBar);
+    mainLayout->addWidget(m_progressLabel);
+
+    // Кнопки
+    QHBoxLayout *btnLayout = new QHBoxLayout();
+    m_btnGenerate = new QPushButton("Сгенерировать", this);
+    m_btnGenerate->setStyleSheet("background-color: #4CAF50; color: white; font-weight: bold;");
+    m_btnCancel = new QPushButton("Отмена", this);
+
+    btnLayout->addStretch();
+    btnLayout->addWidget(m_btnCancel);
+    btnLayout->addWidget(m_btnGenerate);
+    mainLayout->addLayout(btnLayout);
+
+    connect(m_btnGenerate, &QPushButton::clicked, this, &GenerateFleetDialog::onGenerateClicked);
+    connect(m_btnCancel, &QPushButton::clicked, this, &QDialog::reject);
+    connect(&m_watcher, &QFutureWatcher<FleetDataGenerator::Result>::finished,
+            this, &GenerateFleetDialog::onGenerationFinished);
+}
+
+void GenerateFleetDialog::setRunning(bool running) {
+    m_btnGenerate->setEnabled(!running);
+    m_btnCancel->setEnabled(!running);
+    for (QWidget *input : std::initializer_list<QWidget*>{ m_seedSpin, m_aircraftSpin, m_pilotsSpin, m_defectRateSpin,
+                                                           m_criticalSpin, m_ratingsSpin, m_expiredSpin, m_mixEdit }) {
+        input->setEnabled(!running);
+    }
+    m_progressBar->setVisible(running);
+    m_progressLabel->setVisible(running);
+    if (running) {
+        m_progressBar->setValue(0);
+        m_progressLabel->setText("Очистка базы...");
+    }
+}
+
+void GenerateFleetDialog::reject() {
+    if (m_watcher.isRunning()) return;
+    QDialog::reject();
+}
+
+void GenerateFleetDialog::onGenerateClicked() {
+    TRACE_FUNCTION("ui");
+    QMessageBox::StandardButton reply = QMessageBox::question(
+        this, "Перезапись данных", "Вы уверены? Это сотрет ВСЕ текущие данные.",
+        QMessageBox::Yes | QMessageBox::No);
+    if (reply == QMessageBox::No) return;
+
+    FleetDataGenerator::Options options;
+    options.seed = (quint32)m_seedSpin->value();
+    options.aircraft = m_aircraftSpin->value();
+    options.pilots = m_pilotsSpin->value();
+    options.defectRate = m_defectRateSpin->value();
+    options.criticalShare = m_criticalSpin->value() / 100.0;
+    options.ratingsPerPilot = m_ratingsSpin->value();
+    options.expiredShare = m_expiredSpin->value() / 100.0;
+    options.modelMix = FleetDataGenerator::parseMix(m_mixEdit->text());
+
+    // Большой флот пишется десятки секунд - в потоке пула, окно остается отзывчивым.
+    // Ход передается в поток окна; диалог живет до конца генерации (reject заблокирован)
+    setRunning(true);
+    m_watcher.setFuture(QtConcurrent::run([this, options]() {
+        FleetDataGenerator generator(options);
+        generator.setProgressCallback([this](qint64 written, qint64 expected) {
+            QMetaObject::invokeMethod(this, [this, written, expected]() {
+                m_progressBar->setValue(expected > 0 ? (int)qMin<qint64>(1000, written * 1000 / expected) : 0);
+                m_progressLabel->setText(QString("Записано строк: %1 из ~%2").arg(written).arg(expected));
+            }, Qt::QueuedConnection);
+        });
+        return generator.generate();
+    }));
+}
+
+void GenerateFleetDialog::onGenerationFinished() {
+    TRACE_FUNCTION("ui");
+    FleetDataGenerator::Result result = m_watcher.result();
+    setRunning(false);
+
+    if (!result.ok) {
+        QMessageBox::critical(this, "Ошибка", "Не удалось сгенерировать данные. Изменения отменены.");
+        return;
+    }
+
+    QMessageBox::information(this, "Успех",
+                             QString("Создано: %1 самолетов, %2 пилотов, %3 дефектов за %4 мс.")
+                                 .arg(result.aircraft).arg(result.pilots).arg(result.defects).arg(result.elapsedMs));
+    accept();
+}
@@ -0,0 +1,52 @@
+#ifndef GENERATEFLEETDIALOG_H
+#define GENERATEFLEETDIALOG_H
+
+#include <QDialog>
+#include <QSpinBox>
+#include <QDoubleSpinBox>
+#include <QLineEdit>
+#include <QPushButton>
+#include <QProgressBar>
+#include <QLabel>
+#include <QFutureWatcher>
+#include "src/services/FleetDataGenerator.h"
+
+// Параметры синтетического флота для нагрузочных тестов (см. FleetDataGenerator).
+// Генерация заменяет все данные в базе
+class GenerateFleetDialog : public QDialog {
+    Q_OBJECT
+
+public:
+    explicit GenerateFleetDialog(QWidget *parent = nullptr);
+
+public slots:
+    // Закрытие на время генерации запрещено: запись идет в транзакции
+    void reject() override;
+
+private slots:
+    void onGenerateClicked();
+    void onGenerationFinished();
+
+private:
+    QSpinBox *m_seedSpin;
+    QSpinBox *m_aircraftSpin;
+    QSpinBox *m_pilotsSpin;
+    QDoubleSpinBox *m_defectRateSpin;
+    QDoubleSpinBox *m_criticalSpin;    // Доля критических, %
+    QDoubleSpinBox *m_ratingsSpin;
+    QDoubleSpinBox *m_expiredSpin;     // Просроченные документы, %
+    QLineEdit *m_mixEdit;              // Веса типов каталога через запятую
+    QPushButton *m_btnGenerate;
+    QPushButton *m_btnCancel;
+    QProgressBar *m_progressBar;
+    QLabel *m_progressLabel;
+
+    // Генерация в потоке пула (у него свое соединение с БД)
+    QFutureWatcher<FleetDataGenerator::Result> m_watcher;
+
+    void setRunning(bool running);
+
+    void setupUi();
+};
+
+#endif // GENERATEFLEETDIALOG_H
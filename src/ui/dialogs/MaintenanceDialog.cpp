@@ -1,5 +1,7 @@
 #include "src/ui/dialogs/MaintenanceDialog.h"
+#include "src/services/Trace.h"
 #include "src/ui/dialogs/AddDefectDialog.h"
+#include "src/services/AircraftContextCache.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QMessageBox>
@@ -10,13 +12,16 @@ MaintenanceDialog::MaintenanceDialog(QUuid aircraftId, const QString& regNumber,
     : QDialog(parent), m_aircraftId(aircraftId), m_regNumber(regNumber)
 {
     setupUi();
-    loadDefects();
+
+    // Дефекты обычно уже загружены в фоне при выборе строки в главном окне
+    showDefects(AircraftContextCache::instance().get(m_aircraftId).defects);
 }
 
 MaintenanceDialog::~MaintenanceDialog() {
 }
 
 void MaintenanceDialog::setupUi() {
+    TRACE_FUNCTION("ui");
     setWindowTitle("Техническое обслуживание: " + m_regNumber);
     resize(500, 450);
 
@@ -70,8 +75,15 @@ void MaintenanceDialog::setupUi() {
 }
 
 void MaintenanceDialog::loadDefects() {
+    TRACE_FUNCTION("ui");
+    // Борт изменился - кэшированный контекст больше не актуален
+    AircraftContextCache::instance().invalidate(m_aircraftId);
+    showDefects(m_defectRepo.getByAircraftId(m_aircraftId));
+}
+
+void MaintenanceDialog::showDefects(const std::vector<ActiveDefect>& defects) {
+    TRACE_FUNCTION("ui");
     m_defectsList->clear();
-    std::vector<ActiveDefect> defects = m_defectRepo.getByAircraftId(m_aircraftId);
 
     if (defects.empty()) {
         m_defectsList->addItem("Неисправностей не обнаружено.");
@@ -91,6 +103,7 @@ void MaintenanceDialog::loadDefects() {
 }
 
 void MaintenanceDialog::onAddDefectClicked() {
+    TRACE_FUNCTION("ui");
     // Открываем диалог добавления с пре-выбранным самолетом
     AddDefectDialog dialog(this, m_aircraftId);
     if (dialog.exec() == QDialog::Accepted) {
@@ -99,6 +112,7 @@ void MaintenanceDialog::onAddDefectClicked() {
 }
 
 void MaintenanceDialog::onResolveDefectClicked() {
+    TRACE_FUNCTION("ui");
     QListWidgetItem *item = m_defectsList->currentItem();
     if (!item) return;
     QString idStr = item->data(Qt::UserRole).toString();
@@ -113,6 +127,7 @@ void MaintenanceDialog::onResolveDefectClicked() {
 }
 
 void MaintenanceDialog::onEngineServiceClicked() {
+    TRACE_FUNCTION("ui");
     QMessageBox::StandardButton reply;
     reply = QMessageBox::question(this, "Подтверждение ТО",
         "Вы подтверждаете проведение регламентного обслуживания?\n"
@@ -122,6 +137,7 @@ void MaintenanceDialog::onEngineServiceClicked() {
     if (reply == QMessageBox::No) return;
 
     if (m_fleetService.performEngineMaintenance(m_aircraftId)) {
+        AircraftContextCache::instance().invalidate(m_aircraftId);
         QMessageBox::information(this, "Успех", "ТО проведено успешно. Ресурс продлен.");
         // Диалог можно не закрывать, чтобы пользователь мог сделать что-то еще
     } else {
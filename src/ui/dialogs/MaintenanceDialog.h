@@ -35,7 +35,8 @@ private:
     FleetService m_fleetService;
 
     void setupUi();
-    void loadDefects();
+    void loadDefects();  // Перечитать из БД (после изменений в диалоге)
+    void showDefects(const std::vector<ActiveDefect>& defects);
 };
 
 #endif // MAINTENANCEDIALOG_H
@@ -0,0 +1,489 @@
+#include "src/ui/models/FleetTableModel.h"
+#include "src/services/Trace.h"
+#include "src/services/ReadinessRuleEngine.h"
+#include <QColor>
+#include <algorithm>
+
+FleetTableModel::FleetTableModel(QObject *parent)
+    : QAbstractTableModel(parent), m_today(QDate::currentDate()), m_statusFont("Arial", 9, QFont::Bold)
+{
+}
+
+int FleetTableModel::rowCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : (int)m_visible.size();
+}
+
+int FleetTableModel::columnCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant FleetTableModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return QAbstractTableModel::headerData(section, orientation, role);
+    }
+
+    switch (section) {
+    case ColRegNumber: return "Бортовой номер";
+    case ColModel:     return "Тип ВС";
+    case ColHours:     return "Налет (ч)";
+    case ColRemaining: return "Ресурс (ч)";
+    case ColForecast:  return "Прогноз ТО";
+    case ColStatus:    return "Статус";
+    }
+    return QVariant();
+}
+
+QVariant FleetTableModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid() || index.row() >= (int)m_visible.size()) return QVariant();
+
+    const size_t i = (size_t)m_visible[index.row()];
+    const quint16 status = m_store.status(i);
+
+    switch (role) {
+    case Qt::DisplayRole:
+        switch (index.column()) {
+        case ColRegNumber: return m_store.regNumber(i);
+        case ColModel:     return m_store.modelName(i);
+        case ColHours:     return QString::number(m_store.hoursTotal(i), 'f', 1);
+        case ColRemaining: return QString::number(m_store.hoursRemaining(i), 'f', 1);
+        case ColForecast: {
+            int days = m_store.daysToService(i);
+            if (days == 0) return "Сейчас";
+            if (days < 0) return "—";
+            return QString("%1 (%2 дн.)").arg(m_today.addDays(days).toString("dd.MM.yyyy")).arg(days);
+        }
+        case ColStatus:    return statusText(status, m_store.minorDefects(i));
+        }
+        break;
+
+    case Qt::TextAlignmentRole:
+        return int(Qt::AlignCenter);
+
+    case Qt::ForegroundRole:
+        if (index.column() == ColRemaining && (status & (AircraftEngineExhausted | AircraftServiceSoon))) {
+            return QColor(Qt::red);
+        }
+        if (index.column() == ColStatus) {
+            QColor bg = statusColor(status);
+            return (bg == Qt::yellow) ? QColor(Qt::black) : QColor(Qt::white);
+        }
+        break;
+
+    case Qt::BackgroundRole:
+        if (index.column() == ColStatus) return statusColor(status);
+        break;
+
+    case Qt::FontRole:
+        if (index.column() == ColStatus) return m_statusFont;
+        break;
+
+    case Qt::ToolTipRole:
+        if (index.column() == ColForecast) {
+            if (m_store.daysToService(i) < 0) return "Нет полетов в журнале";
+            return QString("Средний налет: %1 ч/день").arg(m_store.dailyHours(i), 0, 'f', 2);
+        }
+        break;
+
+    case Qt::UserRole:
+        return m_store.id(i).toString();
+    }
+
+    return QVariant();
+}
+
+void FleetTableModel::resetStore(FleetStore&& store) {
+    beginResetModel();
+    m_store = std::move(store);
+    m_today = QDate::currentDate();
+
+    m_regKeys.clear();
+    m_regKeys.reserve(m_store.size());
+    for (size_t i = 0; i < m_store.size(); ++i) {
+        m_regKeys.push_back(m_store.regNumber(i).toUpper());
+    }
+    m_regIndexValid = false;
+    m_sortValid = false;
+    m_visible = computeVisible(false);
+    endResetModel();
+}
+
+void FleetTableModel::emitRowChanged(int row, quint32 changedFields) {
+    if (changedFields == 0 || row < 0) return;
+
+    // Поля строки -> колонки таблицы, которые нужно перерисовать
+    int first = ColumnCount, last = -1;
+    auto touch = [&](int column) {
+        first = qMin(first, column);
+        last = qMax(last, column);
+    };
+    if (changedFields & FieldRegNumber) touch(ColRegNumber);
+    if (changedFields & FieldModel) touch(ColModel);
+    if (changedFields & FieldHours) { touch(ColHours); touch(ColRemaining); }
+    if (changedFields & FieldDefects) touch(ColStatus);
+    if (changedFields & FieldStatus) { touch(ColRemaining); touch(ColStatus); }
+    if (changedFields & FieldForecast) touch(ColForecast);
+
+    emit dataChanged(index(row, first), index(row, last));
+}
+
+int FleetTableModel::visibleRowOf(int storeIndex) const {
+    auto it = std::find(m_visible.begin(), m_visible.end(), storeIndex);
+    return (it == m_visible.end()) ? -1 : (int)(it - m_visible.begin());
+}
+
+quint32 FleetTableModel::layoutFields() const {
+    quint32 fields = 0;
+    if (m_filter.statuses != FleetFilter::AllStatuses) fields |= FieldStatus;
+    if (m_filter.modelIndex >= 0) fields |= FieldModel;
+    if (!m_filter.regPrefix.isEmpty()) fields |= FieldRegNumber;
+
+    switch (m_sortColumn) {
+    case ColRegNumber: fields |= FieldRegNumber; break;
+    case ColModel:     fields |= FieldModel; break;
+    case ColHours:
+    case ColRemaining: fields |= FieldHours; break;
+    case ColForecast:  fields |= FieldForecast; break;
+    case ColStatus:    fields |= FieldStatus; break;
+    }
+    return fields;
+}
+
+void FleetTableModel::applyRow(const FleetRow& row) {
+    int existing = m_store.indexOf(row.id);
+    if (existing < 0) {
+        appendStoreRow(row);
+        syncVisible(computeVisible(false));
+        return;
+    }
+
+    quint32 changed = m_store.update((size_t)existing, row);
+    if (changed & FieldRegNumber) {
+        m_regKeys[existing] = row.regNumber.toUpper();
+        m_regIndexValid = false;
+    }
+    emitRowChanged(visibleRowOf(existing), changed);
+
+    // Строка могла сменить место в сортировке или выпасть из фильтра
+    if (changed & layoutFields()) {
+        m_sortValid = false;
+        syncVisible(computeVisible(false));
+    }
+}
+
+void FleetTableModel::removeAircraft(const QUuid& aircraftId) {
+    int existing = m_store.indexOf(aircraftId);
+    if (existing >= 0) removeStoreRows({ existing });
+}
+
+void FleetTableModel::applyStore(const FleetStore& fresh) {
+    TRACE_FUNCTION("ui");
+    m_today = QDate::currentDate();
+
+    // 1. Удаленные борта. Если ушла большая часть флота (очистка БД), дешевле сбросить модель
+    std::vector<int> removed;
+    for (size_t i = 0; i < m_store.size(); ++i) {
+        if (fresh.indexOf(m_store.id(i)) < 0) removed.push_back((int)i);
+    }
+    if (removed.size() * 2 > m_store.size() && removed.size() > 16) {
+        FleetStore copy = fresh;
+        resetStore(std::move(copy));
+        return;
+    }
+    removeStoreRows(removed);
+
+    // 2. Изменения существующих строк, новые борта - в хранилище
+    quint32 relayout = 0;
+    const quint32 affects = layoutFields();
+    std::vector<int> rowOf(m_store.size(), -1);
+    for (size_t r = 0; r < m_visible.size(); ++r) rowOf[m_visible[r]] = (int)r;
+    for (size_t i = 0; i < fresh.size(); ++i) {
+        int existing = m_store.indexOf(fresh.id(i));
+        if (existing < 0) {
+            appendStoreRow(fresh.row(i));
+            relayout = 1;
+            continue;
+        }
+
+        quint32 changed = m_store.update((size_t)existing, fresh.row(i));
+        if (changed & FieldRegNumber) {
+            m_regKeys[existing] = fresh.regNumber(i).toUpper();
+            m_regIndexValid = false;
+        }
+        if (changed & affects) relayout = 1;
+        if (changed) emitRowChanged(rowOf[existing], changed);
+    }
+
+    // 3. Новые строки и сменившие место - одной синхронизацией видимого списка
+    if (relayout) {
+        m_sortValid = false;
+        syncVisible(computeVisible(false));
+    }
+}
+
+void FleetTableModel::appendStoreRow(const FleetRow& row) {
+    m_store.append(row);
+    m_regKeys.push_back(row.regNumber.toUpper());
+    m_regIndexValid = false;
+    m_sortValid = false;
+}
+
+void FleetTableModel::removeStoreRows(const std::vector<int>& storeIndices) {
+    if (storeIndices.empty()) return;
+
+    // Новый индекс хранилища для каждой строки (-1 - удалена)
+    std::vector<int> newIndex(m_store.size());
+    size_t next = 0;
+    int kept = 0;
+    for (size_t i = 0; i < newIndex.size(); ++i) {
+        if (next < storeIndices.size() && (size_t)storeIndices[next] == i) {
+            newIndex[i] = -1;
+            ++next;
+        } else {
+            newIndex[i] = kept++;
+        }
+    }
+
+    // Видимые строки убираем с конца соседними диапазонами, как в syncVisible
+    for (int row = (int)m_visible.size() - 1; row >= 0; --row) {
+        if (newIndex[m_visible[row]] >= 0) continue;
+        int last = row;
+        while (row > 0 && newIndex[m_visible[row - 1]] < 0) --row;
+
+        beginRemoveRows(QModelIndex(), row, last);
+        m_visible.erase(m_visible.begin() + row, m_visible.begin() + last + 1);
+        endRemoveRows();
+    }
+
+    m_store.removeRows(storeIndices);
+
+    // Перестановки сохраняют порядок: удаленные выбрасываются, остальные
+    // получают новые индексы хранилища - один проход по каждой
+    auto remap = [&newIndex](std::vector<int>& order) {
+        size_t out = 0;
+        for (int v : order) {
+            if (newIndex[v] >= 0) order[out++] = newIndex[v];
+        }
+        order.resize(out);
+    };
+    remap(m_visible);
+    if (m_sortValid) remap(m_sorted);
+    if (m_regIndexValid) remap(m_regOrder);
+
+    size_t out = 0;
+    for (size_t i = 0; i < m_regKeys.size(); ++i) {
+        if (newIndex[i] >= 0) m_regKeys[out++] = std::move(m_regKeys[i]);
+    }
+    m_regKeys.resize(out);
+}
+
+void FleetTableModel::ensureRegIndex() {
+    if (m_regIndexValid) return;
+
+    m_regOrder.resize(m_store.size());
+    for (size_t i = 0; i < m_regOrder.size(); ++i) m_regOrder[i] = (int)i;
+    std::sort(m_regOrder.begin(), m_regOrder.end(), [this](int a, int b) {
+        int c = QString::compare(m_regKeys[a], m_regKeys[b], Qt::CaseSensitive);
+        return c != 0 ? c < 0 : a < b;
+    });
+    m_regIndexValid = true;
+}
+
+void FleetTableModel::ensureSorted() {
+    if (m_sortValid) return;
+
+    const size_t n = m_store.size();
+    m_sorted.resize(n);
+    for (size_t i = 0; i < n; ++i) m_sorted[i] = (int)i;
+
+    if (m_sortColumn < 0) {
+        m_sortValid = true;
+        return;
+    }
+
+    // Числовой ключ для каждой строки: сравнение сортировки - только double
+    std::vector<double> key(n);
+    switch (m_sortColumn) {
+    case ColRegNumber: {
+        // Ранг в индексе номеров; одинаковые номера получают один ранг
+        ensureRegIndex();
+        double rank = 0;
+        for (size_t k = 0; k < n; ++k) {
+            if (k > 0 && m_regKeys[m_regOrder[k]] != m_regKeys[m_regOrder[k - 1]]) rank = (double)k;
+            key[m_regOrder[k]] = rank;
+        }
+        break;
+    }
+    case ColModel: {
+        // Ранг названия модели (моделей единицы - сортируем их, а не строки)
+        std::vector<int> models(m_store.modelCount());
+        for (size_t m = 0; m < models.size(); ++m) models[m] = (int)m;
+        std::sort(models.begin(), models.end(), [this](int a, int b) {
+            return QString::localeAwareCompare(m_store.modelNameAt(a), m_store.modelNameAt(b)) < 0;
+        });
+        std::vector<double> rank(models.size());
+        for (size_t r = 0; r < models.size(); ++r) rank[models[r]] = (double)r;
+        for (size_t i = 0; i < n; ++i) key[i] = rank[m_store.modelIndex(i)];
+        break;
+    }
+    case ColHours:
+        for (size_t i = 0; i < n; ++i) key[i] = m_store.hoursTotal(i);
+        break;
+    case ColRemaining:
+        for (size_t i = 0; i < n; ++i) key[i] = m_store.hoursRemaining(i);
+        break;
+    case ColForecast:
+        for (size_t i = 0; i < n; ++i) {
+            int days = m_store.daysToService(i);
+            key[i] = (days < 0) ? 1e9 : (double)days;  // Без прогноза - в конец
+        }
+        break;
+    case ColStatus:
+        for (size_t i = 0; i < n; ++i) key[i] = (double)statusCategory(m_store.status(i));
+        break;
+    }
+
+    // При равных ключах - исходный порядок (результат не зависит от алгоритма сортировки)
+    const bool descending = (m_sortOrder == Qt::DescendingOrder);
+    std::sort(m_sorted.begin(), m_sorted.end(), [&](int a, int b) {
+        if (key[a] != key[b]) return descending ? key[a] > key[b] : key[a] < key[b];
+        return a < b;
+    });
+    m_sortValid = true;
+}
+
+void FleetTableModel::markPrefix(std::vector<char>& match) {
+    match.assign(m_store.size(), 0);
+    ensureRegIndex();
+
+    // Номера с общим началом идут в индексе подряд: бинарный поиск начала диапазона
+    const QString prefix = m_filter.regPrefix.toUpper();
+    auto it = std::lower_bound(m_regOrder.begin(), m_regOrder.end(), prefix, [this](int i, const QString& p) {
+        return QString::compare(m_regKeys[i], p, Qt::CaseSensitive) < 0;
+    });
+    for (; it != m_regOrder.end() && m_regKeys[*it].startsWith(prefix); ++it) {
+        match[*it] = 1;
+    }
+}
+
+std::vector<int> FleetTableModel::computeVisible(bool narrowing) {
+    std::vector<char> prefixMatch;
+    const bool usePrefix = !m_filter.regPrefix.isEmpty();
+    if (usePrefix) markPrefix(prefixMatch);
+
+    if (!narrowing) ensureSorted();
+    const std::vector<int>& candidates = narrowing ? m_visible : m_sorted;
+
+    std::vector<int> next;
+    next.reserve(candidates.size());
+    for (int i : candidates) {
+        if (!(statusCategory(m_store.status(i)) & m_filter.statuses)) continue;
+        if (m_filter.modelIndex >= 0 && m_store.modelIndex(i) != m_filter.modelIndex) continue;
+        if (usePrefix && !prefixMatch[i]) continue;
+        next.push_back(i);
+    }
+    return next;
+}
+
+void FleetTableModel::syncVisible(std::vector<int> next) {
+    const size_t n = m_store.size();
+
+    // 1. Строки, которых нет в новом списке, убираем с конца соседними диапазонами
+    std::vector<char> inNext(n, 0);
+    for (int i : next) inNext[i] = 1;
+
+    for (int row = (int)m_visible.size() - 1; row >= 0; --row) {
+        if (inNext[m_visible[row]]) continue;
+        int last = row;
+        while (row > 0 && !inNext[m_visible[row - 1]]) --row;
+
+        beginRemoveRows(QModelIndex(), row, last);
+        m_visible.erase(m_visible.begin() + row, m_visible.begin() + last + 1);
+        endRemoveRows();
+    }
+
+    // 2. Появившиеся строки - одной вставкой в конец
+    std::vector<char> inCurrent(n, 0);
+    for (int i : m_visible) inCurrent[i] = 1;
+
+    std::vector<int> added;
+    for (int i : next) {
+        if (!inCurrent[i]) added.push_back(i);
+    }
+    if (!added.empty()) {
+        int first = (int)m_visible.size();
+        beginInsertRows(QModelIndex(), first, first + (int)added.size() - 1);
+        m_visible.insert(m_visible.end(), added.begin(), added.end());
+        endInsertRows();
+    }
+
+    // 3. Порядок: постоянные индексы (выделение, текущая строка) переезжают вслед за строками
+    if (m_visible != next) {
+        emit layoutAboutToBeChanged();
+
+        std::vector<int> rowOf(n, -1);
+        for (size_t r = 0; r < next.size(); ++r) rowOf[next[r]] = (int)r;
+
+        QModelIndexList from = persistentIndexList();
+        QModelIndexList to;
+        to.reserve(from.size());
+        for (const QModelIndex& idx : from) {
+            to.append(index(rowOf[m_visible[idx.row()]], idx.column()));
+        }
+        changePersistentIndexList(from, to);
+
+        m_visible.swap(next);
+        emit layoutChanged();
+    }
+}
+
+void FleetTableModel::sort(int column, Qt::SortOrder order) {
+    TRACE_FUNCTION("ui");
+    if (column == m_sortColumn && order == m_sortOrder && m_sortValid) return;
+
+    m_sortColumn = column;
+    m_sortOrder = order;
+    m_sortValid = false;
+    syncVisible(computeVisible(false));
+}
+
+void FleetTableModel::setFilter(const FleetFilter& filter) {
+    TRACE_FUNCTION("ui");
+    // Новый фильтр строже старого по всем условиям - достаточно проредить видимые строки
+    bool narrowing = ((filter.statuses & ~m_filter.statuses) == 0)
+                  && (m_filter.modelIndex < 0 || filter.modelIndex == m_filter.modelIndex)
+                  && filter.regPrefix.startsWith(m_filter.regPrefix, Qt::CaseInsensitive);
+
+    m_filter = filter;
+    syncVisible(computeVisible(narrowing));
+}
+
+QUuid FleetTableModel::aircraftIdAt(int row) const {
+    if (row < 0 || row >= (int)m_visible.size()) return QUuid();
+    return m_store.id((size_t)m_visible[row]);
+}
+
+QString FleetTableModel::regNumberAt(int row) const {
+    if (row < 0 || row >= (int)m_visible.size()) return QString();
+    return m_store.regNumber((size_t)m_visible[row]);
+}
+
+quint8 FleetTableModel::statusCategory(quint16 status) {
+    if (status & AircraftGroundedMask) return FleetFilter::Grounded;
+    if (status & AircraftWarningMask) return FleetFilter::Warning;
+    return FleetFilter::Ready;
+}
+
+QString FleetTableModel::statusText(quint16 status, int minorCount) {
+    if (status & AircraftCriticalDefect) return "CRITICAL DEFECT";
+    if (status & AircraftEngineExhausted) return "SERVICE REQ";
+    if (status & AircraftMinorLimit) return "TOO MANY DEFECTS";
+    if (status & AircraftServiceSoon) return "SERVICE SOON";
+    if (status & AircraftMinorDefects) return QString("WARNINGS (%1)").arg(minorCount);
+    return "READY";
+}
+
+QColor FleetTableModel::statusColor(quint16 status) {
+    if (status & AircraftGroundedMask) return Qt::red;
+    if (status & AircraftWarningMask) return Qt::yellow;
+    return Qt::green;
+}
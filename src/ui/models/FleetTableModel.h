@@ -0,0 +1,124 @@
+#ifndef FLEETTABLEMODEL_H
+#define FLEETTABLEMODEL_H
+
+#include <QAbstractTableModel>
+#include <QDate>
+#include <QFont>
+#include <QColor>
+#include <vector>
+#include "src/models/FleetStore.h"
+
+// Фильтр таблицы флота
+struct FleetFilter {
+    enum StatusBits : quint8 {
+        Ready = 1,
+        Warning = 2,
+        Grounded = 4,
+        AllStatuses = Ready | Warning | Grounded
+    };
+
+    quint8 statuses = AllStatuses;  // Какие категории статуса показывать
+    int modelIndex = -1;            // Индекс модели в FleetStore (-1 - все типы)
+    QString regPrefix;              // Начало бортового номера (без учета регистра)
+};
+
+// Модель главной таблицы флота поверх колоночного хранилища.
+// Текст, цвета и подсказки вычисляются в data() только для видимых ячеек,
+// поэтому память и отрисовка не зависят от размера флота.
+// Фильтр и сортировка не трогают хранилище: модель держит перестановку видимых
+// строк (индексы хранилища), построенную по числовым ключам сортировки,
+// категориям статуса и индексу префиксов бортовых номеров
+class FleetTableModel : public QAbstractTableModel {
+    Q_OBJECT
+
+public:
+    enum Column {
+        ColRegNumber,
+        ColModel,
+        ColHours,
+        ColRemaining,
+        ColForecast,
+        ColStatus,
+        ColumnCount
+    };
+
+    explicit FleetTableModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+
+    // Новый фильтр. Если он только сужает текущий (допечатали символ в номер,
+    // сняли категорию), отбираются строки из уже видимых без пересортировки
+    void setFilter(const FleetFilter& filter);
+    const FleetFilter& filter() const { return m_filter; }
+
+    // Полная замена данных (хранилище забирается целиком)
+    void resetStore(FleetStore&& store);
+
+    // Обновление по ключу (ID борта) без сброса модели: удаленные строки убираются,
+    // новые встают на место по сортировке, у остальных dataChanged только по
+    // измененным ячейкам. Выделение и прокрутка представления сохраняются
+    void applyStore(const FleetStore& fresh);
+
+    // Точечные изменения одного борта
+    void applyRow(const FleetRow& row);
+    void removeAircraft(const QUuid& aircraftId);
+
+    const FleetStore& store() const { return m_store; }
+    int totalCount() const { return (int)m_store.size(); }
+
+    // Борт в строке таблицы (пустой UUID - строки нет)
+    QUuid aircraftIdAt(int row) const;
+    QString regNumberAt(int row) const;
+
+    // Текст и цвет статуса по флагам AircraftStatusFlag
+    static QString statusText(quint16 status, int minorCount);
+    static QColor statusColor(quint16 status);
+
+    // Категория статуса для фильтра (FleetFilter::StatusBits)
+    static quint8 statusCategory(quint16 status);
+
+private:
+    void emitRowChanged(int row, quint32 changedFields);
+
+    // Строка таблицы для индекса хранилища (-1 - скрыта фильтром)
+    int visibleRowOf(int storeIndex) const;
+
+    // Поля, от которых зависят текущие сортировка и фильтр
+    quint32 layoutFields() const;
+
+    void ensureRegIndex();
+    void ensureSorted();
+    void markPrefix(std::vector<char>& match);
+    std::vector<int> computeVisible(bool narrowing);
+
+    // Приводит видимые строки к next: удаления и вставки - сигналами строк,
+    // смена порядка - layoutChanged с переносом постоянных индексов
+    void syncVisible(std::vector<int> next);
+
+    // Удаление строк хранилища (индексы по возрастанию): сигналы - по соседним
+    // диапазонам видимых строк, перестановки сжимаются за один проход
+    void removeStoreRows(const std::vector<int>& storeIndices);
+    void appendStoreRow(const FleetRow& row);
+
+    FleetStore m_store;
+
+    std::vector<int> m_visible;   // Строка таблицы -> индекс хранилища
+    std::vector<int> m_sorted;    // Все строки хранилища в порядке сортировки
+    bool m_sortValid = false;
+    int m_sortColumn = -1;
+    Qt::SortOrder m_sortOrder = Qt::AscendingOrder;
+
+    std::vector<QString> m_regKeys;  // Номера в верхнем регистре (по индексу хранилища)
+    std::vector<int> m_regOrder;     // Индексы хранилища, отсортированные по номеру
+    bool m_regIndexValid = false;
+
+    FleetFilter m_filter;
+    QDate m_today;      // Дата, от которой считается прогноз ТО
+    QFont m_statusFont;
+};
+
+#endif // FLEETTABLEMODEL_H
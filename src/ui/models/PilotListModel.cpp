@@ -0,0 +1,94 @@
+#include "src/ui/models/PilotListModel.h"
+#include "src/services/Trace.h"
+#include <QColor>
+
+PilotListModel::PilotListModel(QObject *parent)
+    : QAbstractListModel(parent), m_today(QDate::currentDate())
+{
+}
+
+int PilotListModel::rowCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : (int)m_rows.size();
+}
+
+QVariant PilotListModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid() || index.row() >= (int)m_rows.size()) return QVariant();
+
+    const PilotListEntry& entry = m_rows[index.row()];
+
+    switch (role) {
+    case Qt::DisplayRole:
+        return entry.fullName;
+
+    case Qt::ForegroundRole:
+        // Непригодные к рейсу на этом типе - серым, но выбрать их можно (проверка покажет причину)
+        if (entry.fitness != PilotFitness::Eligible) return QColor(Qt::gray);
+        break;
+
+    case Qt::ToolTipRole:
+        if (entry.fitness == PilotFitness::Expired) return "Лицензия или медкомиссия просрочены";
+        if (entry.fitness == PilotFitness::NotRated) return "Нет допуска к типу";
+        break;
+
+    case Qt::UserRole:
+        return entry.id.toString();
+    }
+
+    return QVariant();
+}
+
+bool PilotListModel::canFetchMore(const QModelIndex &parent) const {
+    return !parent.isValid() && m_hasMore;
+}
+
+void PilotListModel::fetchMore(const QModelIndex &parent) {
+    TRACE_FUNCTION("ui");
+    if (parent.isValid() || !m_hasMore) return;
+
+    // Следующая страница начинается после последней загруженной строки
+    PilotListEntry after = m_rows.empty() ? PilotListEntry() : m_rows.back();
+    std::vector<PilotListEntry> page = m_repo.getPickerPage(m_modelId, m_nameFilter, m_today, after, PageSize);
+
+    m_hasMore = (int)page.size() == PageSize;
+    if (page.empty()) return;
+
+    int first = (int)m_rows.size();
+    beginInsertRows(QModelIndex(), first, first + (int)page.size() - 1);
+    m_rows.insert(m_rows.end(), page.begin(), page.end());
+    endInsertRows();
+}
+
+void PilotListModel::setAircraftModel(const QUuid& modelId) {
+    m_modelId = modelId;
+    reload();
+}
+
+void PilotListModel::setNameFilter(const QString& text) {
+    QString filter = text.trimmed();
+    if (filter == m_nameFilter && !m_rows.empty()) return;
+
+    m_nameFilter = filter;
+    reload();
+}
+
+QUuid PilotListModel::pilotIdAt(int row) const {
+    if (row < 0 || row >= (int)m_rows.size()) return QUuid();
+    return m_rows[row].id;
+}
+
+PilotFitness PilotListModel::fitnessAt(int row) const {
+    if (row < 0 || row >= (int)m_rows.size()) return PilotFitness::NotRated;
+    return m_rows[row].fitness;
+}
+
+void PilotListModel::reload() {
+    TRACE_FUNCTION("ui");
+    beginResetModel();
+    m_rows.clear();
+    m_today = QDate::currentDate();
+    m_hasMore = true;
+    endResetModel();
+
+    // Первая страница сразу: комбобокс должен показать лучшего кандидата без прокрутки
+    fetchMore(QModelIndex());
+}
@@ -0,0 +1,48 @@
+#ifndef PILOTLISTMODEL_H
+#define PILOTLISTMODEL_H
+
+#include <QAbstractListModel>
+#include <QDate>
+#include <vector>
+#include "src/repositories/PilotRepository.h"
+
+// Ленивый список пилотов для выбора командира на конкретный тип.
+// Строки подгружаются страницами по мере прокрутки (canFetchMore/fetchMore),
+// поиск по имени и ранжирование (допущенные к типу - первыми) выполняет БД.
+// JSON допусков на клиенте не разбирается
+class PilotListModel : public QAbstractListModel {
+    Q_OBJECT
+
+public:
+    static const int PageSize = 200;
+
+    explicit PilotListModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+    bool canFetchMore(const QModelIndex &parent) const override;
+    void fetchMore(const QModelIndex &parent) override;
+
+    // Тип ВС, под который ранжируется список (сбрасывает модель)
+    void setAircraftModel(const QUuid& modelId);
+
+    // Подстрока имени (сбрасывает модель и загружает первую страницу)
+    void setNameFilter(const QString& text);
+    const QString& nameFilter() const { return m_nameFilter; }
+
+    QUuid pilotIdAt(int row) const;
+    PilotFitness fitnessAt(int row) const;
+
+private:
+    void reload();
+
+    PilotRepository m_repo;
+    std::vector<PilotListEntry> m_rows;
+    QUuid m_modelId;
+    QString m_nameFilter;
+    QDate m_today;
+    bool m_hasMore = false;
+};
+
+#endif // PILOTLISTMODEL_H
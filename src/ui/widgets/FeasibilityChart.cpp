@@ -0,0 +1,85 @@
+#include "src/ui/widgets/FeasibilityChart.h"
+#include <QPainter>
+#include <QPaintEvent>
+
+FeasibilityChart::FeasibilityChart(QWidget *parent)
+    : QWidget(parent)
+{
+    setMinimumHeight(160);
+}
+
+QSize FeasibilityChart::sizeHint() const {
+    return QSize(400, 200);
+}
+
+void FeasibilityChart::setGrid(const FeasibilityGrid& grid) {
+    m_grid = grid;
+
+    // Переводим маски в картинку один раз, дальше она только масштабируется
+    m_image = QImage(grid.fuelSteps, grid.cargoSteps, QImage::Format_RGB32);
+    for (int row = 0; row < grid.cargoSteps; ++row) {
+        // Ось загрузки направлена вверх
+        QRgb *line = reinterpret_cast<QRgb *>(m_image.scanLine(grid.cargoSteps - 1 - row));
+        for (int col = 0; col < grid.fuelSteps; ++col) {
+            quint8 mask = grid.at(col, row);
+            if (mask == CheckAll) {
+                line[col] = qRgb(129, 199, 132);  // Все ограничения выполнены
+            } else if ((mask & (CheckWeight | CheckCg)) != (CheckWeight | CheckCg)) {
+                line[col] = qRgb(239, 154, 154);  // Масса или центровка
+            } else {
+                line[col] = qRgb(255, 204, 128);  // Только топливо
+            }
+        }
+    }
+    update();
+}
+
+void FeasibilityChart::setCurrentPoint(double fuel, double cargo) {
+    m_fuel = fuel;
+    m_cargo = cargo;
+    update();
+}
+
+QRect FeasibilityChart::plotRect() const {
+    // Отступы под подписи осей
+    return rect().adjusted(40, 6, -6, -20);
+}
+
+void FeasibilityChart::paintEvent(QPaintEvent *) {
+    QPainter painter(this);
+    QRect plot = plotRect();
+
+    painter.fillRect(rect(), palette().window());
+    if (m_image.isNull() || plot.width() <= 0 || plot.height() <= 0) return;
+
+    painter.drawImage(plot, m_image);
+    painter.setPen(Qt::darkGray);
+    painter.drawRect(plot.adjusted(0, 0, -1, -1));
+
+    // Подписи диапазонов
+    painter.setPen(palette().windowText().color());
+    painter.drawText(QRect(plot.left(), plot.bottom() + 2, plot.width(), 16), Qt::AlignLeft,
+                     QString::number(m_grid.fuelFrom, 'f', 0));
+    painter.drawText(QRect(plot.left(), plot.bottom() + 2, plot.width(), 16), Qt::AlignCenter, "Топливо, л");
+    painter.drawText(QRect(plot.left(), plot.bottom() + 2, plot.width(), 16), Qt::AlignRight,
+                     QString::number(m_grid.fuelTo, 'f', 0));
+    painter.drawText(QRect(0, plot.top(), plot.left() - 4, 16), Qt::AlignRight,
+                     QString::number(m_grid.cargoTo, 'f', 0));
+    painter.drawText(QRect(0, plot.bottom() - 16, plot.left() - 4, 16), Qt::AlignRight,
+                     QString::number(m_grid.cargoFrom, 'f', 0));
+
+    // Маркер текущей загрузки
+    double fuelSpan = m_grid.fuelTo - m_grid.fuelFrom;
+    double cargoSpan = m_grid.cargoTo - m_grid.cargoFrom;
+    if (fuelSpan <= 0 || cargoSpan <= 0) return;
+
+    double fx = (m_fuel - m_grid.fuelFrom) / fuelSpan;
+    double cy = (m_cargo - m_grid.cargoFrom) / cargoSpan;
+    if (fx < 0 || fx > 1 || cy < 0 || cy > 1) return;
+
+    QPointF marker(plot.left() + fx * plot.width(), plot.bottom() - cy * plot.height());
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setPen(QPen(Qt::black, 2));
+    painter.setBrush(Qt::white);
+    painter.drawEllipse(marker, 5, 5);
+}
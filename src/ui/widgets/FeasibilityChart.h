@@ -0,0 +1,34 @@
+#ifndef FEASIBILITYCHART_H
+#define FEASIBILITYCHART_H
+
+#include <QWidget>
+#include <QImage>
+#include "src/services/WeightCalculator.h"
+
+// График допустимой области "топливо x загрузка".
+// Каждая ячейка сетки окрашивается по флагам LoadCheck,
+// маркером отмечаются текущие значения из формы
+class FeasibilityChart : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit FeasibilityChart(QWidget *parent = nullptr);
+
+    void setGrid(const FeasibilityGrid& grid);
+    void setCurrentPoint(double fuel, double cargo);
+
+    QSize sizeHint() const override;
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+
+private:
+    FeasibilityGrid m_grid;
+    QImage m_image;  // Сетка, уже переведенная в цвета
+    double m_fuel = 0;
+    double m_cargo = 0;
+
+    QRect plotRect() const;
+};
+
+#endif // FEASIBILITYCHART_H